@@ -1,12 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton parser for Yacc-like parsing with Bison,
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
+/* Bison implementation for Yacc-like parsers in C
 
-   This program is free software; you can redistribute it and/or modify
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -14,17 +16,27 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
 
-/* As a special exception, when this file is copied by Bison into a
-   Bison output file, you may use that output file without restriction.
-   This special exception was added by the Free Software Foundation
-   in version 1.24 of Bison.  */
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
 
-/* Written by Richard Stallman by simplifying the original so called
-   ``semantic'' parser.  */
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
@@ -33,118 +45,29 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
-
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     TRANSLATER = 258,
-     TRANSLATE = 259,
-     SCALE = 260,
-     TEST = 261,
-     ROUND = 262,
-     NEG = 263,
-     ASSERTION = 264,
-     FACE = 265,
-     TAPER = 266,
-     SPAWN = 267,
-     CHAMFER = 268,
-     TEXTURE = 269,
-     TEXTUREFULL = 270,
-     TEXTUREQUAD = 271,
-     TEXTURECLEAR = 272,
-     MATERIAL = 273,
-     LOADMATERIAL = 274,
-     LOADMATERIALNR = 275,
-     SPAWNNGON = 276,
-     UNCHAMFER = 277,
-     ASSIGN = 278,
-     DEFSIGN = 279,
-     EXTRUDE = 280,
-     EXTRUDET = 281,
-     EXPAND = 282,
-     RANDOM = 283,
-     REPEATH = 284,
-     REPEATV = 285,
-     SPLITV = 286,
-     SPLITH = 287,
-     MULTIFACE = 288,
-     FREE = 289,
-     NGON = 290,
-     REMOVE = 291,
-     ADDFACE = 292,
-     DETACHFACE = 293,
-     DRIVETHROUGH = 294,
-     NUMBER = 295,
-     NONTERM = 296,
-     ATTRIBUTE = 297
-   };
-#endif
-/* Tokens.  */
-#define TRANSLATER 258
-#define TRANSLATE 259
-#define SCALE 260
-#define TEST 261
-#define ROUND 262
-#define NEG 263
-#define ASSERTION 264
-#define FACE 265
-#define TAPER 266
-#define SPAWN 267
-#define CHAMFER 268
-#define TEXTURE 269
-#define TEXTUREFULL 270
-#define TEXTUREQUAD 271
-#define TEXTURECLEAR 272
-#define MATERIAL 273
-#define LOADMATERIAL 274
-#define LOADMATERIALNR 275
-#define SPAWNNGON 276
-#define UNCHAMFER 277
-#define ASSIGN 278
-#define DEFSIGN 279
-#define EXTRUDE 280
-#define EXTRUDET 281
-#define EXPAND 282
-#define RANDOM 283
-#define REPEATH 284
-#define REPEATV 285
-#define SPLITV 286
-#define SPLITH 287
-#define MULTIFACE 288
-#define FREE 289
-#define NGON 290
-#define REMOVE 291
-#define ADDFACE 292
-#define DETACHFACE 293
-#define DRIVETHROUGH 294
-#define NUMBER 295
-#define NONTERM 296
-#define ATTRIBUTE 297
-
-
-
-
-/* Copy the first part of user declarations.  */
-#line 1 "..\\..\\src\\parser.y"
+#define YYPURE 1
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "/root/repo/src/parser.y"
 
 #include <memory>
 #include <string>
@@ -154,85 +77,318 @@
 #include "Product.h"
 #include "Operation.h"
 #include "Expression.h"
+#include "RuleParser.h"
 
-void yyerror(RuleSet *ruleset, char* s);
-int yylex();
-void yyunput(int, char*);
+#line 83 "/root/repo/MSVC/parser.cxx"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
+#include "parser.hxx"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TRANSLATER = 3,                 /* TRANSLATER  */
+  YYSYMBOL_TRANSLATE = 4,                  /* TRANSLATE  */
+  YYSYMBOL_SCALE = 5,                      /* SCALE  */
+  YYSYMBOL_TEST = 6,                       /* TEST  */
+  YYSYMBOL_ROUND = 7,                      /* ROUND  */
+  YYSYMBOL_NEG = 8,                        /* NEG  */
+  YYSYMBOL_ASSERTION = 9,                  /* ASSERTION  */
+  YYSYMBOL_FACE = 10,                      /* FACE  */
+  YYSYMBOL_TAPER = 11,                     /* TAPER  */
+  YYSYMBOL_SPAWN = 12,                     /* SPAWN  */
+  YYSYMBOL_CHAMFER = 13,                   /* CHAMFER  */
+  YYSYMBOL_TEXTURE = 14,                   /* TEXTURE  */
+  YYSYMBOL_TEXTUREFULL = 15,               /* TEXTUREFULL  */
+  YYSYMBOL_TEXTUREQUAD = 16,               /* TEXTUREQUAD  */
+  YYSYMBOL_TEXTURECLEAR = 17,              /* TEXTURECLEAR  */
+  YYSYMBOL_MATERIAL = 18,                  /* MATERIAL  */
+  YYSYMBOL_LOADMATERIAL = 19,              /* LOADMATERIAL  */
+  YYSYMBOL_LOADMATERIALNR = 20,            /* LOADMATERIALNR  */
+  YYSYMBOL_SPAWNNGON = 21,                 /* SPAWNNGON  */
+  YYSYMBOL_UNCHAMFER = 22,                 /* UNCHAMFER  */
+  YYSYMBOL_ASSIGN = 23,                    /* ASSIGN  */
+  YYSYMBOL_DEFSIGN = 24,                   /* DEFSIGN  */
+  YYSYMBOL_EXTRUDE = 25,                   /* EXTRUDE  */
+  YYSYMBOL_EXTRUDET = 26,                  /* EXTRUDET  */
+  YYSYMBOL_EXPAND = 27,                    /* EXPAND  */
+  YYSYMBOL_RANDOM = 28,                    /* RANDOM  */
+  YYSYMBOL_REPEATH = 29,                   /* REPEATH  */
+  YYSYMBOL_REPEATV = 30,                   /* REPEATV  */
+  YYSYMBOL_SPLITV = 31,                    /* SPLITV  */
+  YYSYMBOL_SPLITH = 32,                    /* SPLITH  */
+  YYSYMBOL_MULTIFACE = 33,                 /* MULTIFACE  */
+  YYSYMBOL_FREE = 34,                      /* FREE  */
+  YYSYMBOL_NGON = 35,                      /* NGON  */
+  YYSYMBOL_REMOVE = 36,                    /* REMOVE  */
+  YYSYMBOL_ADDFACE = 37,                   /* ADDFACE  */
+  YYSYMBOL_DETACHFACE = 38,                /* DETACHFACE  */
+  YYSYMBOL_DRIVETHROUGH = 39,              /* DRIVETHROUGH  */
+  YYSYMBOL_NUMBER = 40,                    /* NUMBER  */
+  YYSYMBOL_NONTERM = 41,                   /* NONTERM  */
+  YYSYMBOL_ATTRIBUTE = 42,                 /* ATTRIBUTE  */
+  YYSYMBOL_43_ = 43,                       /* '&'  */
+  YYSYMBOL_44_ = 44,                       /* '|'  */
+  YYSYMBOL_45_ = 45,                       /* '<'  */
+  YYSYMBOL_46_ = 46,                       /* '>'  */
+  YYSYMBOL_47_ = 47,                       /* '='  */
+  YYSYMBOL_48_ = 48,                       /* '-'  */
+  YYSYMBOL_49_ = 49,                       /* '+'  */
+  YYSYMBOL_50_ = 50,                       /* '*'  */
+  YYSYMBOL_51_ = 51,                       /* '/'  */
+  YYSYMBOL_52_ = 52,                       /* ';'  */
+  YYSYMBOL_53_ = 53,                       /* '('  */
+  YYSYMBOL_54_ = 54,                       /* ')'  */
+  YYSYMBOL_55_ = 55,                       /* ':'  */
+  YYSYMBOL_56_ = 56,                       /* '['  */
+  YYSYMBOL_57_ = 57,                       /* '@'  */
+  YYSYMBOL_58_ = 58,                       /* ']'  */
+  YYSYMBOL_59_ = 59,                       /* ','  */
+  YYSYMBOL_YYACCEPT = 60,                  /* $accept  */
+  YYSYMBOL_ruleset = 61,                   /* ruleset  */
+  YYSYMBOL_cond = 62,                      /* cond  */
+  YYSYMBOL_products = 63,                  /* products  */
+  YYSYMBOL_product = 64,                   /* product  */
+  YYSYMBOL_faces = 65,                     /* faces  */
+  YYSYMBOL_faceparam = 66,                 /* faceparam  */
+  YYSYMBOL_ops = 67,                       /* ops  */
+  YYSYMBOL_splitparams = 68,               /* splitparams  */
+  YYSYMBOL_op = 69,                        /* op  */
+  YYSYMBOL_expr = 70                       /* expr  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
+/* Second part of user prologue.  */
+#line 26 "/root/repo/src/parser.y"
 
-#if ! defined (YYSTYPE) && ! defined (YYSTYPE_IS_DECLARED)
-#line 16 "..\\..\\src\\parser.y"
-typedef union _YYSTYPE {
-  char *id;
-  double fl;
-  ProductVector* pv;
-  Product* p;
-  OperationVector* ov;
-  StringVector* ids;
-  ExpressionVector* ev;
-  Operation* o;
-  Expression* e;
-} YYSTYPE;
-/* Line 196 of yacc.c.  */
-#line 196 "..\\parser.cxx"
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
+static int yylex(YYSTYPE* value, RuleParser* parser) {
+  return parser->lex(value);
+}
+static void yyerror(RuleParser* parser, const char* s) {
+  parser->error(s);
+}
+// grammar objects are allocated from the parser's arena
+#define ARENA parser->getArena()
+
+#line 198 "/root/repo/MSVC/parser.cxx"
+
+
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-/* Copy the second part of user declarations.  */
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
 
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
 
-/* Line 219 of yacc.c.  */
-#line 208 "..\\parser.cxx"
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
 
-#if ! defined (YYSIZE_T) && defined (__SIZE_TYPE__)
-# define YYSIZE_T __SIZE_TYPE__
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
 #endif
-#if ! defined (YYSIZE_T) && defined (size_t)
-# define YYSIZE_T size_t
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
 #endif
-#if ! defined (YYSIZE_T) && (defined (__STDC__) || defined (__cplusplus))
-# include <stddef.h> /* INFRINGES ON USER NAME SPACE */
-# define YYSIZE_T size_t
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
-#if ! defined (YYSIZE_T)
-# define YYSIZE_T unsigned int
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
 #endif
 
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
 # endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined (yyoverflow) || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -240,141 +396,153 @@ typedef union _YYSTYPE {
 #  if YYSTACK_USE_ALLOCA
 #   ifdef __GNUC__
 #    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if defined (__STDC__) || defined (__cplusplus)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     define YYINCLUDED_STDLIB_H
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
 #    endif
 #   endif
 #  endif
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning. */
+   /* Pacify GCC's 'empty if-body' warning.  */
 #  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
        invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
        to allow for a few compiler-allocated temporary stack slots.  */
-#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2005 */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
 #  endif
 # else
 #  define YYSTACK_ALLOC YYMALLOC
 #  define YYSTACK_FREE YYFREE
 #  ifndef YYSTACK_ALLOC_MAXIMUM
-#   define YYSTACK_ALLOC_MAXIMUM ((YYSIZE_T) -1)
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  ifdef __cplusplus
-extern "C" {
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if (! defined (malloc) && ! defined (YYINCLUDED_STDLIB_H) \
-	&& (defined (__STDC__) || defined (__cplusplus)))
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if (! defined (free) && ! defined (YYINCLUDED_STDLIB_H) \
-	&& (defined (__STDC__) || defined (__cplusplus)))
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
-#  ifdef __cplusplus
-}
-#  endif
 # endif
-#endif /* ! defined (yyoverflow) || YYERROR_VERBOSE */
+#endif /* !defined yyoverflow */
 
-
-#if (! defined (yyoverflow) \
-     && (! defined (__cplusplus) \
-	 || (defined (YYSTYPE_IS_TRIVIAL) && YYSTYPE_IS_TRIVIAL)))
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  short int yyss;
-  YYSTYPE yyvs;
-  };
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (short int) + sizeof (YYSTYPE))			\
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined (__GNUC__) && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (0)
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
     while (0)
 
 #endif
 
-#if defined (__STDC__) || defined (__cplusplus)
-   typedef signed char yysigned_char;
-#else
-   typedef short int yysigned_char;
-#endif
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
 
-/* YYFINAL -- State number of the termination state. */
+/* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  2
 /* YYLAST -- Last index in YYTABLE.  */
 #define YYLAST   651
 
-/* YYNTOKENS -- Number of terminals. */
+/* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  60
-/* YYNNTS -- Number of nonterminals. */
+/* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  11
-/* YYNRULES -- Number of rules. */
+/* YYNRULES -- Number of rules.  */
 #define YYNRULES  69
-/* YYNRULES -- Number of states. */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  223
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   297
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const unsigned char yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -409,167 +577,64 @@ static const unsigned char yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const unsigned short int yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_uint8 yyrline[] =
 {
-       0,     0,     3,     4,     9,    10,    14,    15,    18,    24,
-      28,    29,    32,    35,    36,    41,    45,    46,    49,    50,
-      53,    59,    65,    70,    75,    80,    85,    89,    93,    97,
-     101,   105,   116,   122,   128,   136,   144,   150,   156,   163,
-     172,   181,   186,   193,   200,   204,   208,   212,   219,   224,
-     231,   236,   241,   247,   249,   258,   262,   267,   272,   276,
-     280,   284,   288,   292,   296,   300,   304,   308,   313,   315
+       0,    57,    57,    58,    63,    64,    66,    67,    69,    70,
+      72,    73,    74,    76,    77,    78,    80,    81,    83,    84,
+      86,    87,    88,    89,    90,    91,    92,    93,    94,    95,
+      96,    97,    98,    99,   100,   101,   102,   103,   104,   105,
+     106,   107,   108,   109,   110,   111,   112,   113,   114,   115,
+     116,   117,   118,   119,   121,   122,   123,   124,   125,   126,
+     127,   128,   129,   130,   131,   132,   133,   134,   143,   144
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS. */
-static const yysigned_char yyrhs[] =
-{
-      61,     0,    -1,    -1,    61,    41,    63,    52,    -1,    -1,
-      53,    70,    54,    -1,    -1,    63,    64,    -1,    24,    40,
-      55,    62,    67,    -1,    24,    62,    67,    -1,    -1,    65,
-      41,    -1,    65,    50,    -1,    -1,    56,    57,    41,    58,
-      -1,    56,    65,    58,    -1,    -1,    67,    69,    -1,    -1,
-      68,    70,    -1,    25,    53,    70,    54,    66,    -1,    26,
-      53,    70,    54,    66,    -1,    27,    53,    70,    54,    -1,
-      11,    53,    70,    54,    -1,    13,    53,    70,    54,    -1,
-       9,    53,    70,    54,    -1,    22,    53,    54,    -1,    39,
-      53,    54,    -1,    14,    53,    54,    -1,    15,    53,    54,
-      -1,    17,    53,    54,    -1,    16,    53,    70,    59,    70,
-      59,    70,    59,    70,    54,    -1,    32,    53,    68,    54,
-      66,    -1,    31,    53,    68,    54,    66,    -1,    32,    53,
-      68,    59,    70,    54,    66,    -1,    31,    53,    68,    59,
-      70,    54,    66,    -1,    29,    53,    70,    54,    66,    -1,
-      30,    53,    70,    54,    66,    -1,     5,    53,    70,    59,
-      70,    54,    -1,     4,    53,    70,    59,    70,    59,    70,
-      54,    -1,     3,    53,    70,    59,    70,    59,    70,    54,
-      -1,    18,    53,    70,    54,    -1,    20,    53,    41,    59,
-      41,    54,    -1,    19,    53,    41,    59,    41,    54,    -1,
-      33,    53,    54,    -1,    34,    53,    54,    -1,    36,    53,
-      54,    -1,    35,    53,    70,    59,    70,    54,    -1,    35,
-      53,    70,    54,    -1,    23,    53,    41,    47,    70,    54,
-      -1,    12,    53,    41,    54,    -1,    37,    53,    41,    54,
-      -1,    38,    53,    70,    54,    66,    -1,    41,    -1,    28,
-      53,    70,    59,    70,    59,    70,    54,    -1,    53,    70,
-      54,    -1,     8,    53,    70,    54,    -1,     7,    53,    70,
-      54,    -1,    70,    48,    70,    -1,    70,    49,    70,    -1,
-      70,    50,    70,    -1,    70,    51,    70,    -1,    70,    46,
-      70,    -1,    70,    45,    70,    -1,    70,    43,    70,    -1,
-      70,    47,    70,    -1,    70,    44,    70,    -1,    10,    53,
-      41,    54,    -1,    40,    -1,    42,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const unsigned char yyrline[] =
-{
-       0,    48,    48,    49,    54,    55,    57,    58,    60,    61,
-      63,    64,    65,    67,    68,    69,    71,    72,    74,    75,
-      77,    78,    79,    80,    81,    82,    83,    84,    85,    86,
-      87,    88,    89,    90,    91,    92,    93,    94,    95,    96,
-      97,    98,    99,   100,   101,   102,   103,   104,   105,   106,
-     107,   108,   109,   110,   112,   113,   114,   115,   116,   117,
-     118,   119,   120,   121,   122,   123,   124,   125,   126,   127
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
-   First, the terminals, then, starting at YYNTOKENS, nonterminals. */
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "TRANSLATER", "TRANSLATE", "SCALE",
-  "TEST", "ROUND", "NEG", "ASSERTION", "FACE", "TAPER", "SPAWN", "CHAMFER",
-  "TEXTURE", "TEXTUREFULL", "TEXTUREQUAD", "TEXTURECLEAR", "MATERIAL",
-  "LOADMATERIAL", "LOADMATERIALNR", "SPAWNNGON", "UNCHAMFER", "ASSIGN",
-  "DEFSIGN", "EXTRUDE", "EXTRUDET", "EXPAND", "RANDOM", "REPEATH",
-  "REPEATV", "SPLITV", "SPLITH", "MULTIFACE", "FREE", "NGON", "REMOVE",
-  "ADDFACE", "DETACHFACE", "DRIVETHROUGH", "NUMBER", "NONTERM",
-  "ATTRIBUTE", "'&'", "'|'", "'<'", "'>'", "'='", "'-'", "'+'", "'*'",
-  "'/'", "';'", "'('", "')'", "':'", "'['", "'@'", "']'", "','", "$accept",
-  "ruleset", "cond", "products", "product", "faces", "faceparam", "ops",
-  "splitparams", "op", "expr", 0
+  "\"end of file\"", "error", "\"invalid token\"", "TRANSLATER",
+  "TRANSLATE", "SCALE", "TEST", "ROUND", "NEG", "ASSERTION", "FACE",
+  "TAPER", "SPAWN", "CHAMFER", "TEXTURE", "TEXTUREFULL", "TEXTUREQUAD",
+  "TEXTURECLEAR", "MATERIAL", "LOADMATERIAL", "LOADMATERIALNR",
+  "SPAWNNGON", "UNCHAMFER", "ASSIGN", "DEFSIGN", "EXTRUDE", "EXTRUDET",
+  "EXPAND", "RANDOM", "REPEATH", "REPEATV", "SPLITV", "SPLITH",
+  "MULTIFACE", "FREE", "NGON", "REMOVE", "ADDFACE", "DETACHFACE",
+  "DRIVETHROUGH", "NUMBER", "NONTERM", "ATTRIBUTE", "'&'", "'|'", "'<'",
+  "'>'", "'='", "'-'", "'+'", "'*'", "'/'", "';'", "'('", "')'", "':'",
+  "'['", "'@'", "']'", "','", "$accept", "ruleset", "cond", "products",
+  "product", "faces", "faceparam", "ops", "splitparams", "op", "expr", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const unsigned short int yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,    38,   124,    60,    62,    61,    45,    43,
-      42,    47,    59,    40,    41,    58,    91,    64,    93,    44
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const unsigned char yyr1[] =
-{
-       0,    60,    61,    61,    62,    62,    63,    63,    64,    64,
-      65,    65,    65,    66,    66,    66,    67,    67,    68,    68,
-      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
-      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
-      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
-      69,    69,    69,    69,    70,    70,    70,    70,    70,    70,
-      70,    70,    70,    70,    70,    70,    70,    70,    70,    70
-};
+#define YYPACT_NINF (-132)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const unsigned char yyr2[] =
-{
-       0,     2,     0,     4,     0,     3,     0,     2,     5,     3,
-       0,     2,     2,     0,     4,     3,     0,     2,     0,     2,
-       5,     5,     4,     4,     4,     4,     3,     3,     3,     3,
-       3,    10,     5,     5,     7,     7,     5,     5,     6,     8,
-       8,     4,     6,     6,     3,     3,     3,     6,     4,     6,
-       4,     4,     5,     1,     8,     3,     4,     4,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     4,     1,     1
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const unsigned char yydefact[] =
-{
-       2,     0,     1,     6,     0,     4,     3,     7,     0,     0,
-      16,     4,     0,     0,     0,     0,    68,    69,     0,     0,
-       9,    16,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     5,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,    53,    17,     8,
-       0,     0,     0,     0,    55,    64,    66,    63,    62,    65,
-      58,    59,    60,    61,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    18,    18,     0,     0,     0,
-       0,     0,     0,     0,    57,    56,    67,     0,     0,     0,
-       0,     0,     0,     0,     0,    28,    29,     0,    30,     0,
-       0,     0,    26,     0,     0,     0,     0,     0,     0,     0,
-       0,    44,    45,     0,    46,     0,     0,    27,     0,     0,
-       0,     0,    25,    23,    50,    24,     0,    41,     0,     0,
-       0,    13,    13,    22,    13,    13,    13,     0,    19,    13,
-       0,    48,     0,    51,    13,     0,     0,     0,     0,     0,
-       0,     0,     0,    10,    20,    21,    36,    37,    33,     0,
-      32,     0,     0,    52,     0,     0,     0,    38,     0,    43,
-      42,    49,     0,     0,    13,    13,    47,    54,     0,     0,
-       0,     0,    11,    12,    15,    35,    34,    40,    39,     0,
-      14,     0,    31
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM]. */
-static const short int yydefgoto[] =
-{
-      -1,     1,    10,     4,     7,   203,   184,    20,   139,    68,
-     168
-};
+#define yytable_value_is_error(Yyn) \
+  ((Yyn) == YYTABLE_NINF)
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -132
-static const short int yypact[] =
+static const yytype_int16 yypact[] =
 {
     -132,     3,  -132,  -132,   -23,   -38,  -132,  -132,   -49,    57,
     -132,   -42,   -41,   -36,   -26,   -21,  -132,  -132,    57,   324,
@@ -596,19 +661,54 @@ static const short int yypact[] =
     -132,   588,  -132
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       2,     0,     1,     6,     0,     4,     3,     7,     0,     0,
+      16,     4,     0,     0,     0,     0,    68,    69,     0,     0,
+       9,    16,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     5,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    53,    17,     8,
+       0,     0,     0,     0,    55,    64,    66,    63,    62,    65,
+      58,    59,    60,    61,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    18,    18,     0,     0,     0,
+       0,     0,     0,     0,    57,    56,    67,     0,     0,     0,
+       0,     0,     0,     0,     0,    28,    29,     0,    30,     0,
+       0,     0,    26,     0,     0,     0,     0,     0,     0,     0,
+       0,    44,    45,     0,    46,     0,     0,    27,     0,     0,
+       0,     0,    25,    23,    50,    24,     0,    41,     0,     0,
+       0,    13,    13,    22,    13,    13,    13,     0,    19,    13,
+       0,    48,     0,    51,    13,     0,     0,     0,     0,     0,
+       0,     0,     0,    10,    20,    21,    36,    37,    33,     0,
+      32,     0,     0,    52,     0,     0,     0,    38,     0,    43,
+      42,    49,     0,     0,    13,    13,    47,    54,     0,     0,
+       0,     0,    11,    12,    15,    35,    34,    40,    39,     0,
+      14,     0,    31
+};
+
 /* YYPGOTO[NTERM-NUM].  */
-static const short int yypgoto[] =
+static const yytype_int16 yypgoto[] =
 {
     -132,  -132,   154,  -132,  -132,  -132,  -131,   164,    90,  -132,
       -9
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const short int yytable[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,     1,    10,     4,     7,   203,   184,    20,   139,    68,
+     168
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
       19,     5,     8,     2,    34,    35,    11,    12,    13,    26,
       14,     9,    22,    70,    71,     9,    73,    23,    75,    76,
@@ -678,7 +778,7 @@ static const short int yytable[] =
       34,    35
 };
 
-static const short int yycheck[] =
+static const yytype_int16 yycheck[] =
 {
        9,    24,    40,     0,    50,    51,    55,     7,     8,    18,
       10,    53,    53,    22,    23,    53,    25,    53,    27,    28,
@@ -748,9 +848,9 @@ static const short int yycheck[] =
       50,    51
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const unsigned char yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    61,     0,    41,    63,    24,    52,    64,    40,    53,
       62,    55,     7,     8,    10,    28,    40,    42,    53,    70,
@@ -777,95 +877,65 @@ static const unsigned char yystos[] =
       58,    70,    54
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    60,    61,    61,    62,    62,    63,    63,    64,    64,
+      65,    65,    65,    66,    66,    66,    67,    67,    68,    68,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    70,    70,    70,    70,    70,    70,
+      70,    70,    70,    70,    70,    70,    70,    70,    70,    70
+};
 
-#define YYFAIL		goto yyerrlab
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     0,     4,     0,     3,     0,     2,     5,     3,
+       0,     2,     2,     0,     4,     3,     0,     2,     0,     2,
+       5,     5,     4,     4,     4,     4,     3,     3,     3,     3,
+       3,    10,     5,     5,     7,     7,     5,     5,     6,     8,
+       8,     4,     6,     6,     3,     3,     3,     6,     4,     6,
+       4,     4,     5,     1,     8,     3,     4,     4,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     4,     1,     1
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK;						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (ruleset, YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (0)
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (N)								\
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (0)
-#endif
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-              (Loc).first_line, (Loc).first_column,	\
-              (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
 
+#define YYRECOVERING()  (!!yyerrstatus)
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (parser, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -875,48 +945,82 @@ while (0)
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
 } while (0)
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)		\
-do {								\
-  if (yydebug)							\
-    {								\
-      YYFPRINTF (stderr, "%s ", Title);				\
-      yysymprint (stderr,					\
-                  Type, Value);	\
-      YYFPRINTF (stderr, "\n");					\
-    }								\
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, parser); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
 } while (0)
 
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, RuleParser *parser)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (parser);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, RuleParser *parser)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, parser);
+  YYFPRINTF (yyo, ")");
+}
+
 /*------------------------------------------------------------------.
 | yy_stack_print -- Print the state stack from its BOTTOM up to its |
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if defined (__STDC__) || defined (__cplusplus)
-static void
-yy_stack_print (short int *bottom, short int *top)
-#else
 static void
-yy_stack_print (bottom, top)
-    short int *bottom;
-    short int *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (/* Nothing. */; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
 } while (0)
 
 
@@ -924,44 +1028,45 @@ do {								\
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if defined (__STDC__) || defined (__cplusplus)
-static void
-yy_reduce_print (int yyrule)
-#else
 static void
-yy_reduce_print (yyrule)
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, RuleParser *parser)
 {
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu), ",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
-  /* Print the symbols being reduced, and their result.  */
-  for (yyi = yyprhs[yyrule]; 0 <= yyrhs[yyi]; yyi++)
-    YYFPRINTF (stderr, "%s ", yytname[yyrhs[yyi]]);
-  YYFPRINTF (stderr, "-> %s\n", yytname[yyr1[yyrule]]);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], parser);
+      YYFPRINTF (stderr, "\n");
+    }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (Rule);		\
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, parser); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -976,206 +1081,32 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined (__GLIBC__) && defined (_STRING_H)
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-#   if defined (__STDC__) || defined (__cplusplus)
-yystrlen (const char *yystr)
-#   else
-yystrlen (yystr)
-     const char *yystr;
-#   endif
-{
-  const char *yys = yystr;
-
-  while (*yys++ != '\0')
-    continue;
-
-  return yys - yystr - 1;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined (__GLIBC__) && defined (_STRING_H) && defined (_GNU_SOURCE)
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-#   if defined (__STDC__) || defined (__cplusplus)
-yystpcpy (char *yydest, const char *yysrc)
-#   else
-yystpcpy (yydest, yysrc)
-     char *yydest;
-     const char *yysrc;
-#   endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      size_t yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-#endif /* YYERROR_VERBOSE */
-
-
-
-#if YYDEBUG
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
 
-#if defined (__STDC__) || defined (__cplusplus)
-static void
-yysymprint (FILE *yyoutput, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yysymprint (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
-{
-  /* Pacify ``unused variable'' warnings.  */
-  (void) yyvaluep;
 
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
 
 
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  switch (yytype)
-    {
-      default:
-        break;
-    }
-  YYFPRINTF (yyoutput, ")");
-}
 
-#endif /* ! YYDEBUG */
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-#if defined (__STDC__) || defined (__cplusplus)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, RuleParser *parser)
 {
-  /* Pacify ``unused variable'' warnings.  */
-  (void) yyvaluep;
-
+  YY_USE (yyvaluep);
+  YY_USE (parser);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
 
-/* Prevent warnings from -Wmissing-prototypes.  */
 
-#ifdef YYPARSE_PARAM
-# if defined (__STDC__) || defined (__cplusplus)
-int yyparse (void *YYPARSE_PARAM);
-# else
-int yyparse ();
-# endif
-#else /* ! YYPARSE_PARAM */
-#if defined (__STDC__) || defined (__cplusplus)
-int yyparse (RuleSet *ruleset);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
-
-
-/* The look-ahead symbol.  */
-int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
-
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
@@ -1183,193 +1114,193 @@ int yynerrs;
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-# if defined (__STDC__) || defined (__cplusplus)
-int yyparse (void *YYPARSE_PARAM)
-# else
-int yyparse (YYPARSE_PARAM)
-  void *YYPARSE_PARAM;
-# endif
-#else /* ! YYPARSE_PARAM */
-#if defined (__STDC__) || defined (__cplusplus)
 int
-yyparse (RuleSet *ruleset)
-#else
-int
-yyparse (ruleset)
-    RuleSet *ruleset;
-#endif
-#endif
+yyparse (RuleParser *parser)
 {
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+/* Lookahead token kind.  */
+int yychar;
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-  /* The state stack.  */
-  short int yyssa[YYINITDEPTH];
-  short int *yyss = yyssa;
-  short int *yyssp;
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-#define YYPOPSTACK   (yyvsp--, yyssp--)
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-  YYSIZE_T yystacksize = YYINITDEPTH;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
 
-  /* When reducing, the number of symbols on the RHS of the reduced
-     rule.  */
-  int yylen;
 
-  YYDPRINTF ((stderr, "Starting parse\n"));
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
+  YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yyssp = yyss;
-  yyvsp = yyvs;
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
-     have just been pushed. so pushing a state here evens the stacks.
-     */
+     have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack. Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	short int *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	short int *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
 
-/* Do appropriate processing given the current state.  */
-/* Read a look-ahead token if we need one and don't already have one.  */
-/* yyresume: */
-
-  /* First try to decide what to do without reference to look-ahead token.  */
-
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, parser);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1384,31 +1315,26 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
-  /* Shift the look-ahead token.  */
-  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the token being shifted unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
-  *++yyvsp = yylval;
-
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1423,14 +1349,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1443,510 +1369,490 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 3:
-#line 49 "..\\..\\src\\parser.y"
-    { 
+  case 3: /* ruleset: ruleset NONTERM products ';'  */
+#line 58 "/root/repo/src/parser.y"
+                                 { 
     String name = String((yyvsp[-2].id));
-    ruleset->addRule(name,new Rule(name,(yyvsp[-1].pv)));
-  ;}
+    parser->addRule(name,Rule::create(ARENA,name,(yyvsp[-1].pv)));
+  }
+#line 1379 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 4:
-#line 54 "..\\..\\src\\parser.y"
-    { (yyval.e) = NULL; ;}
+  case 4: /* cond: %empty  */
+#line 63 "/root/repo/src/parser.y"
+                   { (yyval.e) = NULL; }
+#line 1385 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 5:
-#line 55 "..\\..\\src\\parser.y"
-    { (yyval.e) = (yyvsp[-1].e); ;}
+  case 5: /* cond: '(' expr ')'  */
+#line 64 "/root/repo/src/parser.y"
+                 { (yyval.e) = (yyvsp[-1].e); }
+#line 1391 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 6:
-#line 57 "..\\..\\src\\parser.y"
-    { (yyval.pv) = new ProductVector(); ;}
+  case 6: /* products: %empty  */
+#line 66 "/root/repo/src/parser.y"
+                       { (yyval.pv) = new ProductVector(); }
+#line 1397 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 7:
-#line 58 "..\\..\\src\\parser.y"
-    { (yyval.pv) = (yyvsp[-1].pv); (yyval.pv)->push_back((yyvsp[0].p)); ;}
+  case 7: /* products: products product  */
+#line 67 "/root/repo/src/parser.y"
+                     { (yyval.pv) = (yyvsp[-1].pv); (yyval.pv)->push_back((yyvsp[0].p)); }
+#line 1403 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 8:
-#line 60 "..\\..\\src\\parser.y"
-    { (yyval.p) = new Product((yyvsp[0].ov),(yyvsp[-3].fl),(yyvsp[-1].e)); ;}
+  case 8: /* product: DEFSIGN NUMBER ':' cond ops  */
+#line 69 "/root/repo/src/parser.y"
+                                      { (yyval.p) = new (ARENA) Product(ARENA,(yyvsp[0].ov),(yyvsp[-3].fl),(yyvsp[-1].e)); }
+#line 1409 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 9:
-#line 61 "..\\..\\src\\parser.y"
-    { (yyval.p) = new Product((yyvsp[0].ov),1.0,(yyvsp[-1].e)); ;}
+  case 9: /* product: DEFSIGN cond ops  */
+#line 70 "/root/repo/src/parser.y"
+                     { (yyval.p) = new (ARENA) Product(ARENA,(yyvsp[0].ov),1.0,(yyvsp[-1].e)); }
+#line 1415 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 10:
-#line 63 "..\\..\\src\\parser.y"
-    { (yyval.ids) = new StringVector(); ;}
+  case 10: /* faces: %empty  */
+#line 72 "/root/repo/src/parser.y"
+                    { (yyval.ids) = new StringVector(); }
+#line 1421 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 11:
-#line 64 "..\\..\\src\\parser.y"
-    { String name = String((yyvsp[0].id)); (yyval.ids)->push_back(name); ;}
+  case 11: /* faces: faces NONTERM  */
+#line 73 "/root/repo/src/parser.y"
+                   { String name = String((yyvsp[0].id)); (yyval.ids)->push_back(name); }
+#line 1427 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 12:
-#line 65 "..\\..\\src\\parser.y"
-    { String name = String(""); (yyval.ids)->push_back(name); ;}
+  case 12: /* faces: faces '*'  */
+#line 74 "/root/repo/src/parser.y"
+              { String name = String(""); (yyval.ids)->push_back(name); }
+#line 1433 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 13:
-#line 67 "..\\..\\src\\parser.y"
-    { (yyval.ids) = NULL; ;}
+  case 13: /* faceparam: %empty  */
+#line 76 "/root/repo/src/parser.y"
+                        { (yyval.ids) = NULL; }
+#line 1439 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 14:
-#line 68 "..\\..\\src\\parser.y"
-    { String name = '@'+String((yyvsp[-1].id)); (yyval.ids) = new StringVector(); (yyval.ids)->push_back(name); ;}
+  case 14: /* faceparam: '[' '@' NONTERM ']'  */
+#line 77 "/root/repo/src/parser.y"
+                        { String name = '@'+String((yyvsp[-1].id)); (yyval.ids) = new StringVector(); (yyval.ids)->push_back(name); }
+#line 1445 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 15:
-#line 69 "..\\..\\src\\parser.y"
-    { (yyval.ids) = (yyvsp[-1].ids); ;}
+  case 15: /* faceparam: '[' faces ']'  */
+#line 78 "/root/repo/src/parser.y"
+                  { (yyval.ids) = (yyvsp[-1].ids); }
+#line 1451 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 16:
-#line 71 "..\\..\\src\\parser.y"
-    { (yyval.ov) = new OperationVector(); ;}
+  case 16: /* ops: %empty  */
+#line 80 "/root/repo/src/parser.y"
+                  { (yyval.ov) = new OperationVector(); }
+#line 1457 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 17:
-#line 72 "..\\..\\src\\parser.y"
-    { (yyval.ov) = (yyvsp[-1].ov); (yyval.ov)->push_back((yyvsp[0].o)); ;}
+  case 17: /* ops: ops op  */
+#line 81 "/root/repo/src/parser.y"
+           { (yyval.ov) = (yyvsp[-1].ov); (yyval.ov)->push_back((yyvsp[0].o)); }
+#line 1463 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 18:
-#line 74 "..\\..\\src\\parser.y"
-    { (yyval.ev) = new ExpressionVector(); ;}
+  case 18: /* splitparams: %empty  */
+#line 83 "/root/repo/src/parser.y"
+                           { (yyval.ev) = new ExpressionVector(); }
+#line 1469 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 19:
-#line 75 "..\\..\\src\\parser.y"
-    { (yyval.ev)->push_back((yyvsp[0].e)); ;}
+  case 19: /* splitparams: splitparams expr  */
+#line 84 "/root/repo/src/parser.y"
+                     { (yyval.ev)->push_back((yyvsp[0].e)); }
+#line 1475 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 20:
-#line 77 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationExtrude(ruleset,(yyvsp[-2].e),(yyvsp[0].ids)); ;}
+  case 20: /* op: EXTRUDE '(' expr ')' faceparam  */
+#line 86 "/root/repo/src/parser.y"
+                                    { (yyval.o) = new (ARENA) OperationExtrude(parser->getRuleSet(),ARENA,(yyvsp[-2].e),(yyvsp[0].ids)); }
+#line 1481 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 21:
-#line 78 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationExtrudeT(ruleset,(yyvsp[-2].e),(yyvsp[0].ids)); ;}
+  case 21: /* op: EXTRUDET '(' expr ')' faceparam  */
+#line 87 "/root/repo/src/parser.y"
+                                    { (yyval.o) = new (ARENA) OperationExtrudeT(parser->getRuleSet(),ARENA,(yyvsp[-2].e),(yyvsp[0].ids)); }
+#line 1487 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 22:
-#line 79 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationExpand(ruleset,(yyvsp[-1].e)); ;}
+  case 22: /* op: EXPAND '(' expr ')'  */
+#line 88 "/root/repo/src/parser.y"
+                        { (yyval.o) = new (ARENA) OperationExpand(parser->getRuleSet(),(yyvsp[-1].e)); }
+#line 1493 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 23:
-#line 80 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationTaper(ruleset,(yyvsp[-1].e)); ;}
+  case 23: /* op: TAPER '(' expr ')'  */
+#line 89 "/root/repo/src/parser.y"
+                       { (yyval.o) = new (ARENA) OperationTaper(parser->getRuleSet(),(yyvsp[-1].e)); }
+#line 1499 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 24:
-#line 81 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationChamfer(ruleset,(yyvsp[-1].e)); ;}
+  case 24: /* op: CHAMFER '(' expr ')'  */
+#line 90 "/root/repo/src/parser.y"
+                         { (yyval.o) = new (ARENA) OperationChamfer(parser->getRuleSet(),(yyvsp[-1].e)); }
+#line 1505 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 25:
-#line 82 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationAssert(ruleset,(yyvsp[-1].e)); ;}
+  case 25: /* op: ASSERTION '(' expr ')'  */
+#line 91 "/root/repo/src/parser.y"
+                           { (yyval.o) = new (ARENA) OperationAssert(parser->getRuleSet(),(yyvsp[-1].e)); }
+#line 1511 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 26:
-#line 83 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationUnchamfer(ruleset); ;}
+  case 26: /* op: UNCHAMFER '(' ')'  */
+#line 92 "/root/repo/src/parser.y"
+                      { (yyval.o) = new (ARENA) OperationUnchamfer(parser->getRuleSet()); }
+#line 1517 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 27:
-#line 84 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationDriveThrough(ruleset); ;}
+  case 27: /* op: DRIVETHROUGH '(' ')'  */
+#line 93 "/root/repo/src/parser.y"
+                         { (yyval.o) = new (ARENA) OperationDriveThrough(parser->getRuleSet()); }
+#line 1523 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 28:
-#line 85 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationTexture(ruleset); ;}
+  case 28: /* op: TEXTURE '(' ')'  */
+#line 94 "/root/repo/src/parser.y"
+                    { (yyval.o) = new (ARENA) OperationTexture(parser->getRuleSet()); }
+#line 1529 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 29:
-#line 86 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationTextureFull(ruleset); ;}
+  case 29: /* op: TEXTUREFULL '(' ')'  */
+#line 95 "/root/repo/src/parser.y"
+                        { (yyval.o) = new (ARENA) OperationTextureFull(parser->getRuleSet()); }
+#line 1535 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 30:
-#line 87 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationTextureClear(ruleset); ;}
+  case 30: /* op: TEXTURECLEAR '(' ')'  */
+#line 96 "/root/repo/src/parser.y"
+                         { (yyval.o) = new (ARENA) OperationTextureClear(parser->getRuleSet()); }
+#line 1541 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 31:
-#line 88 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationTextureQuad(ruleset,(yyvsp[-7].e),(yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); ;}
+  case 31: /* op: TEXTUREQUAD '(' expr ',' expr ',' expr ',' expr ')'  */
+#line 97 "/root/repo/src/parser.y"
+                                                        { (yyval.o) = new (ARENA) OperationTextureQuad(parser->getRuleSet(),(yyvsp[-7].e),(yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); }
+#line 1547 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 32:
-#line 89 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationSplitFace(ruleset,true,(yyvsp[0].ids),(yyvsp[-2].ev)); ;}
+  case 32: /* op: SPLITH '(' splitparams ')' faceparam  */
+#line 98 "/root/repo/src/parser.y"
+                                         { (yyval.o) = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,true,(yyvsp[0].ids),(yyvsp[-2].ev)); }
+#line 1553 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 33:
-#line 90 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationSplitFace(ruleset,false,(yyvsp[0].ids),(yyvsp[-2].ev)); ;}
+  case 33: /* op: SPLITV '(' splitparams ')' faceparam  */
+#line 99 "/root/repo/src/parser.y"
+                                         { (yyval.o) = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,false,(yyvsp[0].ids),(yyvsp[-2].ev)); }
+#line 1559 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 34:
-#line 91 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationSplitFace(ruleset,true,(yyvsp[0].ids),(yyvsp[-4].ev),(yyvsp[-2].e)); ;}
+  case 34: /* op: SPLITH '(' splitparams ',' expr ')' faceparam  */
+#line 100 "/root/repo/src/parser.y"
+                                                  { (yyval.o) = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,true,(yyvsp[0].ids),(yyvsp[-4].ev),(yyvsp[-2].e)); }
+#line 1565 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 35:
-#line 92 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationSplitFace(ruleset,false,(yyvsp[0].ids),(yyvsp[-4].ev),(yyvsp[-2].e)); ;}
+  case 35: /* op: SPLITV '(' splitparams ',' expr ')' faceparam  */
+#line 101 "/root/repo/src/parser.y"
+                                                  { (yyval.o) = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,false,(yyvsp[0].ids),(yyvsp[-4].ev),(yyvsp[-2].e)); }
+#line 1571 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 36:
-#line 93 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationRepeat(ruleset,(yyvsp[-2].e),true,(yyvsp[0].ids)); ;}
+  case 36: /* op: REPEATH '(' expr ')' faceparam  */
+#line 102 "/root/repo/src/parser.y"
+                                   { (yyval.o) = new (ARENA) OperationRepeat(parser->getRuleSet(),ARENA,(yyvsp[-2].e),true,(yyvsp[0].ids)); }
+#line 1577 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 37:
-#line 94 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationRepeat(ruleset,(yyvsp[-2].e),false,(yyvsp[0].ids)); ;}
+  case 37: /* op: REPEATV '(' expr ')' faceparam  */
+#line 103 "/root/repo/src/parser.y"
+                                   { (yyval.o) = new (ARENA) OperationRepeat(parser->getRuleSet(),ARENA,(yyvsp[-2].e),false,(yyvsp[0].ids)); }
+#line 1583 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 38:
-#line 95 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationScale(ruleset,(yyvsp[-3].e),(yyvsp[-1].e)); ;}
+  case 38: /* op: SCALE '(' expr ',' expr ')'  */
+#line 104 "/root/repo/src/parser.y"
+                                { (yyval.o) = new (ARENA) OperationScale(parser->getRuleSet(),(yyvsp[-3].e),(yyvsp[-1].e)); }
+#line 1589 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 39:
-#line 96 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationTranslate(ruleset,(yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); ;}
+  case 39: /* op: TRANSLATE '(' expr ',' expr ',' expr ')'  */
+#line 105 "/root/repo/src/parser.y"
+                                             { (yyval.o) = new (ARENA) OperationTranslate(parser->getRuleSet(),(yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); }
+#line 1595 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 40:
-#line 97 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationTranslateR(ruleset,(yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); ;}
+  case 40: /* op: TRANSLATER '(' expr ',' expr ',' expr ')'  */
+#line 106 "/root/repo/src/parser.y"
+                                              { (yyval.o) = new (ARENA) OperationTranslateR(parser->getRuleSet(),(yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); }
+#line 1601 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 41:
-#line 98 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationMaterial(ruleset,(yyvsp[-1].e)); ;}
+  case 41: /* op: MATERIAL '(' expr ')'  */
+#line 107 "/root/repo/src/parser.y"
+                          { (yyval.o) = new (ARENA) OperationMaterial(parser->getRuleSet(),(yyvsp[-1].e)); }
+#line 1607 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 42:
-#line 99 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationLoadMaterial(ruleset,(yyvsp[-3].id),(yyvsp[-1].id),true); ;}
+  case 42: /* op: LOADMATERIALNR '(' NONTERM ',' NONTERM ')'  */
+#line 108 "/root/repo/src/parser.y"
+                                               { (yyval.o) = new (ARENA) OperationLoadMaterial(parser->getRuleSet(),ARENA,(yyvsp[-3].id),(yyvsp[-1].id),true); }
+#line 1613 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 43:
-#line 100 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationLoadMaterial(ruleset,(yyvsp[-3].id),(yyvsp[-1].id),false); ;}
+  case 43: /* op: LOADMATERIAL '(' NONTERM ',' NONTERM ')'  */
+#line 109 "/root/repo/src/parser.y"
+                                             { (yyval.o) = new (ARENA) OperationLoadMaterial(parser->getRuleSet(),ARENA,(yyvsp[-3].id),(yyvsp[-1].id),false); }
+#line 1619 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 44:
-#line 101 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationMultiFace(ruleset); ;}
+  case 44: /* op: MULTIFACE '(' ')'  */
+#line 110 "/root/repo/src/parser.y"
+                      { (yyval.o) = new (ARENA) OperationMultiFace(parser->getRuleSet()); }
+#line 1625 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 45:
-#line 102 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationFree(ruleset); ;}
+  case 45: /* op: FREE '(' ')'  */
+#line 111 "/root/repo/src/parser.y"
+                 { (yyval.o) = new (ARENA) OperationFree(parser->getRuleSet()); }
+#line 1631 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 46:
-#line 103 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationRemove(ruleset); ;}
+  case 46: /* op: REMOVE '(' ')'  */
+#line 112 "/root/repo/src/parser.y"
+                   { (yyval.o) = new (ARENA) OperationRemove(parser->getRuleSet()); }
+#line 1637 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 47:
-#line 104 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationNGon(ruleset,(yyvsp[-3].e),(yyvsp[-1].e)); ;}
+  case 47: /* op: NGON '(' expr ',' expr ')'  */
+#line 113 "/root/repo/src/parser.y"
+                               { (yyval.o) = new (ARENA) OperationNGon(parser->getRuleSet(),(yyvsp[-3].e),(yyvsp[-1].e)); }
+#line 1643 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 48:
-#line 105 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationNGon(ruleset,(yyvsp[-1].e)); ;}
+  case 48: /* op: NGON '(' expr ')'  */
+#line 114 "/root/repo/src/parser.y"
+                      { (yyval.o) = new (ARENA) OperationNGon(parser->getRuleSet(),(yyvsp[-1].e)); }
+#line 1649 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 49:
-#line 106 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationAssign(ruleset,(yyvsp[-1].e),(yyvsp[-3].id)); ;}
+  case 49: /* op: ASSIGN '(' NONTERM '=' expr ')'  */
+#line 115 "/root/repo/src/parser.y"
+                                    { (yyval.o) = new (ARENA) OperationAssign(parser->getRuleSet(),(yyvsp[-1].e),(yyvsp[-3].id)); }
+#line 1655 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 50:
-#line 107 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationSpawn(ruleset,(yyvsp[-1].id)); ;}
+  case 50: /* op: SPAWN '(' NONTERM ')'  */
+#line 116 "/root/repo/src/parser.y"
+                          { (yyval.o) = new (ARENA) OperationSpawn(parser->getRuleSet(),ARENA,(yyvsp[-1].id)); }
+#line 1661 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 51:
-#line 108 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationAddFace(ruleset,(yyvsp[-1].id)); ;}
+  case 51: /* op: ADDFACE '(' NONTERM ')'  */
+#line 117 "/root/repo/src/parser.y"
+                            { (yyval.o) = new (ARENA) OperationAddFace(parser->getRuleSet(),ARENA,(yyvsp[-1].id)); }
+#line 1667 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 52:
-#line 109 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationDetachFace(ruleset,(yyvsp[-2].e),(yyvsp[0].ids)); ;}
+  case 52: /* op: DETACHFACE '(' expr ')' faceparam  */
+#line 118 "/root/repo/src/parser.y"
+                                      { (yyval.o) = new (ARENA) OperationDetachFace(parser->getRuleSet(),ARENA,(yyvsp[-2].e),(yyvsp[0].ids)); }
+#line 1673 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 53:
-#line 110 "..\\..\\src\\parser.y"
-    { (yyval.o) = new OperationNonterminal(ruleset,(yyvsp[0].id)); ;}
+  case 53: /* op: NONTERM  */
+#line 119 "/root/repo/src/parser.y"
+            { (yyval.o) = new (ARENA) OperationNonterminal(parser->getRuleSet(),ARENA,(yyvsp[0].id)); }
+#line 1679 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 54:
-#line 112 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionRandom((yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); ;}
+  case 54: /* expr: RANDOM '(' expr ',' expr ',' expr ')'  */
+#line 121 "/root/repo/src/parser.y"
+                                             { (yyval.e) = new (ARENA) ExpressionRandom((yyvsp[-5].e),(yyvsp[-3].e),(yyvsp[-1].e)); }
+#line 1685 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 55:
-#line 113 "..\\..\\src\\parser.y"
-    { (yyval.e) = (yyvsp[-1].e); ;}
+  case 55: /* expr: '(' expr ')'  */
+#line 122 "/root/repo/src/parser.y"
+                   { (yyval.e) = (yyvsp[-1].e); }
+#line 1691 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 56:
-#line 114 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionNeg((yyvsp[-1].e)); ;}
+  case 56: /* expr: NEG '(' expr ')'  */
+#line 123 "/root/repo/src/parser.y"
+                     { (yyval.e) = new (ARENA) ExpressionNeg((yyvsp[-1].e)); }
+#line 1697 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 57:
-#line 115 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionRound((yyvsp[-1].e)); ;}
+  case 57: /* expr: ROUND '(' expr ')'  */
+#line 124 "/root/repo/src/parser.y"
+                       { (yyval.e) = new (ARENA) ExpressionRound((yyvsp[-1].e)); }
+#line 1703 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 58:
-#line 116 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionSub((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 58: /* expr: expr '-' expr  */
+#line 125 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionSub((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1709 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 59:
-#line 117 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionAdd((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 59: /* expr: expr '+' expr  */
+#line 126 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionAdd((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1715 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 60:
-#line 118 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionMult((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 60: /* expr: expr '*' expr  */
+#line 127 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionMult((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1721 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 61:
-#line 119 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionDiv((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 61: /* expr: expr '/' expr  */
+#line 128 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionDiv((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1727 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 62:
-#line 120 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionGreater((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 62: /* expr: expr '>' expr  */
+#line 129 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionGreater((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1733 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 63:
-#line 121 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionGreater((yyvsp[0].e),(yyvsp[-2].e)); ;}
+  case 63: /* expr: expr '<' expr  */
+#line 130 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionGreater((yyvsp[0].e),(yyvsp[-2].e)); }
+#line 1739 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 64:
-#line 122 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionAnd((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 64: /* expr: expr '&' expr  */
+#line 131 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionAnd((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1745 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 65:
-#line 123 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionEqual((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 65: /* expr: expr '=' expr  */
+#line 132 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionEqual((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1751 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 66:
-#line 124 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionOr((yyvsp[-2].e),(yyvsp[0].e)); ;}
+  case 66: /* expr: expr '|' expr  */
+#line 133 "/root/repo/src/parser.y"
+                  { (yyval.e) = new (ARENA) ExpressionOr((yyvsp[-2].e),(yyvsp[0].e)); }
+#line 1757 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 67:
-#line 125 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionFaceAttribute((yyvsp[-1].id)); ;}
+  case 67: /* expr: FACE '(' NONTERM ')'  */
+#line 134 "/root/repo/src/parser.y"
+                         {
+      int attr = ExpressionFaceAttribute::attributeId((yyvsp[-1].id));
+      if (attr < 0) {
+        String error = String("unknown face() attribute '") + (yyvsp[-1].id) + "'";
+        yyerror(parser, error.c_str());
+        YYERROR;
+      }
+      (yyval.e) = new (ARENA) ExpressionFaceAttribute(ExpressionFaceAttribute::Attribute(attr));
+    }
+#line 1771 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 68:
-#line 126 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionConst((yyvsp[0].fl)); ;}
+  case 68: /* expr: NUMBER  */
+#line 143 "/root/repo/src/parser.y"
+           { (yyval.e) = new (ARENA) ExpressionConst((yyvsp[0].fl)); }
+#line 1777 "/root/repo/MSVC/parser.cxx"
     break;
 
-  case 69:
-#line 127 "..\\..\\src\\parser.y"
-    { (yyval.e) = new ExpressionAttribute(ruleset,(yyvsp[0].id)); ;}
+  case 69: /* expr: ATTRIBUTE  */
+#line 144 "/root/repo/src/parser.y"
+              { (yyval.e) = new (ARENA) ExpressionAttribute(parser->getRuleSet(),(yyvsp[0].id)); }
+#line 1783 "/root/repo/MSVC/parser.cxx"
     break;
 
 
+#line 1787 "/root/repo/MSVC/parser.cxx"
+
       default: break;
     }
-
-/* Line 1126 of yacc.c.  */
-#line 1790 "..\\parser.cxx"
-
-  yyvsp -= yylen;
-  yyssp -= yylen;
-
-
-  YY_STACK_PRINT (yyss, yyssp);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
 
   *++yyvsp = yyval;
 
-
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if YYERROR_VERBOSE
-      yyn = yypact[yystate];
-
-      if (YYPACT_NINF < yyn && yyn < YYLAST)
-	{
-	  int yytype = YYTRANSLATE (yychar);
-	  YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-	  YYSIZE_T yysize = yysize0;
-	  YYSIZE_T yysize1;
-	  int yysize_overflow = 0;
-	  char *yymsg = 0;
-#	  define YYERROR_VERBOSE_ARGS_MAXIMUM 5
-	  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-	  int yyx;
-
-#if 0
-	  /* This is so xgettext sees the translatable formats that are
-	     constructed on the fly.  */
-	  YY_("syntax error, unexpected %s");
-	  YY_("syntax error, unexpected %s, expecting %s");
-	  YY_("syntax error, unexpected %s, expecting %s or %s");
-	  YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-	  YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-#endif
-	  char *yyfmt;
-	  char const *yyf;
-	  static char const yyunexpected[] = "syntax error, unexpected %s";
-	  static char const yyexpecting[] = ", expecting %s";
-	  static char const yyor[] = " or %s";
-	  char yyformat[sizeof yyunexpected
-			+ sizeof yyexpecting - 1
-			+ ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-			   * (sizeof yyor - 1))];
-	  char const *yyprefix = yyexpecting;
-
-	  /* Start YYX at -YYN if negative to avoid negative indexes in
-	     YYCHECK.  */
-	  int yyxbegin = yyn < 0 ? -yyn : 0;
-
-	  /* Stay within bounds of both yycheck and yytname.  */
-	  int yychecklim = YYLAST - yyn;
-	  int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-	  int yycount = 1;
-
-	  yyarg[0] = yytname[yytype];
-	  yyfmt = yystpcpy (yyformat, yyunexpected);
-
-	  for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	    if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	      {
-		if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-		  {
-		    yycount = 1;
-		    yysize = yysize0;
-		    yyformat[sizeof yyunexpected - 1] = '\0';
-		    break;
-		  }
-		yyarg[yycount++] = yytname[yyx];
-		yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-		yysize_overflow |= yysize1 < yysize;
-		yysize = yysize1;
-		yyfmt = yystpcpy (yyfmt, yyprefix);
-		yyprefix = yyor;
-	      }
-
-	  yyf = YY_(yyformat);
-	  yysize1 = yysize + yystrlen (yyf);
-	  yysize_overflow |= yysize1 < yysize;
-	  yysize = yysize1;
-
-	  if (!yysize_overflow && yysize <= YYSTACK_ALLOC_MAXIMUM)
-	    yymsg = (char *) YYSTACK_ALLOC (yysize);
-	  if (yymsg)
-	    {
-	      /* Avoid sprintf, as that infringes on the user's name space.
-		 Don't have undefined behavior even if the translation
-		 produced a string with the wrong number of "%s"s.  */
-	      char *yyp = yymsg;
-	      int yyi = 0;
-	      while ((*yyp = *yyf))
-		{
-		  if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		    {
-		      yyp += yytnamerr (yyp, yyarg[yyi++]);
-		      yyf += 2;
-		    }
-		  else
-		    {
-		      yyp++;
-		      yyf++;
-		    }
-		}
-	      yyerror (ruleset, yymsg);
-	      YYSTACK_FREE (yymsg);
-	    }
-	  else
-	    {
-	      yyerror (ruleset, YY_("syntax error"));
-	      goto yyexhaustedlab;
-	    }
-	}
-      else
-#endif /* YYERROR_VERBOSE */
-	yyerror (ruleset, YY_("syntax error"));
+      yyerror (parser, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
         {
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
         }
       else
-	{
-	  yydestruct ("Error: discarding", yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, parser);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -1955,15 +1861,17 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
   if (0)
-     goto yyerrorlab;
+    YYERROR;
+  ++yynerrs;
 
-yyvsp -= yylen;
-  yyssp -= yylen;
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
   yystate = *yyssp;
   goto yyerrlab1;
 
@@ -1972,41 +1880,42 @@ yyvsp -= yylen;
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
-      yydestruct ("Error: popping", yystos[yystate], yyvsp);
-      YYPOPSTACK;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, parser);
+      YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
-  /* Shift the error token. */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2017,43 +1926,55 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (ruleset, YY_("memory exhausted"));
+  yyerror (parser, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, parser);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
-      YYPOPSTACK;
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, parser);
+      YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
+
   return yyresult;
 }
 
-
-#line 129 "..\\..\\src\\parser.y"
-
+#line 146 "/root/repo/src/parser.y"
 
@@ -1,12 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton parser for Yacc-like parsing with Bison,
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
+/* Bison interface for Yacc-like parsers in C
 
-   This program is free software; you can redistribute it and/or modify
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -14,111 +16,95 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
 
-/* As a special exception, when this file is copied by Bison into a
-   Bison output file, you may use that output file without restriction.
-   This special exception was added by the Free Software Foundation
-   in version 1.24 of Bison.  */
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
 
-/* Tokens.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_ROOT_REPO_MSVC_PARSER_HXX_INCLUDED
+# define YY_YY_ROOT_REPO_MSVC_PARSER_HXX_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     TRANSLATER = 258,
-     TRANSLATE = 259,
-     SCALE = 260,
-     TEST = 261,
-     ROUND = 262,
-     NEG = 263,
-     ASSERTION = 264,
-     FACE = 265,
-     TAPER = 266,
-     SPAWN = 267,
-     CHAMFER = 268,
-     TEXTURE = 269,
-     TEXTUREFULL = 270,
-     TEXTUREQUAD = 271,
-     TEXTURECLEAR = 272,
-     MATERIAL = 273,
-     LOADMATERIAL = 274,
-     LOADMATERIALNR = 275,
-     SPAWNNGON = 276,
-     UNCHAMFER = 277,
-     ASSIGN = 278,
-     DEFSIGN = 279,
-     EXTRUDE = 280,
-     EXTRUDET = 281,
-     EXPAND = 282,
-     RANDOM = 283,
-     REPEATH = 284,
-     REPEATV = 285,
-     SPLITV = 286,
-     SPLITH = 287,
-     MULTIFACE = 288,
-     FREE = 289,
-     NGON = 290,
-     REMOVE = 291,
-     ADDFACE = 292,
-     DETACHFACE = 293,
-     DRIVETHROUGH = 294,
-     NUMBER = 295,
-     NONTERM = 296,
-     ATTRIBUTE = 297
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    TRANSLATER = 258,              /* TRANSLATER  */
+    TRANSLATE = 259,               /* TRANSLATE  */
+    SCALE = 260,                   /* SCALE  */
+    TEST = 261,                    /* TEST  */
+    ROUND = 262,                   /* ROUND  */
+    NEG = 263,                     /* NEG  */
+    ASSERTION = 264,               /* ASSERTION  */
+    FACE = 265,                    /* FACE  */
+    TAPER = 266,                   /* TAPER  */
+    SPAWN = 267,                   /* SPAWN  */
+    CHAMFER = 268,                 /* CHAMFER  */
+    TEXTURE = 269,                 /* TEXTURE  */
+    TEXTUREFULL = 270,             /* TEXTUREFULL  */
+    TEXTUREQUAD = 271,             /* TEXTUREQUAD  */
+    TEXTURECLEAR = 272,            /* TEXTURECLEAR  */
+    MATERIAL = 273,                /* MATERIAL  */
+    LOADMATERIAL = 274,            /* LOADMATERIAL  */
+    LOADMATERIALNR = 275,          /* LOADMATERIALNR  */
+    SPAWNNGON = 276,               /* SPAWNNGON  */
+    UNCHAMFER = 277,               /* UNCHAMFER  */
+    ASSIGN = 278,                  /* ASSIGN  */
+    DEFSIGN = 279,                 /* DEFSIGN  */
+    EXTRUDE = 280,                 /* EXTRUDE  */
+    EXTRUDET = 281,                /* EXTRUDET  */
+    EXPAND = 282,                  /* EXPAND  */
+    RANDOM = 283,                  /* RANDOM  */
+    REPEATH = 284,                 /* REPEATH  */
+    REPEATV = 285,                 /* REPEATV  */
+    SPLITV = 286,                  /* SPLITV  */
+    SPLITH = 287,                  /* SPLITH  */
+    MULTIFACE = 288,               /* MULTIFACE  */
+    FREE = 289,                    /* FREE  */
+    NGON = 290,                    /* NGON  */
+    REMOVE = 291,                  /* REMOVE  */
+    ADDFACE = 292,                 /* ADDFACE  */
+    DETACHFACE = 293,              /* DETACHFACE  */
+    DRIVETHROUGH = 294,            /* DRIVETHROUGH  */
+    NUMBER = 295,                  /* NUMBER  */
+    NONTERM = 296,                 /* NONTERM  */
+    ATTRIBUTE = 297                /* ATTRIBUTE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define TRANSLATER 258
-#define TRANSLATE 259
-#define SCALE 260
-#define TEST 261
-#define ROUND 262
-#define NEG 263
-#define ASSERTION 264
-#define FACE 265
-#define TAPER 266
-#define SPAWN 267
-#define CHAMFER 268
-#define TEXTURE 269
-#define TEXTUREFULL 270
-#define TEXTUREQUAD 271
-#define TEXTURECLEAR 272
-#define MATERIAL 273
-#define LOADMATERIAL 274
-#define LOADMATERIALNR 275
-#define SPAWNNGON 276
-#define UNCHAMFER 277
-#define ASSIGN 278
-#define DEFSIGN 279
-#define EXTRUDE 280
-#define EXTRUDET 281
-#define EXPAND 282
-#define RANDOM 283
-#define REPEATH 284
-#define REPEATV 285
-#define SPLITV 286
-#define SPLITH 287
-#define MULTIFACE 288
-#define FREE 289
-#define NGON 290
-#define REMOVE 291
-#define ADDFACE 292
-#define DETACHFACE 293
-#define DRIVETHROUGH 294
-#define NUMBER 295
-#define NONTERM 296
-#define ATTRIBUTE 297
-
-
-
-
-#if ! defined (YYSTYPE) && ! defined (YYSTYPE_IS_DECLARED)
-#line 16 "..\\..\\src\\parser.y"
-typedef union _YYSTYPE {
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+#line 15 "/root/repo/src/parser.y"
+union _YYSTYPE
+{
+#line 15 "/root/repo/src/parser.y"
+
   char *id;
   double fl;
   ProductVector* pv;
@@ -128,15 +114,20 @@ typedef union _YYSTYPE {
   ExpressionVector* ev;
   Operation* o;
   Expression* e;
-} YYSTYPE;
-/* Line 1447 of yacc.c.  */
-#line 134 "..\\parser.hxx"
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 119 "/root/repo/MSVC/parser.hxx"
+
+};
+#line 15 "/root/repo/src/parser.y"
+typedef union _YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
 
 
 
+int yyparse (RuleParser *parser);
+
+
+#endif /* !YY_YY_ROOT_REPO_MSVC_PARSER_HXX_INCLUDED  */
@@ -0,0 +1,278 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * allocations.cxx -- heap allocations of zone geometry, with and 
+ * without the arena.
+ *
+ * Replaces the global operator new and delete with counting ones. First
+ * builds the same facades -- an extruded square, its sides subdivided 
+ * into floors and the floors into textured windows -- twice: with the 
+ * Mesh operations, which allocate from the arena of the zone, and with a
+ * copy of the geometry as it was kept before the arena: every Face on 
+ * the heap with it's own index vectors, and subdivisions returned as a
+ * heap IntVector. Both counts are printed side by side.
+ *
+ * Then generates a world in memory with the passed bzwgen options, by 
+ * default -seed 42 -s 3000, and prints the allocations of the generation
+ * -- the parsing of the rules isn't counted. The tree before the arena 
+ * (commit a3557b0) made 4667662 allocations for the default world, 
+ * counted by linking an operator new like the one below into it. The 
+ * counters aren't atomic, so run with a single thread. Run by "make 
+ * bench", from the directory holding rules/.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <memory>
+#include "BZWGenerator.h"
+#include "Mesh.h"
+#include "Thread.h"
+
+/** Number of facades built by each of the two geometry runs. */
+enum { FACADES = 500 };
+
+/** Set while the allocations are counted. */
+static bool counting = false;
+static unsigned long allocations = 0;
+static unsigned long frees = 0;
+static unsigned long allocated = 0;
+
+static void* allocate( size_t size ) {
+  if ( counting ) {
+    allocations++;
+    allocated += size;
+  }
+  void* result = malloc( size ? size : 1 );
+  if ( result == NULL ) throw std::bad_alloc();
+  return result;
+}
+
+static void release( void* block ) {
+  if ( counting && block != NULL ) frees++;
+  free( block );
+}
+
+void* operator new( size_t size ) throw( std::bad_alloc ) {
+  return allocate( size );
+}
+
+void* operator new[]( size_t size ) throw( std::bad_alloc ) {
+  return allocate( size );
+}
+
+void operator delete( void* block ) throw() {
+  release( block );
+}
+
+void operator delete[]( void* block ) throw() {
+  release( block );
+}
+
+/** Starts counting from zero. */
+static void startCounting( ) {
+  allocations = frees = allocated = 0;
+  counting = true;
+}
+
+/** Face as it was kept before the arena, see HeapMesh. */
+struct HeapFace {
+  int material;
+  bool output;
+  FaceGeometry geometry;
+  IntVector tcd;
+  IntVector vtx;
+  HeapFace( ) : material( 0 ), output( true ) {}
+};
+
+/**
+ * The allocations of a Mesh before the arena: faces are allocated one by
+ * one and freed with the mesh, subdivisions return a heap IntVector that
+ * the caller deletes. Only the index bookkeeping is kept, the vertices 
+ * the operations compute don't matter for the allocations.
+ */
+struct HeapMesh {
+  std::vector< HeapFace* > f;
+  VertexVector v;
+  TexCoordVector tc;
+  ~HeapMesh( ) {
+    for ( size_t i = 0; i < f.size(); i++ ) delete f[i];
+  }
+  int addVertex( const Vertex& vertex ) {
+    v.push_back( vertex );
+    return int( v.size() ) - 1;
+  }
+  int addFace( HeapFace* face ) {
+    f.push_back( face );
+    return int( f.size() ) - 1;
+  }
+  int addTexCoord( const TexCoord& texCoord ) {
+    for ( size_t i = 0; i < tc.size(); i++ )
+      if ( tc[i].equals( texCoord ) ) return int( i );
+    tc.push_back( texCoord );
+    return int( tc.size() ) - 1;
+  }
+  int createNGon( int n ) {
+    HeapFace* face = new HeapFace();
+    for ( int i = 0; i < n; i++ ) face->vtx.push_back( addVertex( Vertex() ) );
+    return addFace( face );
+  }
+  void extrudeFace( int faceID, IntVector* result ) {
+    IntVector base = f[faceID]->vtx;
+    IntVector top;
+    int size = int( base.size() );
+    for ( int i = 0; i < size; i++ ) top.push_back( addVertex( v[base[i]] ) );
+    f[faceID]->vtx = top;
+    for ( int i = 0; i < size; i++ ) {
+      HeapFace* face = new HeapFace();
+      face->vtx.push_back( base[i] );
+      face->vtx.push_back( base[( i + 1 ) % size] );
+      face->vtx.push_back( top[( i + 1 ) % size] );
+      face->vtx.push_back( top[i] );
+      result->push_back( addFace( face ) );
+    }
+  }
+  IntVector* repeatSubdivdeFace( int faceID, int count ) {
+    IntVector* result = new IntVector();
+    int a = f[faceID]->vtx[0], b = f[faceID]->vtx[1];
+    for ( int i = 0; i < count - 1; i++ ) {
+      int na = addVertex( v[a] ), nb = addVertex( v[b] );
+      HeapFace* face = new HeapFace();
+      face->vtx.push_back( a );
+      face->vtx.push_back( b );
+      face->vtx.push_back( nb );
+      face->vtx.push_back( na );
+      result->push_back( addFace( face ) );
+      a = na;
+      b = nb;
+    }
+    result->push_back( faceID );
+    IntVector& vtx = f[faceID]->vtx;
+    int c = vtx[2], d = vtx[3];
+    vtx.clear();
+    vtx.push_back( a );
+    vtx.push_back( b );
+    vtx.push_back( c );
+    vtx.push_back( d );
+    return result;
+  }
+  void textureFaceQuad( int faceID ) {
+    IntVector& tcd = f[faceID]->tcd;
+    tcd.clear();
+    tcd.push_back( addTexCoord( TexCoord( 0.0, 0.0 ) ) );
+    tcd.push_back( addTexCoord( TexCoord( 1.0, 0.0 ) ) );
+    tcd.push_back( addTexCoord( TexCoord( 1.0, 1.0 ) ) );
+    tcd.push_back( addTexCoord( TexCoord( 0.0, 1.0 ) ) );
+  }
+};
+
+/** Shape of the facade the Mesh operations made, replayed by HeapMesh. */
+struct FacadeShape {
+  int sides;
+  int floors;
+  int windows;
+  int faces;
+};
+
+/** Builds a facade in the arena of it's zone, like a BuildZone does. */
+static void arenaFacade( FacadeShape& shape ) {
+  Arena arena;
+  Mesh* mesh = new ( arena ) Mesh( arena );
+  int base = mesh->createNGon( Vertex( 0, 0, 0 ), 20.0, 4 );
+  IndexVector sides( arena );
+  mesh->extrudeFace( base, 40.0, 0, &sides );
+  for ( size_t i = 0; i < sides.size(); i++ ) {
+    IndexVector floors( arena );
+    mesh->repeatSubdivdeFace( sides[i], 4.0, false, &floors );
+    for ( size_t j = 0; j < floors.size(); j++ ) {
+      IndexVector windows( arena );
+      mesh->repeatSubdivdeFace( floors[j], 2.5, true, &windows );
+      for ( size_t k = 0; k < windows.size(); k++ )
+	mesh->textureFaceQuad( windows[k], 0.0, 0.0, 1.0, 1.0 );
+      shape.windows = int( windows.size() );
+    }
+    shape.floors = int( floors.size() );
+  }
+  shape.sides = int( sides.size() );
+  shape.faces = mesh->faceCount();
+}
+
+/** Builds the same facade the way it was built before the arena. */
+static void heapFacade( const FacadeShape& shape ) {
+  HeapMesh* mesh = new HeapMesh();
+  int base = mesh->createNGon( shape.sides );
+  IntVector sides;
+  mesh->extrudeFace( base, &sides );
+  for ( size_t i = 0; i < sides.size(); i++ ) {
+    std::auto_ptr< IntVector > floors( mesh->repeatSubdivdeFace( sides[i], shape.floors ) );
+    for ( size_t j = 0; j < floors->size(); j++ ) {
+      std::auto_ptr< IntVector > windows( mesh->repeatSubdivdeFace( floors->at( j ), shape.windows ) );
+      for ( size_t k = 0; k < windows->size(); k++ ) mesh->textureFaceQuad( windows->at( k ) );
+    }
+  }
+  delete mesh;
+}
+
+/** Prints the counts since startCounting(). */
+static void report( const char* name ) {
+  printf( "%-10s operator new %8lu calls, %10lu bytes, operator delete %8lu calls\n", name, allocations, allocated, frees );
+}
+
+/** Takes the options from the command line, like the standalone one. */
+class CountedGenerator : public BZWGenerator {
+public:
+  void parseCommandLine( int argc, char* argv[] ) {
+    cmd.SetDelimnator( argumentDeliminator );
+    cmd.Set( argc, argv );
+  }
+};
+
+int main( int argc, char* argv[] ) {
+  char* defaults[] = { argv[0], (char*)"-seed", (char*)"42", (char*)"-s", (char*)"3000", (char*)"-d", (char*)"0" };
+  CountedGenerator generator;
+  if ( argc > 1 )
+    generator.parseCommandLine( argc, argv );
+  else
+    generator.parseCommandLine( sizeof( defaults ) / sizeof( defaults[0] ), defaults );
+  if ( generator.setup() ) return 1;
+
+  FacadeShape shape;
+  startCounting();
+  for ( int i = 0; i < FACADES; i++ ) arenaFacade( shape );
+  counting = false;
+  printf( "%d facades of %d faces, %d sides of %d floors of %d windows\n", int( FACADES ), shape.faces, shape.sides, shape.floors, shape.windows );
+  report( "arena" );
+  startCounting();
+  for ( int i = 0; i < FACADES; i++ ) heapFacade( shape );
+  counting = false;
+  report( "heap" );
+
+  double start = monotonicTime();
+  startCounting();
+  size_t size;
+  int copies;
+  char* world = generator.generate( size, copies );
+  counting = false;
+  double seconds = monotonicTime() - start;
+  delete[] world;
+
+  printf( "generated a world of %lu bytes in %.2f s\n", (unsigned long)size, seconds );
+  report( "generation" );
+  return 0;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
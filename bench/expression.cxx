@@ -0,0 +1,109 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * expression.cxx -- evaluations per second of expression trees and
+ * their compiled programs.
+ *
+ * Evaluates a condition on face attributes, arithmetic on ruleset
+ * attributes and a constant expression, each through the virtual
+ * Expression::calculate() of the tree and through the program
+ * ExpressionProgram::compileTree() makes of it. Pass "wide" to make the
+ * condition short-circuit. Run by "make bench".
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "Expression.h"
+#include "ExpressionProgram.h"
+#include "ExecutionContext.h"
+#include "RuleSet.h"
+#include "Mesh.h"
+#include "Thread.h"
+
+/** Number of evaluations timed per expression. */
+enum { EVALUATIONS = 2000000 };
+
+static Expression* face( Arena& arena, ExpressionFaceAttribute::Attribute attr ) {
+  return new ( arena ) ExpressionFaceAttribute( attr );
+}
+
+/** 1.5 > face(h)/face(v) & 1.5 > face(v)/face(h) */
+static Expression* condition( Arena& arena, RuleSet* ) {
+  return new ( arena ) ExpressionAnd(
+    new ( arena ) ExpressionGreater( new ( arena ) ExpressionConst( 1.5 ),
+      new ( arena ) ExpressionDiv( face( arena, ExpressionFaceAttribute::FACE_H ), face( arena, ExpressionFaceAttribute::FACE_V ) ) ),
+    new ( arena ) ExpressionGreater( new ( arena ) ExpressionConst( 1.5 ),
+      new ( arena ) ExpressionDiv( face( arena, ExpressionFaceAttribute::FACE_V ), face( arena, ExpressionFaceAttribute::FACE_H ) ) ) );
+}
+
+/** $A * 2 + neg( $B - 0.5 ) */
+static Expression* arithmetic( Arena& arena, RuleSet* ruleset ) {
+  return new ( arena ) ExpressionAdd(
+    new ( arena ) ExpressionMult( new ( arena ) ExpressionAttribute( ruleset, "A" ), new ( arena ) ExpressionConst( 2.0 ) ),
+    new ( arena ) ExpressionNeg( new ( arena ) ExpressionSub( new ( arena ) ExpressionAttribute( ruleset, "B" ), new ( arena ) ExpressionConst( 0.5 ) ) ) );
+}
+
+/** x * 0.5 + neg( i ) six times over, from 1 -- folds into a constant */
+static Expression* constants( Arena& arena, RuleSet* ) {
+  Expression* result = new ( arena ) ExpressionConst( 1.0 );
+  for ( int i = 0; i < 6; i++ )
+    result = new ( arena ) ExpressionAdd( new ( arena ) ExpressionMult( result, new ( arena ) ExpressionConst( 0.5 ) ),
+					  new ( arena ) ExpressionNeg( new ( arena ) ExpressionConst( i ) ) );
+  return result;
+}
+
+/** Evaluates the expression, returns the sum and sets the seconds taken. */
+static double run( Expression* expression, ExecutionContext& context, Mesh* mesh, int face, double& seconds ) {
+  double start = monotonicTime();
+  double sum = 0.0;
+  for ( int i = 0; i < EVALUATIONS; i++ ) sum += expression->calculate( context, mesh, face );
+  seconds = monotonicTime() - start;
+  return sum;
+}
+
+int main( int argc, char* argv[] ) {
+  RuleSet ruleset;
+  ruleset.addAttr( "A", 1.0 );
+  ruleset.addAttr( "B", 2.0 );
+  ExecutionContext context( ruleset.getAttributes() );
+
+  // a square wall, or a wide one on which the condition short-circuits
+  double width = argc > 1 && strcmp( argv[1], "wide" ) == 0 ? 30.0 : 10.0;
+  Arena arena;
+  Mesh* mesh = new ( arena ) Mesh( arena );
+  int id = mesh->addFace();
+  mesh->getFace( id ).addVertex( mesh->addVertex( Vertex( 0, 0, 0 ) ) );
+  mesh->getFace( id ).addVertex( mesh->addVertex( Vertex( width, 0, 0 ) ) );
+  mesh->getFace( id ).addVertex( mesh->addVertex( Vertex( width, 0, 10 ) ) );
+  mesh->getFace( id ).addVertex( mesh->addVertex( Vertex( 0, 0, 10 ) ) );
+
+  Expression* (*build[])( Arena&, RuleSet* ) = { condition, arithmetic, constants };
+  const char* names[] = { "condition", "arithmetic", "constants" };
+  for ( int i = 0; i < 3; i++ ) {
+    Expression* tree = build[i]( arena, &ruleset );
+    Expression* program = ExpressionProgram::compileTree( arena, build[i]( arena, &ruleset ) );
+    double treeTime, programTime;
+    double treeSum = run( tree, context, mesh, id, treeTime );
+    double programSum = run( program, context, mesh, id, programTime );
+    printf( "%-10s  tree %7.2f M/s  bytecode %7.2f M/s  x%.2f%s\n", names[i],
+	    EVALUATIONS / treeTime / 1e6, EVALUATIONS / programTime / 1e6, treeTime / programTime,
+	    treeSum == programSum ? "" : "  results differ!" );
+  }
+  return 0;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -0,0 +1,85 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * output.cxx -- MB/s of vertex lines written by Output and by ostream.
+ *
+ * Writes the same vertices, city sized coordinates with a fraction, as
+ * vertex lines once with operator<< of an ostream -- how Output wrote
+ * them before it formatted numbers itself -- and once with
+ * Output::vertex(). Both go to a stream that discards the text, so only
+ * the formatting is timed. Run by "make bench".
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <streambuf>
+#include <ostream>
+#include "Output.h"
+#include "Thread.h"
+
+/** Number of vertex lines written. */
+enum { VERTICES = 1000000 };
+
+/** Stream buffer counting and discarding everything written to it. */
+class NullBuffer : public std::streambuf {
+public:
+  NullBuffer( ) : written( 0 ) {}
+  size_t written;
+protected:
+  int overflow( int c ) {
+    written++;
+    return c == EOF ? 0 : c;
+  }
+  std::streamsize xsputn( const char*, std::streamsize count ) {
+    written += size_t( count );
+    return count;
+  }
+};
+
+static void report( const char* name, size_t bytes, double seconds ) {
+  printf( "%-8s %6.1f MB in %.2f s, %6.1f MB/s\n", name, bytes / 1e6, seconds, bytes / 1e6 / seconds );
+}
+
+int main( ) {
+  std::vector< Vertex > vertices;
+  srand( 3 );
+  for ( int i = 0; i < VERTICES; i++ )
+    vertices.push_back( Vertex( rand() % 3000 + rand() / double( RAND_MAX ),
+				rand() % 3000 + rand() / double( RAND_MAX ),
+				rand() % 100 * 0.25 ) );
+
+  NullBuffer streamBuffer;
+  std::ostream stream( &streamBuffer );
+  double start = monotonicTime();
+  for ( int i = 0; i < VERTICES; i++ )
+    stream << "  vertex " << vertices[i].x << " " << vertices[i].y << " " << vertices[i].z << "\n";
+  stream.flush();
+  report( "ostream", streamBuffer.written, monotonicTime() - start );
+
+  NullBuffer outputBuffer;
+  std::ostream sink( &outputBuffer );
+  start = monotonicTime();
+  {
+    Output output( &sink, "" );
+    for ( int i = 0; i < VERTICES; i++ ) output.vertex( vertices[i] );
+  }
+  sink.flush();
+  report( "Output", outputBuffer.written, monotonicTime() - start );
+  return 0;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
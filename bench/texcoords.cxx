@@ -0,0 +1,123 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * texcoords.cxx -- Mesh::addTexCoord against a scan of the texcoords.
+ *
+ * Adds the texcoords of a facade -- four walls of windows, each textured
+ * like texturequad(face(x)/16, face(z)/16, ...) does, so that neighbours
+ * share their corners -- to a mesh, and the same texcoords to a plain
+ * array searched from the start, which is how addTexCoord deduplicated
+ * them before it hashed them. Reports the time of both, and whether the
+ * IDs differ. The number of floors may be passed, 30 by default. Before
+ * that the IDs of NaN, infinite and far away texcoords are checked the
+ * same way, untimed. Run by "make bench".
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <limits>
+#include "Mesh.h"
+#include "Thread.h"
+
+/** Windows along a wall, and their size and spacing in world units. */
+enum { WINDOWS = 40 };
+static const double WINDOW_WIDTH = 2.0;
+static const double WINDOW_HEIGHT = 2.5;
+static const double WINDOW_SPACING = 0.5;
+static const double FLOOR_HEIGHT = 4.0;
+
+/** Returns the ID of the texcoord, searching every texcoord added so far. */
+static int scan( TexCoordVector& texcoords, const TexCoord& texcoord ) {
+  for ( size_t i = 0; i < texcoords.size(); i++ )
+    if ( texcoords[i].equals( texcoord ) ) return int( i );
+  texcoords.push_back( texcoord );
+  return int( texcoords.size() ) - 1;
+}
+
+/** Returns the number of IDs the mesh and the scan disagree on. */
+static int compare( const TexCoordVector& added ) {
+  Arena arena;
+  Mesh* mesh = new ( arena ) Mesh( arena );
+  TexCoordVector texcoords;
+  int differ = 0;
+  for ( size_t i = 0; i < added.size(); i++ )
+    if ( mesh->addTexCoord( added[i] ) != scan( texcoords, added[i] ) ) differ++;
+  return differ;
+}
+
+int main( int argc, char* argv[] ) {
+  int floors = argc > 1 ? atoi( argv[1] ) : 30;
+
+  // NaN, infinities, and values around the largest hash cell and the
+  // int range of the cells, each also nudged within EPSILON and repeated
+  double nan = std::numeric_limits< double >::quiet_NaN();
+  double inf = std::numeric_limits< double >::infinity();
+  double odd[] = { nan, inf, -inf, 1e300, -1e300, 4.29e6, -4.29e6, 2147483647.0 * 2 * EPSILON,
+		   1073741823.0 * 2 * EPSILON, -1073741824.0 * 2 * EPSILON, 1e9, -1e9, 0.0, 0.5 };
+  int oddCount = int( sizeof( odd ) / sizeof( odd[0] ) );
+  TexCoordVector extremes;
+  for ( int repeat = 0; repeat < 2; repeat++ )
+    for ( int i = 0; i < oddCount; i++ )
+      for ( int j = 0; j < oddCount; j++ ) {
+	extremes.push_back( TexCoord( odd[i], odd[j] ) );
+	extremes.push_back( TexCoord( odd[i] + EPSILON / 2, odd[j] - EPSILON / 2 ) );
+      }
+  int oddDiffer = compare( extremes );
+  printf( "%d extreme texcoords added, %d IDs differ\n", int( extremes.size() ), oddDiffer );
+
+  // the corners of every window, in the order textureFaceQuad adds them
+  TexCoordVector quads;
+  for ( int wall = 0; wall < 4; wall++ )
+    for ( int floor = 0; floor < floors; floor++ )
+      for ( int window = 0; window < WINDOWS; window++ ) {
+	double x = ( wall * WINDOWS + window ) * ( WINDOW_WIDTH + WINDOW_SPACING );
+	double z = floor * FLOOR_HEIGHT;
+	double au = x / 16.0, av = z / 16.0;
+	double bu = ( x + WINDOW_WIDTH ) / 16.0, bv = ( z + WINDOW_HEIGHT ) / 16.0;
+	quads.push_back( TexCoord( au, av ) );
+	quads.push_back( TexCoord( bu, av ) );
+	quads.push_back( TexCoord( bu, bv ) );
+	quads.push_back( TexCoord( au, bv ) );
+	// the wall between two floors, sharing the corners of the windows
+	quads.push_back( TexCoord( au, bv ) );
+	quads.push_back( TexCoord( bu, bv ) );
+	quads.push_back( TexCoord( bu, ( z + FLOOR_HEIGHT ) / 16.0 ) );
+	quads.push_back( TexCoord( au, ( z + FLOOR_HEIGHT ) / 16.0 ) );
+      }
+
+  Arena arena;
+  Mesh* mesh = new ( arena ) Mesh( arena );
+  std::vector< int > hashed( quads.size() );
+  double start = monotonicTime();
+  for ( size_t i = 0; i < quads.size(); i++ ) hashed[i] = mesh->addTexCoord( quads[i] );
+  double hashTime = monotonicTime() - start;
+
+  TexCoordVector texcoords;
+  int differ = 0;
+  start = monotonicTime();
+  for ( size_t i = 0; i < quads.size(); i++ )
+    if ( scan( texcoords, quads[i] ) != hashed[i] ) differ++;
+  double scanTime = monotonicTime() - start;
+
+  printf( "%d floors, %d texcoords added, %d distinct\n", floors, int( quads.size() ), int( texcoords.size() ) );
+  printf( "scan %.3f s  hash %.3f s  x%.1f\n", scanTime, hashTime, scanTime / hashTime );
+  if ( differ > 0 ) printf( "%d IDs differ!\n", differ );
+  return differ > 0 || oddDiffer > 0 ? 1 : 0;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -0,0 +1,284 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file Arena.h
+ * @brief Bump allocator for objects that are freed all at once.
+ */
+
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stddef.h>
+#include <new>
+#include "globals.h"
+
+/** Size of the first chunk, every next one doubles up to ARENA_CHUNK_SIZE. */
+#define ARENA_FIRST_CHUNK_SIZE 4096
+/** Size of the chunks a large arena allocates from. */
+#define ARENA_CHUNK_SIZE 65536
+/** Largest block release() keeps for reuse. */
+#define ARENA_MAX_REUSE 1024
+
+/**
+ * @class Arena
+ * @brief Allocates objects from large chunks, and frees them all at once.
+ *
+ * Every object of a parsed grammar -- rules, products, operations,
+ * expressions and their arrays -- lives in the arena of it's RuleSet,
+ * and the geometry of a zone -- meshes, faces and their index lists --
+ * lives in the arena of the zone. Allocating is bumping a pointer, 
+ * objects created together lie next to each other in memory, and nothing
+ * is freed one by one: the chunks go away with the arena. Objects are 
+ * allocated with the placement form new ( arena ) T( ... ) and are never
+ * deleted, containers use an ArenaAllocator.
+ *
+ * The arena doesn't run destructors, so objects allocated from it should
+ * hold nothing that needs one -- strings and arrays are copied into the
+ * arena as well. Objects that do need their destructor are registered 
+ * with own(), and destroyed in reverse order before the chunks are freed.
+ *
+ * Blocks may be given back with release(), those up to ARENA_MAX_REUSE 
+ * bytes are handed out again by allocate() for the same size, larger ones
+ * are kept aside and bumped from like a chunk once the current one runs 
+ * out. That keeps growing containers -- whose old buffers are released --
+ * from doubling the memory of a zone.
+ *
+ * An arena is not thread safe, parsers running concurrently each fill 
+ * their own, and merge() them into the ruleset's one.
+ */
+class Arena {
+  /** Destructor registered by own(). */
+  struct Finalizer {
+    void (*destroy)( void* );
+    void* object;
+  };
+  /** The allocated chunks, the last one is allocated from. */
+  std::vector< char* > chunks;
+  /** Next free byte of the last chunk. */
+  char* next;
+  /** Bytes left in the last chunk. */
+  size_t left;
+  /** Bytes handed out, including padding. */
+  size_t used;
+  /** Objects whose destructor has to be run. */
+  std::vector< Finalizer > finalizers;
+  /**
+   * Released blocks, a list per size in ALIGNMENT steps, linked through
+   * their first word. Allocated from the arena by the first release().
+   */
+  void** reuse;
+  /**
+   * Released blocks larger than ARENA_MAX_REUSE, linked through their 
+   * first word, their size in the second. Taken by grow() before a new
+   * chunk is allocated.
+   */
+  void* spare;
+public:
+  /** Constructor, allocates nothing until the first object. */
+  Arena( ) : next( NULL ), left( 0 ), used( 0 ), reuse( NULL ), spare( NULL ) {}
+  /**
+   * Returns size bytes of uninitialized memory, aligned for any of the 
+   * types the grammar holds.
+   */
+  void* allocate( size_t size ) {
+    size = ( size + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 );
+    if ( reuse != NULL && size <= ARENA_MAX_REUSE && reuse[size / ALIGNMENT] != NULL ) {
+      void* block = reuse[size / ALIGNMENT];
+      reuse[size / ALIGNMENT] = *(void**)block;
+      return block;
+    }
+    if ( size > left ) grow( size );
+    void* result = next;
+    next += size;
+    left -= size;
+    used += size;
+    return result;
+  }
+  /**
+   * Copies the elements of the vector into a contiguous array in the 
+   * arena. Returns NULL for an empty vector. Only for types that don't 
+   * need a destructor.
+   */
+  template< class T >
+  T* copy( const std::vector< T >& items ) {
+    if ( items.empty() ) return NULL;
+    T* result = (T*)allocate( sizeof( T ) * items.size() );
+    for ( size_t i = 0; i < items.size(); i++ )
+      new ( result + i ) T( items[i] );
+    return result;
+  }
+  /**
+   * Gives back a block of the passed size returned by allocate(). Small
+   * blocks are reused for the same size, larger ones are bumped from once
+   * the current chunk runs out.
+   */
+  void release( void* block, size_t size ) {
+    size = ( size + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 );
+    if ( size == 0 ) return;
+    if ( size > ARENA_MAX_REUSE ) {
+      ((void**)block)[0] = spare;
+      ((size_t*)block)[1] = size;
+      spare = block;
+      return;
+    }
+    if ( reuse == NULL ) startReuse();
+    *(void**)block = reuse[size / ALIGNMENT];
+    reuse[size / ALIGNMENT] = block;
+  }
+  /** Copies the string into the arena, and returns the copy. */
+  const char* copy( const String& text );
+  /**
+   * Registers an object allocated from the arena that needs it's 
+   * destructor, and returns it.
+   */
+  template< class T >
+  T* own( T* object ) {
+    Finalizer finalizer;
+    finalizer.destroy = &destroy< T >;
+    finalizer.object = object;
+    finalizers.push_back( finalizer );
+    return object;
+  }
+  /**
+   * Takes over the chunks and the registered objects of the other arena,
+   * which is left empty. It's released blocks are dropped, not reused.
+   */
+  void merge( Arena& other );
+  /** Returns the number of bytes handed out, reused blocks not counted. */
+  size_t size( ) const {
+    return used;
+  }
+  /** Returns the number of chunks allocated. */
+  int chunkCount( ) const {
+    return int( chunks.size() );
+  }
+  /**
+   * Destroys the registered objects and frees the chunks, leaving the
+   * arena empty and ready for reuse. Nothing allocated from it may be
+   * used afterwards.
+   */
+  void clear( );
+  /** Destructor, destroys the registered objects and frees the chunks. */
+  ~Arena( ) {
+    clear( );
+  }
+private:
+  /** Alignment of every allocation, enough for doubles and pointers. */
+  enum { ALIGNMENT = 8 };
+  /** 
+   * Continues in the first spare block that fits at least size bytes, or 
+   * starts a new chunk.
+   */
+  void grow( size_t size );
+  /** Allocates the empty reuse lists. */
+  void startReuse( );
+  /** Runs the destructor of an object registered by own(). */
+  template< class T >
+  static void destroy( void* object ) {
+    static_cast< T* >( object )->~T();
+  }
+  /** Blocked copy constructor. */
+  Arena( const Arena& );
+};
+
+/** Allocates an object from the arena, see Arena. */
+inline void* operator new( size_t size, Arena& arena ) {
+  return arena.allocate( size );
+}
+
+/** Called only if a constructor throws, the memory stays in the arena. */
+inline void operator delete( void*, Arena& ) {
+}
+
+/**
+ * @class ArenaAllocator
+ * @brief Standard allocator handing out memory of an Arena.
+ *
+ * Lets the standard containers keep their elements in an arena. Freed
+ * blocks are reused by the arena, but never returned to the system before
+ * the arena goes away, so it's meant for containers that live about as 
+ * long as the arena does. The elements still need to be destroyed by the
+ * container, but a container of types without destructors may itself be
+ * allocated from the arena and never be destroyed.
+ */
+template< class T >
+class ArenaAllocator {
+  /** The arena the memory comes from. */
+  Arena* arena;
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  /** Allocator of another type using the same arena. */
+  template< class U >
+  struct rebind {
+    typedef ArenaAllocator< U > other;
+  };
+  /** Constructor, allocates from the passed arena. */
+  ArenaAllocator( Arena& _arena ) : arena( &_arena ) {}
+  /** Converts an allocator of another type, see rebind. */
+  template< class U >
+  ArenaAllocator( const ArenaAllocator< U >& other ) : arena( other.getArena() ) {}
+  /** Returns the arena the memory comes from. */
+  Arena* getArena( ) const {
+    return arena;
+  }
+  pointer address( reference x ) const {
+    return &x;
+  }
+  const_pointer address( const_reference x ) const {
+    return &x;
+  }
+  /** Allocates room for n objects from the arena. */
+  pointer allocate( size_type n, const void* = 0 ) {
+    return (pointer)arena->allocate( n * sizeof( T ) );
+  }
+  /** Releases the block to the arena, see Arena::release. */
+  void deallocate( pointer p, size_type n ) {
+    arena->release( p, n * sizeof( T ) );
+  }
+  size_type max_size( ) const {
+    return size_type( -1 ) / sizeof( T );
+  }
+  void construct( pointer p, const T& value ) {
+    new ( (void*)p ) T( value );
+  }
+  void destroy( pointer p ) {
+    p->~T();
+  }
+};
+
+/** Allocators are equal if they allocate from the same arena. */
+template< class T, class U >
+inline bool operator==( const ArenaAllocator< T >& a, const ArenaAllocator< U >& b ) {
+  return a.getArena() == b.getArena();
+}
+
+/** @copydoc operator== */
+template< class T, class U >
+inline bool operator!=( const ArenaAllocator< T >& a, const ArenaAllocator< U >& b ) {
+  return a.getArena() != b.getArena();
+}
+
+#endif /* __ARENA_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -0,0 +1,138 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file AsyncWriter.h
+ * @brief Writes a file on a thread of it's own.
+ */
+
+#ifndef __ASYNCWRITER_H__
+#define __ASYNCWRITER_H__
+
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include "globals.h"
+#include "Thread.h"
+
+/**
+ * @class AsyncWriter
+ * @brief Writes buffers to a file on a background thread.
+ *
+ * The producer -- an Output -- takes an empty buffer with acquire(), fills
+ * it and hands it back with submit(). The writer thread writes the
+ * submitted buffers in order, each with a single large write, and puts
+ * them back on the free list, so generating and writing the world
+ * overlap. At most maxBuffers buffers exist; acquire() blocks while all of
+ * them are queued or being written, so a slow disk holds the producer
+ * back instead of letting the queue grow. Buffers are handed over, never
+ * copied.
+ */
+class AsyncWriter {
+  /** Writer thread, runs AsyncWriter::work. */
+  class Worker : public Thread {
+    AsyncWriter* writer;
+  public:
+    Worker( AsyncWriter* _writer ) : writer( _writer ) {}
+    void run( ) {
+      writer->work();
+    }
+  };
+  /** A submitted buffer and the number of bytes to write. */
+  struct Block {
+    char* data;
+    size_t size;
+  };
+  /** The open file, NULL if none. */
+  FILE* file;
+  /** Set if the file is synced to the disk by close(). */
+  bool sync;
+  /** Size of the buffers. */
+  size_t bufferSize;
+  /** Maximum number of buffers, and the number allocated. */
+  int maxBuffers;
+  int allocated;
+  /** Guards the fields below. */
+  Mutex mutex;
+  /** Broadcasted when a buffer is submitted or written, and on close(). */
+  Condition changed;
+  /** Submitted buffers, not yet written. */
+  std::deque< Block > queue;
+  /** Written buffers, ready to be acquired. */
+  std::vector< char* > freeBuffers;
+  /** Set by close(), the thread stops once the queue is empty. */
+  bool closing;
+  /** Set if a write failed, the rest of the buffers are dropped. */
+  bool failed;
+  /** Number of times acquire() had to wait for a buffer to be written. */
+  int stalls;
+  /** Number of writes, and the bytes written. */
+  int writes;
+  size_t written;
+  /** The writer thread. */
+  Worker worker;
+  friend class Worker;
+public:
+  /** Default size of the buffers. */
+  static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+  /** Default maximum number of buffers. */
+  static const int DEFAULT_BUFFERS = 4;
+  /** 
+   * Constructor, takes the size of the buffers and the maximum number of
+   * buffers in flight, at least two.
+   */
+  AsyncWriter( size_t _bufferSize = DEFAULT_BUFFER_SIZE, int _maxBuffers = DEFAULT_BUFFERS );
+  /**
+   * Creates the file and starts the writer thread. If sync is set the file
+   * is synced to the disk by close(). Returns false if the file couldn't 
+   * be created or the thread couldn't be started.
+   */
+  bool open( const String& filename, bool _sync = false );
+  /** Returns the size of the buffers. */
+  size_t getBufferSize( ) const {
+    return bufferSize;
+  }
+  /** 
+   * Returns an empty buffer of getBufferSize() bytes. Blocks while all 
+   * buffers are in flight.
+   */
+  char* acquire( );
+  /**
+   * Queues the first size bytes of a buffer returned by acquire() to be
+   * written. The buffer belongs to the writer again, size may be 0.
+   */
+  void submit( char* data, size_t size );
+  /**
+   * Waits until all submitted buffers are written, syncs the file if 
+   * requested and closes it. Returns false if any write failed. Does 
+   * nothing if the file isn't open.
+   */
+  bool close( );
+  /** Destructor, closes the file and frees the buffers. */
+  ~AsyncWriter( );
+private:
+  /** Writer thread loop. */
+  void work( );
+  /** Blocked copy constructor. */
+  AsyncWriter( const AsyncWriter& );
+  /** Blocked assignment operator. */
+  AsyncWriter& operator=( const AsyncWriter& );
+};
+
+#endif /* __ASYNCWRITER_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
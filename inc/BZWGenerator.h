@@ -21,6 +21,10 @@
 #include "globals.h"
 #include "RuleSet.h"
 #include "commandArgs.h"
+#include "Output.h"
+
+/** Name of the grammar image in the rules directory, see GrammarImage. */
+#define GRAMMAR_IMAGE_NAME "rules.bzwc"
 
 /**
  * @class BZWGenerator
@@ -39,18 +43,42 @@ class BZWGenerator
   String texturepath;
   /** Temporary boolean for running FaceGenerator instead of GridGenerator */
   bool experimental;
+  /** Rule profiler, NULL unless -profilerules was passed. */
+  RuleProfiler* profiler;
+  /** Name of the profile report file. */
+  String profilename;
+  /** Name of the trace file, the tracer is enabled if -trace was passed. */
+  String tracename;
+  /** Decimal places written for coordinates, see Output. */
+  int precision;
+  /** Set if the zones are written as they complete, see Generator::setStream. */
+  bool streaming;
 public:
   /** Standard default constructor, currently does nothing. */
-  BZWGenerator() {}
+  BZWGenerator() : profiler( NULL ), precision( 0 ), streaming( false ), compileRules( false ) {}
   /** Parses the rulesets and config files. */
   int setup();
-  /** Default destructor, does nothing. */
-  ~BZWGenerator() {}
+  /** Default destructor, frees the profiler. */
+  ~BZWGenerator() {
+    deletePointer( profiler );
+  }
   /**
    * Runs the generator with the current settings. Output goes to outstream
    * using BZW format.
    */
   void generate(OutStream* outstream);
+  /**
+   * Runs the generator with the current settings. Output is written by
+   * the writer's thread, while generating.
+   */
+  void generate(AsyncWriter& writer);
+  /**
+   * Runs the generator with the current settings, keeping the world in a
+   * single buffer. Returns the NUL terminated text, to be freed with 
+   * delete[], and sets size to it's length and copies to the number of
+   * times the text was copied while the buffer grew.
+   */
+  char* generate(size_t& size, int& copies);
   /**
    * Loads a config file. Config files are simply sets of parameters that
    * normally would be passed via the command line.
@@ -58,6 +86,11 @@ public:
   void loadConfig( const char* configFile );
   /** Output file name, used only in standalone mode. */
   String outname;
+  /** 
+   * Set if -compilerules was passed, the standalone generator only writes
+   * the grammar image then.
+   */
+  bool compileRules;
 protected:
   /**
    * Class for command line parsing. It is used in both deployments because
@@ -74,6 +107,9 @@ protected:
    * If not defined, returns false.
    */
   bool getOptionS ( String &val, const char* shortName, const char* longName );
+private:
+  /** Runs the generator, writing the world to the passed Output. */
+  void generate(Output& os);
 };
 
 #endif /* __BZWGENERATOR_H__ */
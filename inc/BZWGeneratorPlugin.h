@@ -20,6 +20,7 @@
 
 #include "globals.h"
 #include "BZWGenerator.h"
+#include "Thread.h"
 
 // If compiling as a plugin we need the BZFS API.
 #include "bzfsAPI.h"
@@ -31,23 +32,59 @@
  *
  * Extension of the BZWGenerator class for Plugin compilation. Hence implements 
  * bz_eventHandler. 
+ *
+ * The world is generated on a thread of it's own, started by bz_Load right
+ * after setup(), into a single buffer the plugin owns. bz_eGetWorldEvent
+ * only waits for the thread if it's still running, and hands the buffer
+ * to the server as it is.
  */
 class BZWGeneratorPlugin : public BZWGenerator, public bz_EventHandler 
 {
-  char* cstr;
+  /** Thread generating the world, runs BZWGeneratorPlugin::generateWorld. */
+  class Generation : public Thread {
+    BZWGeneratorPlugin* plugin;
+  public:
+    Generation( BZWGeneratorPlugin* _plugin ) : plugin( _plugin ) {}
+    void run( ) {
+      plugin->generateWorld();
+    }
+  };
+  /** The generated world, NUL terminated, NULL until it's generated. */
+  char* world;
+  /** Length of the world text. */
+  size_t worldSize;
+  /** Number of times the world text was copied while generating. */
+  int worldCopies;
+  /** Time the generation was started, and the time it completed. */
+  double startTime;
+  double readyTime;
+  /** Set if the generation thread was started. */
+  bool started;
   /** 
    * Set to true if the world was generated. To prevent the event handler to 
    * regenerate the world. Used only in plugin mode. 
    */
   bool worldGenerated;
+  /** The generation thread. */
+  Generation generation;
+  friend class Generation;
 public:
   /** Standard default constructor, currently does nothing. */
-  BZWGeneratorPlugin() : BZWGenerator(), worldGenerated(false), cstr(0) { }
+  BZWGeneratorPlugin() : BZWGenerator(), world(NULL), worldSize(0), worldCopies(0), 
+    startTime(0.0), readyTime(0.0), started(false), worldGenerated(false), generation(this) { }
+  /**
+   * Starts generating the world in the background. If the thread can't be
+   * started, the world is generated by the first bz_eGetWorldEvent.
+   */
+  void start();
   /** 
    * Event handler for the plugin mode. Processes bz_eGetWorldEvent 
    * and bz_eWorldFinalized. 
    */
   virtual void process(bz_EventData * eventData);
+private:
+  /** Generates the world into the world buffer. */
+  void generateWorld();
 };
 
 #endif /* __BZWGENERATORPLUGIN_H__ */
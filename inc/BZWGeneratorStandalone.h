@@ -31,7 +31,7 @@ class BZWGeneratorStandalone : public BZWGenerator
 {
 public:
   /** Standard default constructor, currently does nothing. */
-  BZWGeneratorStandalone() : BZWGenerator() {}
+  BZWGeneratorStandalone() : BZWGenerator(), syncOutput( false ) {}
   /** 
    * Parses the command line for valid switches. Used only in the standalone 
    * compilation of BZWGen.
@@ -41,6 +41,8 @@ public:
   ~BZWGeneratorStandalone() {}
   /** Output file name, used only in standalone mode. */
   String outname;
+  /** Set if the output file is synced to the disk once written. */
+  bool syncOutput;
 private:
   /** Prints the help screen. */
   void printHelp();
@@ -31,18 +31,17 @@
 class BaseZone : public Zone {
 public:
   /**
-   * Constructor, sets all the needed data for generation.
+   * Constructor, sets all the needed data for generation. The color is
+   * assigned by the generator, so that it doesn't depend on the order
+   * in which zones are run.
    */
-  BaseZone( Generator* _generator, graph::Face* _face, bool _ctfSafe ) 
-    : Zone( _generator,_face ), color( 1 ), ctfSafe( _ctfSafe ) {};
+  BaseZone( Generator* _generator, graph::Face* _face, bool _ctfSafe, int _color ) 
+    : Zone( _generator,_face ), color( _color ), ctfSafe( _ctfSafe ) {};
   /**
-   * Runs the Zone generation. As a BZFlag base is a native BZW object, this
-   * method only assigns each base a color.
+   * Runs the Zone generation. As a BZFlag base is a native BZW object, 
+   * there's nothing to generate.
    */
-  virtual void run() {
-    color = colorCount;
-    colorCount++;
-  };
+  virtual void run() {};
   /** 
    * Outputs the zone to the given Output object. Currently
    * assumes that a quad is passed as the face.
@@ -61,12 +60,6 @@ protected:
   int color;
   /** CTF safe flag */
   bool ctfSafe;
-  /** 
-  * A static integer to keep the number of bases generated. Used to
-  * assign each generated base a unique color.
-  */
-  static int colorCount;
-
 };
 
 #endif /* __BASEZONE_H__ */
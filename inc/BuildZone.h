@@ -30,6 +30,12 @@
  * of the generator.
  */
 class BuildZone : public Zone {
+  /**
+   * Arena holding the meshes of the zone, their faces and arrays, and the
+   * temporary face lists of the operations. Only the thread running the
+   * zone allocates from it, and it's freed at once with the zone.
+   */
+  Arena arena;
   /** 
    * Pointer to the vector holding the Mesh es making up this Build zone.
    * Pointer is NULL until run() is called.
@@ -45,10 +51,21 @@ public:
    * Runs the generator, results are stored in the meshes vector. 
    */
   virtual void run( );
+  /**
+   * Returns the area of the lot -- larger lots spawn larger buildings,
+   * and should be scheduled first.
+   */
+  virtual double cost( ) const {
+    return face->area( );
+  }
   /** 
    * Outputs the generated meshes into the passed Output object. 
    */
   virtual void output( Output& out );
+  /**
+   * Frees the meshes and clears the arena.
+   */
+  virtual void release( );
   /** 
    * Destructor, frees the allocated meshes. 
    */
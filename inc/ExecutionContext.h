@@ -0,0 +1,246 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file ExecutionContext.h
+ * @brief Per-derivation state for running the BZWGen grammar.
+ */
+
+#ifndef __EXECUTIONCONTEXT_H__
+#define __EXECUTIONCONTEXT_H__
+
+#include "globals.h"
+#include "Mesh.h"
+#include "Material.h"
+#include "Random.h"
+#include "RuleProfiler.h"
+#include "Tracer.h"
+
+/** Default limit of the rule nesting depth of a derivation. */
+#define DEFAULT_MAX_DEPTH 1000
+
+class Rule;
+class Product;
+class Operation;
+
+/**
+ * @class ExecutionContext
+ * @brief Mutable state of a single grammar derivation.
+ *
+ * The RuleSet only holds the parsed grammar, which is never modified once
+ * initialized and may be shared by any number of derivations. Everything
+ * a derivation changes -- attributes set by assign(), the recursion level,
+ * the produced meshes and the random stream -- lives in the context, so
+ * that zones may be derived concurrently without any locking.
+ *
+ * Attributes are addressed by the dense slots the ruleset assigned to
+ * their names while parsing. The context starts with a copy of the
+ * ruleset's values -- a flat array of doubles -- so reads and writes are
+ * plain array accesses, and assignments never touch the ruleset.
+ *
+ * Rules are derived from an explicit stack of frames held by the context
+ * instead of the C++ call stack. Operations don't run the rules they 
+ * reference, they schedule them with call(), callReturn() or 
+ * callResume(), and derive() runs the scheduled rules before the next
+ * operation of the calling product. A rule called by the last operation
+ * of a product replaces the product's frame, so tail recursive rules 
+ * don't grow the stack. The nesting depth -- tail calls included, so 
+ * that infinite loops are still caught -- is limited per derivation.
+ */
+class ExecutionContext {
+  /** Attribute values, indexed by slot. */
+  DoubleVector attrs;
+  /** Material list loadmaterial() appends to, NULL outside of initialization. */
+  MaterialVector* materials;
+  /** What is done with the result of a called rule. */
+  enum CallMode {
+    CALL_DROP,    /**< the result is ignored */
+    CALL_RETURN,  /**< the result becomes the face of the calling product */
+    CALL_RESUME   /**< the result is passed to Operation::resume of the caller */
+  };
+  /** A rule invocation on the derivation stack. */
+  struct Frame {
+    /** Rule being run. */
+    const Rule* rule;
+    /** Chosen product, NULL until the rule is entered. */
+    const Product* product;
+    /** Operation waiting for the result, CALL_RESUME only. */
+    const Operation* caller;
+    /** One of CallMode. */
+    int mode;
+    /** Mesh the rule runs on. */
+    Mesh* mesh;
+    /** Current face of the product. */
+    int face;
+    /** Index of the next operation of the product. */
+    int next;
+    /** Rule nesting depth. */
+    int depth;
+    /** Stack index of the calling frame, -1 for the first one. */
+    int parent;
+    /** @name Profiling data, only set if a profile or trace is collected */
+    /** Time the rule was entered at. */
+    double start;
+    /** Inclusive time of the rules it called. */
+    double childTime;
+    /** Face and vertex count of the mesh when the rule was entered. */
+    int faces, vertices;
+    /** Faces and vertices added to the mesh by the rules it called. */
+    int childFaces, childVertices;
+  };
+  /** The derivation stack. */
+  std::vector< Frame > stack;
+  /** Rules scheduled by the running operation, in call order. */
+  std::vector< Frame > calls;
+  /** Meshes produced by the derivation, owned by the caller. */
+  MeshVector* meshes;
+  /** Random stream of the derivation. */
+  Random random;
+  /** Profile the derivation is recorded into, NULL if not profiled. */
+  RuleProfile* profile;
+  /** Trace events of the derivation are added to, NULL if not traced. */
+  TraceEventVector* trace;
+  /** Set if either a profile or a trace is collected. */
+  bool instrumented;
+  /** Index of the zone being derived, -1 outside of zones. */
+  int zone;
+public:
+  /**
+   * Constructor, takes the starting attribute values and the seed and 
+   * stream number of the derivation's random stream. Zone N derives with
+   * stream N+1, see Generator.
+   */
+  ExecutionContext( const DoubleVector& _attrs, unsigned int seed = 1, unsigned int stream = 0 )
+    : attrs( _attrs ), materials( NULL ), meshes( NULL ), random( seed, stream ), 
+      profile( NULL ), trace( NULL ), instrumented( false ), zone( int( stream ) - 1 ) {}
+  /** Returns the value of the attribute in the given slot. */
+  double getAttr( int slot ) const {
+    return attrs[slot];
+  }
+  /** Sets the value of the attribute in the given slot. */
+  void setAttr( int slot, double value ) {
+    attrs[slot] = value;
+  }
+  /** Returns the values of all the attributes. */
+  const DoubleVector& getAttributes( ) const {
+    return attrs;
+  }
+  /**
+   * Allows the derivation to load materials into the passed vector. Only
+   * the ruleset initialization is allowed to do that.
+   */
+  void setMaterials( MaterialVector* _materials ) {
+    materials = _materials;
+  }
+  /**
+   * Registers a new material and sets the attribute in the given slot to
+   * it's id. Returns false if materials can't be loaded by this derivation.
+   */
+  bool loadMaterial( int slot, const String& name, bool noradar ) {
+    if ( materials == NULL ) {
+      Logger.log( "ExecutionContext : Warning : material '%s' may only be loaded in the initialize rule!", name.c_str() );
+      return false;
+    }
+    int matid = int( materials->size() );
+    setAttr( slot, double( matid ) );
+    materials->push_back( Material( matid, name, noradar ) );
+    return true;
+  }
+  /** Returns the random stream of the derivation. */
+  Random& getRandom( ) {
+    return random;
+  }
+  /** Returns the vector new meshes are added to. */
+  MeshVector* getMeshes( ) {
+    return meshes;
+  }
+  /** Sets the vector new meshes are added to. */
+  void setMeshes( MeshVector* _meshes ) {
+    meshes = _meshes;
+  }
+  /** Sets the profile the derivation is recorded into, NULL to disable. */
+  void setProfile( RuleProfile* _profile ) {
+    profile = _profile;
+    instrumented = profile != NULL || trace != NULL;
+  }
+  /** Sets the vector the rule spans are added to, NULL to disable. */
+  void setTrace( TraceEventVector* _trace ) {
+    trace = _trace;
+    instrumented = profile != NULL || trace != NULL;
+  }
+  /** Returns the rule nesting depth of the running rule. */
+  int getDepth( ) const {
+    return stack.empty() ? 0 : stack.back().depth;
+  }
+  /**
+   * Runs the rule on the given face, together with all the rules it 
+   * calls, and returns the resulting face or -1 on failure. If the nesting 
+   * depth exceeds maxDepth the derivation is aborted.
+   */
+  int derive( const Rule* rule, Mesh* mesh, int face, int maxDepth );
+  /** Schedules a rule whose result is ignored. */
+  void call( const Rule* rule, Mesh* mesh, int face ) {
+    schedule( rule, mesh, face, NULL, CALL_DROP );
+  }
+  /**
+   * Schedules a rule whose result becomes the face the calling product 
+   * continues with. If -1 is returned, the product fails as well.
+   */
+  void callReturn( const Rule* rule, Mesh* mesh, int face ) {
+    schedule( rule, mesh, face, NULL, CALL_RETURN );
+  }
+  /** 
+   * Schedules a rule whose result is passed to the resume() method of the
+   * caller, which returns the face the calling product continues with.
+   */
+  void callResume( const Rule* rule, Mesh* mesh, int face, const Operation* caller ) {
+    schedule( rule, mesh, face, caller, CALL_RESUME );
+  }
+private:
+  /** Adds a call made by the running operation. */
+  void schedule( const Rule* rule, Mesh* mesh, int face, const Operation* caller, int mode ) {
+    Frame frame;
+    frame.rule = rule;
+    frame.product = NULL;
+    frame.caller = caller;
+    frame.mode = mode;
+    frame.mesh = mesh;
+    frame.face = face;
+    frame.next = 0;
+    frame.depth = 0;
+    frame.parent = -1;
+    calls.push_back( frame );
+  }
+  /** 
+   * Pops the top frame, and hands it's result to the calling frame. 
+   * Returns the result. 
+   */
+  int finish( int result );
+  /** Starts profiling the frame, called when it's rule is entered. */
+  void enterProfile( Frame& frame );
+  /**
+   * Records the profile and the trace span of the frame once it's rule 
+   * is done, and adds it to the calling frame.
+   */
+  void leaveProfile( const Frame& frame, int result );
+  /** Blocked copy constructor, a context belongs to one derivation. */
+  ExecutionContext( const ExecutionContext& );
+};
+
+#endif /* __EXECUTIONCONTEXT_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -17,12 +17,28 @@
 #include "Mesh.h"
 #include "MultiFace.h"
 #include "Random.h"
+#include "ExecutionContext.h"
+#include "GrammarImage.h"
 
+class ExpressionCompiler;
 class RuleSet;
 
+// expressions are allocated from the grammar's Arena and never deleted,
+// so they may not own anything that needs freeing
 class Expression {
 public:
-  virtual double calculate( Mesh*, int ) = 0;
+  virtual double calculate( ExecutionContext&, Mesh*, int ) const = 0;
+  // emits code leaving the value in register reg, registers above reg
+  // may be used as temporaries -- see ExpressionProgram
+  virtual void compile( ExpressionCompiler& compiler, int ) const;
+  // returns true and sets value if the expression always evaluates to it
+  virtual bool isConstant( double& ) const {
+    return false;
+  }
+  // writes the tree into a grammar image -- see GrammarWriter
+  virtual void write( GrammarWriter& out ) const {
+    out.fail();
+  }
   virtual ~Expression() {};
 };
 
@@ -33,18 +49,19 @@ class ExpressionTemplate : public Expression {
 protected:
   typedef Expression* ExpressionPtr;
   ExpressionPtr exp[SIZE];
-  double value[SIZE];
 public:
-  virtual double calc() = 0;
-  double calculate( Mesh* mesh, int face ) {
+  virtual double calc( ExecutionContext& context, const double* value ) const = 0;
+  double calculate( ExecutionContext& context, Mesh* mesh, int face ) const {
+    // values are kept on the stack, as the same expression may be
+    // evaluated by several threads at once
+    double value[SIZE];
     for ( int i = 0; i < SIZE; ++i )
-      if ( exp[i] )
-        value[i] = exp[i]->calculate( mesh, face );
-    return calc();
+      value[i] = exp[i] ? exp[i]->calculate( context, mesh, face ) : 0.0;
+    return calc( context, value );
   }
-  ~ExpressionTemplate() {
+  void writeChildren( GrammarWriter& out ) const {
     for ( int i = 0; i < SIZE; ++i )
-      deletePointer( exp[i] );
+      out.writeExpression( exp[i] );
   }
 };
 
@@ -61,6 +78,8 @@ public:
     exp[0] = exp0;
     exp[1] = exp1;
   };
+protected:
+  void compileBinary( ExpressionCompiler& compiler, int reg, int op ) const;
 };
 
 class ExpressionTriple : public ExpressionTemplate<3> {
@@ -76,52 +95,80 @@ class ExpressionConst : public Expression {
   double value;
 public:
   ExpressionConst( double _value ) : value( _value ) {};
-  double calculate( Mesh*, int ) { return value; };
+  double calculate( ExecutionContext&, Mesh*, int ) const { return value; };
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  bool isConstant( double& _value ) const {
+    _value = value;
+    return true;
+  }
+  void write( GrammarWriter& out ) const {
+    out.writeInt( GrammarWriter::EXP_CONST );
+    out.writeDouble( value );
+  }
 };
 
 class ExpressionAttribute : public Expression {
-  RuleSet* ruleset;
-  String attrname;
+  int slot;
 public:
-  ExpressionAttribute( RuleSet* _ruleset, const char* _attrname )
-    : ruleset( _ruleset ), attrname( _attrname ) {};
-  double calculate( Mesh*, int );
+  ExpressionAttribute( RuleSet* ruleset, const char* attrname );
+  double calculate( ExecutionContext& context, Mesh*, int ) const;
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const {
+    out.writeInt( GrammarWriter::EXP_ATTRIBUTE );
+    out.writeAttr( slot );
+  }
 };
 
 class ExpressionFaceAttribute : public Expression {
-  String attrname;
 public:
-  ExpressionFaceAttribute( const char* _attrname ) : attrname( _attrname ) {
-    std::transform( attrname.begin(), attrname.end(), attrname.begin(), tolower );
-  };
-  double calculate( Mesh* mesh, int face );
+  // face attributes, resolved from their names by the parser
+  enum Attribute { FACE_X, FACE_Y, FACE_Z, FACE_H, FACE_V, FACE_S, FACE_N, FACE_C };
+private:
+  Attribute attr;
+public:
+  ExpressionFaceAttribute( Attribute _attr ) : attr( _attr ) { };
+  double calculate( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const {
+    out.writeInt( GrammarWriter::EXP_FACE );
+    out.writeInt( attr );
+  }
+  static double value( Attribute attr, Mesh* mesh, int face );
+  // returns the attribute of the given name, case insensitive, -1 if unknown
+  static int attributeId( const char* attrname );
 };
 
 class ExpressionRandom : public ExpressionTriple {
 public:
   ExpressionRandom( Expression* min, Expression* max, Expression* step)
     : ExpressionTriple( min, max, step ) { };
-  double calc() {
+  double calc( ExecutionContext& context, const double* value ) const {
     if (fabs( value[2] ) < 0.0001f)
-      return Random::doubleRange( value[0], value[1] );
-    return Random::doubleRangeStep( value[0], value[1], value[2] );
+      return context.getRandom().doubleRange( value[0], value[1] );
+    return context.getRandom().doubleRangeStep( value[0], value[1], value[2] );
   };
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_RANDOM ); writeChildren( out ); }
 };
 
 class ExpressionNeg : public ExpressionSingle {
 public:
   ExpressionNeg( Expression* _a ) : ExpressionSingle( _a ) { };
-  double calc() {
+  double calc( ExecutionContext&, const double* value ) const {
     return -value[0];
   }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_NEG ); writeChildren( out ); }
 };
 
 class ExpressionRound : public ExpressionSingle {
 public:
   ExpressionRound( Expression* _a ) : ExpressionSingle( _a ) { };
-  double calc() {
+  double calc( ExecutionContext&, const double* value ) const {
     return math::roundToInt( value[0] );
   }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_ROUND ); writeChildren( out ); }
 };
 
 /*
@@ -131,7 +178,7 @@ public:
   class Expression##name : public ExpressionDouble { \
   public: \
     Expression##name ( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { } \
-    double calc() { return (operation); } \
+    double calc( ExecutionContext&, const double* value ) const { return (operation); } \
   };
 
 DOUBLEEXPRESSION( Add,      value[0] + value[1] )
@@ -147,46 +194,62 @@ DOUBLEEXPRESSION( Or,       ( value[0] >= 0.0 && value[1] >= 0.0 ) ? 1.0 : -1.0
 class ExpressionAdd : public ExpressionDouble {
 public:
   ExpressionAdd( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return value[0] + value[1]; }
+  double calc( ExecutionContext&, const double* value ) const { return value[0] + value[1]; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_ADD ); writeChildren( out ); }
 };
 class ExpressionSub : public ExpressionDouble {
 public:
   ExpressionSub( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return value[0] - value[1]; }
+  double calc( ExecutionContext&, const double* value ) const { return value[0] - value[1]; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_SUB ); writeChildren( out ); }
 };
 class ExpressionDiv : public ExpressionDouble {
 public:
   ExpressionDiv( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return value[0] / value[1]; }
+  double calc( ExecutionContext&, const double* value ) const { return value[0] / value[1]; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_DIV ); writeChildren( out ); }
 };
 class ExpressionMult : public ExpressionDouble {
 public:
   ExpressionMult( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return value[0] * value[1]; }
+  double calc( ExecutionContext&, const double* value ) const { return value[0] * value[1]; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_MULT ); writeChildren( out ); }
 };
 
 class ExpressionGreater : public ExpressionDouble {
 public:
   ExpressionGreater( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return value[0] > value[1] ? 1.0 : -1.0; }
+  double calc( ExecutionContext&, const double* value ) const { return value[0] > value[1] ? 1.0 : -1.0; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_GREATER ); writeChildren( out ); }
 };
 
 class ExpressionEqual : public ExpressionDouble {
 public:
   ExpressionEqual( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return math::abs( value[0] - value[1] ) < 0.001f ? 1.0 : -1.0; }
+  double calc( ExecutionContext&, const double* value ) const { return math::abs( value[0] - value[1] ) < 0.001f ? 1.0 : -1.0; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_EQUAL ); writeChildren( out ); }
 };
 
 class ExpressionAnd : public ExpressionDouble {
 public:
   ExpressionAnd( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return ( value[0] >= 0.0 && value[1] >= 0.0 ) ? 1.0 : -1.0; }
+  double calc( ExecutionContext&, const double* value ) const { return ( value[0] >= 0.0 && value[1] >= 0.0 ) ? 1.0 : -1.0; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_AND ); writeChildren( out ); }
 };
 
 class ExpressionOr : public ExpressionDouble {
 public:
   ExpressionOr( Expression* exp0, Expression* exp1 ) : ExpressionDouble( exp0, exp1 ) { }
-  double calc() { return ( value[0] >= 0.0 || value[1] >= 0.0 ) ? 1.0 : -1.0; }
+  double calc( ExecutionContext&, const double* value ) const { return ( value[0] >= 0.0 || value[1] >= 0.0 ) ? 1.0 : -1.0; }
+  void compile( ExpressionCompiler& compiler, int reg ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::EXP_OR ); writeChildren( out ); }
 };
 
 #endif /* __EXPRESSION_H__ */
@@ -0,0 +1,165 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file ExpressionProgram.h
+ * @brief Bytecode form of the grammar expressions.
+ */
+
+#ifndef __EXPRESSIONPROGRAM_H__
+#define __EXPRESSIONPROGRAM_H__
+
+#include "globals.h"
+#include "Expression.h"
+#include "Arena.h"
+
+/**
+ * @class ExpressionBytecode
+ * @brief Instruction set shared by ExpressionProgram and ExpressionCompiler.
+ */
+class ExpressionBytecode {
+public:
+  /** Instruction opcodes, see ExpressionProgram::calculate. */
+  enum Opcode {
+    OP_CONST,     /**< r[dst] = constants[arg] */
+    OP_ATTR,      /**< r[dst] = attribute in slot arg */
+    OP_FACE,      /**< r[dst] = face attribute arg */
+    OP_RANDOM,    /**< r[dst] = random( r[dst], r[a], step r[b] ) */
+    OP_NEG,       /**< r[dst] = -r[a] */
+    OP_ROUND,     /**< r[dst] = round( r[a] ) */
+    OP_ADD,       /**< r[dst] = r[a] + r[b] */
+    OP_SUB,       /**< r[dst] = r[a] - r[b] */
+    OP_MULT,      /**< r[dst] = r[a] * r[b] */
+    OP_DIV,       /**< r[dst] = r[a] / r[b] */
+    OP_GREATER,   /**< r[dst] = r[a] > r[b] ? 1 : -1 */
+    OP_EQUAL,     /**< r[dst] = r[a] == r[b] ? 1 : -1 */
+    OP_BOOL,      /**< r[dst] = r[a] >= 0 ? 1 : -1 */
+    OP_JUMPNEG,   /**< if r[a] < 0 jump to arg */
+    OP_JUMPNONNEG /**< if r[a] >= 0 jump to arg */
+  };
+  /** Maximum number of registers, deeper expressions aren't compiled. */
+  static const int MAX_REGISTERS = 32;
+  /** A single instruction. */
+  struct Instruction {
+    unsigned char op;
+    unsigned char dst;
+    unsigned char a;
+    unsigned char b;
+    int arg;
+  };
+};
+
+/**
+ * @class ExpressionProgram
+ * @brief An expression tree compiled into a flat register bytecode.
+ *
+ * The parser builds expressions as trees of Expression nodes, evaluating
+ * those costs a virtual call per node, and evaluates both sides of the
+ * logical operators. When the grammar is linked every expression held by
+ * an operation or a product is compiled into a program: an array of
+ * three-address instructions over a small register file, run by a single
+ * switch loop. The registers are allocated by depth, so an expression uses
+ * as many registers as it's tree is deep, and the file lives on the stack
+ * of calculate() -- programs are shared by all threads. The logical
+ * operators jump over their right side once the result is known, and
+ * arithmetic on constants is folded while compiling. The instructions
+ * and constants are built by an ExpressionCompiler, and copied into the 
+ * grammar's arena next to the program.
+ */
+class ExpressionProgram : public Expression, public ExpressionBytecode {
+  /** The program. The result is left in register 0. */
+  const Instruction* code;
+  /** Number of instructions. */
+  int count;
+  /** Constants referenced by OP_CONST. */
+  const double* constants;
+public:
+  /**
+   * Compiles the passed expression tree. Returns the program allocated
+   * from the arena, or the tree itself if it can't be compiled. NULL is
+   * passed through. The tree stays in the arena.
+   */
+  static Expression* compileTree( Arena& arena, Expression* tree );
+  /** Runs the program. */
+  double calculate( ExecutionContext& context, Mesh* mesh, int face ) const;
+  /** Returns true if the program folded into a single constant. */
+  bool isConstant( double& value ) const {
+    if ( count != 1 || code[0].op != OP_CONST ) return false;
+    value = constants[code[0].arg];
+    return true;
+  }
+  /** Returns the number of instructions. */
+  int size( ) const {
+    return count;
+  }
+private:
+  /** Constructor, only compileTree() creates programs. */
+  ExpressionProgram( const Instruction* _code, int _count, const double* _constants )
+    : code( _code ), count( _count ), constants( _constants ) {}
+};
+
+/**
+ * @class ExpressionCompiler
+ * @brief Builds the bytecode of an ExpressionProgram.
+ *
+ * Expression::compile emits the instructions of a tree through the 
+ * compiler, which folds constants as they're emitted. Used on the stack
+ * by ExpressionProgram::compileTree only.
+ */
+class ExpressionCompiler : public ExpressionBytecode {
+  /** The instructions emitted so far. */
+  std::vector< Instruction > code;
+  /** Constants referenced by OP_CONST. */
+  DoubleVector constants;
+  /** Set if some register was out of range, or a node couldn't be compiled. */
+  bool failed;
+  /** 
+   * Index of the first instruction that isn't a jump target, constants
+   * loaded before it can't be folded. 
+   */
+  int barrier;
+  friend class ExpressionProgram;
+public:
+  /** Constructor, starts an empty program. */
+  ExpressionCompiler( ) : failed( false ), barrier( 0 ) {}
+  /** Appends an instruction and returns it's index. */
+  int emit( Opcode op, int dst, int a = 0, int b = 0, int arg = 0 );
+  /** Appends an instruction loading the given constant into dst. */
+  void emitConst( int dst, double value );
+  /** Sets the target of the jump at the given index to the next instruction. */
+  void patchJump( int at ) {
+    code[at].arg = barrier = int( code.size() );
+  }
+  /** Marks the program as not compilable. */
+  void fail( ) {
+    failed = true;
+  }
+private:
+  /** 
+   * Folds an operation on constants loaded by the last instructions into
+   * a single constant load. Returns false if the operands aren't constant.
+   */
+  bool fold( Opcode op, int dst, int a, int b );
+  /** Returns true if the instruction at the index loads a foldable constant into reg. */
+  bool isConst( int at, int reg ) const {
+    return at >= barrier && code[at].op == OP_CONST && code[at].dst == reg;
+  }
+};
+
+#endif /* __EXPRESSIONPROGRAM_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
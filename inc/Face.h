@@ -18,222 +18,168 @@
 #define __FACE3D_H__
 
 #include "globals.h"
-#include "Output.h"
+#include "Arena.h"
+
+class Mesh;
+
+/** Type definition for a vector of indices kept in an Arena. */
+typedef std::vector< int, ArenaAllocator< int > > IndexVector;
+
+/**
+ * @struct FaceGeometry
+ * @brief Geometric properties of a face, as cached by the Mesh.
+ *
+ * The values are only meaningful while none of the face's vertices was
+ * written after the Mesh vertex stamp they were computed at.
+ */
+struct FaceGeometry {
+  /** Center of the face. */
+  Vertex center;
+  /** Normal of the face. */
+  Vertex normal;
+  /** Length of the horizontal (first) edge. */
+  double h;
+  /** Length of the vertical (second) edge. */
+  double v;
+  /** Mesh vertex stamp at the time of computation. */
+  unsigned int stamp;
+  /** Default constructor. */
+  FaceGeometry() : h(0.0), v(0.0), stamp(0) {}
+};
 
 /**
  * @class Face
- * @brief Class representing a mesh face.
+ * @brief Handle of a mesh face.
  *
  * The Face consists of indices to vertex and texture coordinates, and
- * some additional output info.
+ * some additional output info. The data itself is stored by the Mesh, in
+ * flat arrays shared by all of it's faces -- a face is only the mesh and
+ * the face ID, so it's cheap to copy, and stays valid as long as the mesh
+ * does. The methods are defined in Mesh.h.
  */
 class Face {
-  /** Material ID of the face */
-  int materialID;
-  /**
-   * States wether the face should be outputed. Used by MultiFace and
-   * for reusing geometry data of faces that should not exist.
-   */
-  bool output;
 protected:
-  /**
-   * Vector holding the indices of texture coords held by the Mesh
-   * class.
-   */
-  IntVector tcd;
-  /**
-   * Vector holding the indices of vertex coords held by the Mesh
-   * class.
-   */
-  IntVector vtx;
+  /** The mesh holding the face. */
+  Mesh* mesh;
+  /** ID of the face in the mesh. */
+  int id;
 public:
+  /** Constructor, takes the mesh and the face ID. */
+  Face( Mesh* _mesh, int _id ) : mesh( _mesh ), id( _id ) {}
   /**
-   * Standard and only constructor. Doesn't take any data, addVertex and
-   * addTexCoord should be used for defining the face.
-   */
-  Face() : materialID(0), output(true) {}
-  /**
-   * Destructor.
+   * Returns the ID of the face in it's mesh.
    */
-  virtual ~Face() {}
+  int getID( ) const {
+    return id;
+  }
   /**
    * Clears the vertex index vector.
    */
-  void clearVertices( ) {
-    vtx.clear();
-  }
+  void clearVertices( );
   /**
    * Clears the texture coordinate index vector.
    */
-  void clearTexCoords( ) {
-    tcd.clear();
-  }
+  void clearTexCoords( );
   /**
    * Adds a vertex index to the face.
    */
-  void addVertex( int vertexID ) {
-    vtx.push_back(vertexID);
-  }
-  /**
-   * Adds both a vertex and texture coordinate index to the face.
-   */
-  void addVertex( int vertexID, int texCoordID ) {
-    vtx.push_back( vertexID );
-    tcd.push_back( texCoordID );
-  }
+  void addVertex( int vertexID );
   /**
    * Adds both a texture coordinate index to the face.
    */
-  void addTexCoord( int texCoordID ) {
-    tcd.push_back( texCoordID );
-  }
+  void addTexCoord( int texCoordID );
   /**
    * Returns true, if the given vertex index is a part of this face.
    */
   bool hasVertex( int vertexID ) const {
-    for ( size_t i = 0; i < vtx.size(); i++ )
-      if ( vtx.at(i) == vertexID )
-	return true;
-    return false;
+    return getVertexIndex( vertexID ) >= 0;
   }
   /**
    * Acts like getVertex except that any input is valid -- the list of
    * vertices is treated like a cyclic list.
    */
-  int getCyclicVertex( int index ) const {
-    int size = vtx.size();
-    if (index >= 0) {
-      return vtx.at(index % size);
-    } else {
-      return vtx.at((index + size*int(-index/size+1)) % size);
-    }
-  }
+  int getCyclicVertex( int index ) const;
   /**
    * Returns the vertex ID specified by the given index in the face's list.
    */
-  int getVertex( const int index ) const {
-    assert( index < int(vtx.size()) );
-    return vtx.at(index);
-  }
+  int getVertex( int index ) const;
   /**
    * Returns the texture coordinate ID specified by the given index in the
-   * face's list.
+   * face's list. Note that this has always returned the vertex ID, and
+   * the MultiFace depends on it -- Mesh::output reads the texcoords
+   * itself.
    */
   int getTexCoord( int index ) const {
-    return vtx.at(index);
+    return getVertex( index );
   }
   /**
    * Inserts a vertex ID after the position specified.
    */
   void insertVertexAfter( int index, int vertexID ) {
-    vtx.insert( vtx.begin()+index+1, vertexID );
+    insertVertexBefore( index + 1, vertexID );
   }
   /**
    * Inserts a vertex ID before the position specified.
    */
-  void insertVertexBefore( int index, int vertexID ) {
-    vtx.insert( vtx.begin()+index, vertexID );
-  }
+  void insertVertexBefore( int index, int vertexID );
   /**
    * Removes the vertex ID at the specified index, and shifts the
    * vertex ID array to remove the empty space.
    */
-  void removeVertex( int index ) {
-    vtx.erase( vtx.begin()+index );
-  }
-  /**
-   * Returns a string representation of the given face. Used for
-   * debugging purposes.
-   */
-  String toStringIDs( ) const {
-    char buffer[80];
-    sprintf(buffer, "(%d,%d,%d,%d)",vtx.at(0),vtx.at(1),vtx.at(2),vtx.at(3));
-    return String(buffer);
-  }
+  void removeVertex( int index );
   /**
    * Returns the size of the face. The size is defined as the amount of
    * vertices that make up the face.
    */
-  size_t size() const {
-    return vtx.size();
-  }
+  size_t size() const;
   /**
-   * Sets the Material ID for the face.
+   * Sets the Material ID for the face. IDs that don't fit 16 bits are
+   * stored as -1, and never output.
    */
-  void setMaterial( int _materialID ) {
-    materialID = _materialID;
-  }
+  void setMaterial( int materialID );
   /**
    * Returns the Material ID for the face.
    */
-  int getMaterial() const {
-    return materialID;
-  }
+  int getMaterial() const;
   /**
    * Sets wether the face should be sent to output.
    */
-  void setOutput( bool _output ) {
-    output = _output;
-  }
+  void setOutput( bool output );
   /**
    * Returns wether the face is intended for output.
    */
-  bool outputable() const {
-    return output;
-  }
+  bool outputable() const;
   /**
    * Returns whether the face has any texture coords defined.
    */
-  bool hasTexCoords( ) const {
-    return !tcd.empty();
-  }
+  bool hasTexCoords( ) const;
   /**
    * Returns whether the face is a MultiFace.
    */
-  virtual bool isMultiFace() const {
-    return false;
-  }
+  bool isMultiFace() const;
   /**
    * Returns the index (position) in the face's vertex array of the
    * vertex specified by the passed ID. Used by MultiFace.
    */
-  int getVertexIndex(int vertexID) const {
-    for ( size_t i = 0; i < vtx.size(); i++ )
-      if ( vtx.at(i) == vertexID )
-	return i;
-    return -1;
-  }
+  int getVertexIndex( int vertexID ) const;
   /**
    * Returns a copy of the texCoord indices array.
    */
-  IntVector getTexCoords( ) const {
-    return tcd;
-  }
+  IndexVector getTexCoords( ) const;
   /**
    * Sets the texCoord indices array to the passed vector.
    */
-  void setTexCoords( IntVector _tcd ) {
-    tcd = _tcd;
-  }
+  void setTexCoords( const IndexVector& tcd );
   /**
    * Returns a copy of the vertex indices array.
    */
-  IntVector getVertices( ) const {
-    return vtx;
-  }
+  IndexVector getVertices( ) const;
   /**
    * Sets the vertex indices array to the passed vector.
    */
-  void setVertices( IntVector _vtx ) {
-    vtx = _vtx;
-  }
+  void setVertices( const IndexVector& vtx );
 };
 
-/** Type definition for a Vector of Face pointers. */
-typedef std::vector<Face*> FaceVector;
-/** Type definition for a Vector of Face pointers iterator. */
-typedef FaceVector::iterator FaceVectIter;
-
 #endif /* __FACE3D_H__ */
 
 // Local Variables: ***
@@ -243,4 +189,3 @@ typedef FaceVector::iterator FaceVectIter;
 // indent-tabs-mode: t ***
 // End: ***
 // ex: shiftwidth=2 tabstop=8
-
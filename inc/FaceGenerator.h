@@ -32,7 +32,7 @@ public:
   /**
    * Constructor, just runs it's inherited constructor.
    */
-  FaceGenerator( RuleSet* _ruleset ) : Generator( _ruleset ) {};
+  FaceGenerator( const RuleSet* _ruleset ) : Generator( _ruleset ) {};
   /**
    * Parses options.
    */
@@ -55,7 +55,7 @@ private:
    * Takes the vector, and does some random deviation on it, up to the
    * passed value in radians. Assumes that the vector is (0,0) based.
    */
-  static Vector2Df deviateVector( const Vector2Df v, double noise );
+  Vector2Df deviateVector( const Vector2Df v, double noise );
   /**
    * Main growth function for secondary road generation. Is executed
    * recursively. Branching controls how many segments maximum can go
@@ -42,6 +42,10 @@ class FloorZone : public Zone {
    * Flag to set wether the floor part is rotated texture-wise. 
    */
   bool rotated;
+  /**
+   * Arena holding the floor mesh and it's face.
+   */
+  Arena arena;
   /** 
    * The generated floor mesh. Is empty until run() is called.
    */
@@ -51,7 +55,8 @@ public:
    * Constructor defining the zone. Only sets the required parameters. 
    */
   FloorZone( Generator* _generator, graph::Face* _face, int _step, int _materialID, bool _rotated ) 
-    : Zone( _generator, _face ), step( _step ), materialID( _materialID ), rotated( _rotated ) {};
+    : Zone( _generator, _face ), step( _step ), materialID( _materialID ), rotated( _rotated ),
+      mesh( arena ) {};
   /** 
    * Generates the floor mesh, and assigned texture information. 
    * WARNING: currently works ONLY with quad faces. 
@@ -17,11 +17,13 @@
 #ifndef __GENERATOR_H__
 #define __GENERATOR_H__
 
+#include <ctime>
 #include "globals.h"
 #include "RuleSet.h"
 #include "Material.h"
 #include "commandArgs.h"
 #include "Zone.h"
+#include "Random.h"
 #include "graph/PlanarGraph.h"
 
 /** 
@@ -37,8 +39,8 @@ class Generator {
 protected:
   /** Size of the world in world units. */
   int size;
-  /** Pointer to the loaded RuleSet. */
-  RuleSet* ruleset;
+  /** Pointer to the loaded RuleSet, read-only and shared by all zones. */
+  const RuleSet* ruleset;
   /** A list of all the materials used. */
   MaterialVector mats;
   /** Number of bases on the map. */
@@ -53,26 +55,57 @@ protected:
   bool ctfSafe;
   /** The planar graph of faces for zones. */
   graph::PlanarGraph graph;
+  /** Number of threads zones are run on. */
+  int threads;
+  /** 
+   * Output the zones are streamed to while running, NULL if they're 
+   * kept until output().
+   */
+  Output* streamOutput;
+  /** 
+   * The world seed. The whole map is determined by it and the options. 
+   */
+  unsigned int seed;
+  /** 
+   * Random stream of the generator itself (stream 0 of the world seed). 
+   * Zone N gets stream N+1.
+   */
+  Random random;
 public:
   /** 
    * Standard constructor, takes a already loaded RuleSet as
    * it's parameter. The ruleset needs to have MATROAD and 
    * MATROADX defined. 
    */
-  Generator( RuleSet* _ruleset ) : ruleset( _ruleset ) {
+  Generator( const RuleSet* _ruleset ) : ruleset( _ruleset ), threads( 1 ), streamOutput( NULL ), seed( (unsigned int) time( NULL ) ), random( seed ) {
     roadid  = math::roundToInt( ruleset->getAttr( "MATROAD" ) );
     roadxid = math::roundToInt( ruleset->getAttr( "MATROADX" ) );
   }
   /** 
    * Parse command line or config file options. Virtual so the
    * specific generator can overload it. Generator parses the size,
-   * bases and ctfsafe options. 
+   * bases, ctfsafe, threads and seed options. 
    */
   virtual void parseOptions( CCommandLineArgs* opt );
   /** 
-   * Runs the generator. Calls run on every stored zone. 
+   * Runs the generator. Calls run on every stored zone, using a
+   * ThreadPool if more than one thread was requested. Each zone gets
+   * it's own random stream, so the result doesn't depend on the
+   * number of threads.
+   *
+   * If an Output was set by setStream(), the header and the materials
+   * are written to it first, and every zone is written and released as
+   * soon as it's complete, in zone order -- only the zones being run 
+   * and those waiting for the zones before them hold memory.
    */
   virtual void run( );
+  /**
+   * Sets the Output the zones are streamed to by run(), output() 
+   * shouldn't be called then. NULL turns streaming off.
+   */
+  void setStream( Output* out ) {
+    streamOutput = out;
+  }
   /** 
    * Returns the size of the world. 
    */
@@ -95,13 +128,21 @@ public:
   /** 
    * Returns the loaded RuleSet. 
    */
-  inline RuleSet* getRuleSet() { 
+  inline const RuleSet* getRuleSet() const { 
     return ruleset; 
   }
   /** 
    * Outputs data. Goes through all the stored zones and outputs them.
+   * If more than one thread was requested, the zones are serialized in
+   * parallel, each into an Output of it's own, and appended in zone 
+   * order -- the result is the same.
    */
   virtual void output( Output& out );
+  /**
+   * Outputs the world header, the materials and the ruleset, everything
+   * that goes before the zones.
+   */
+  void outputHeader( Output& out );
   /** 
    * Returns the requested Material by material ID. 
    */
@@ -0,0 +1,135 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file GrammarImage.h
+ * @brief Binary image of a parsed grammar, loaded instead of the sources.
+ */
+
+#ifndef __GRAMMARIMAGE_H__
+#define __GRAMMARIMAGE_H__
+
+#include "globals.h"
+
+class RuleSet;
+class Expression;
+
+/** 
+ * Version of the image format, bump it whenever the written form of any
+ * grammar class changes -- images of other versions are ignored.
+ */
+#define GRAMMAR_IMAGE_VERSION 1
+
+/**
+ * @class GrammarWriter
+ * @brief Serializes a parsed grammar into the image format.
+ *
+ * Every grammar class -- the ruleset, rules, products, operations and
+ * expressions -- implements write(), which writes it's tag followed by
+ * what it's constructor was passed by the parser. The image is read back
+ * by calling the same constructors, so the loaded grammar is exactly the
+ * parsed one. Classes the image doesn't know call fail().
+ */
+class GrammarWriter {
+public:
+  /** Tags of the operations and expressions. */
+  enum Tag {
+    EXP_NULL, EXP_CONST, EXP_ATTRIBUTE, EXP_FACE, EXP_RANDOM, EXP_NEG, EXP_ROUND,
+    EXP_ADD, EXP_SUB, EXP_DIV, EXP_MULT, EXP_GREATER, EXP_EQUAL, EXP_AND, EXP_OR,
+    OP_NONTERMINAL, OP_LOADMATERIAL, OP_ADDFACE, OP_MULTIFACE, OP_SPAWN, OP_UNCHAMFER,
+    OP_FREE, OP_DRIVETHROUGH, OP_REMOVE, OP_TEXTUREFULL, OP_TEXTURECLEAR, OP_TEXTURE,
+    OP_TEXTUREQUAD, OP_SCALE, OP_TRANSLATE, OP_TRANSLATER, OP_NGON, OP_ASSERT, OP_ASSIGN,
+    OP_MATERIAL, OP_EXPAND, OP_TAPER, OP_CHAMFER, OP_DETACHFACE, OP_EXTRUDE, OP_EXTRUDET,
+    OP_SPLITFACE, OP_REPEAT
+  };
+private:
+  /** Ruleset being written, attribute slots are written as their names. */
+  const RuleSet* ruleset;
+  /** The written image body. */
+  String data;
+  /** Set if some class couldn't be written. */
+  bool failed;
+public:
+  /** Constructor, takes the ruleset being written. */
+  GrammarWriter( const RuleSet* _ruleset ) : ruleset( _ruleset ), failed( false ) {}
+  /** Appends an integer. */
+  void writeInt( int value ) {
+    data.append( (const char*)&value, sizeof( value ) );
+  }
+  /** Appends a double. */
+  void writeDouble( double value ) {
+    data.append( (const char*)&value, sizeof( value ) );
+  }
+  /** Appends a length prefixed string. */
+  void writeString( const String& value ) {
+    writeInt( int( value.size() ) );
+    data.append( value );
+  }
+  /** Appends the name of the attribute in the given slot. */
+  void writeAttr( int slot );
+  /** Appends an array of strings, NULL is written as length -1. */
+  void writeStrings( const char* const* strings, int count );
+  /** Appends an expression tree, NULL included. */
+  void writeExpression( const Expression* expression );
+  /** Appends an array of expression trees. */
+  void writeExpressions( Expression* const* expressions, int count );
+  /** Marks the image as not writable. */
+  void fail( ) {
+    failed = true;
+  }
+  /**
+   * Writes the header and the body to the given file. Returns false if
+   * anything couldn't be written.
+   */
+  bool save( const String& filename, unsigned int hash ) const;
+};
+
+/**
+ * @class GrammarImage
+ * @brief Loading and saving of grammar images.
+ *
+ * Parsing the rule files costs a bison run and an allocation per token
+ * at every start, of the standalone generator as well as of the plugin.
+ * The image holds the parsed grammar -- the attribute table, rules,
+ * products, operations and expression trees, before linking -- together
+ * with a hash of the rule files it was compiled from. It's written by 
+ * the -compilerules option and loaded, memory mapped, whenever the hash 
+ * matches the rule files found at startup. Images are native endian and
+ * only meant for the machine that compiled them.
+ */
+class GrammarImage {
+public:
+  /** 
+   * Hashes the names and contents of the given rule files, in the given
+   * order. 
+   */
+  static unsigned int hashSources( const StringVector& filenames );
+  /** 
+   * Writes the image of the passed freshly parsed ruleset. Returns false 
+   * on failure.
+   */
+  static bool save( const RuleSet* ruleset, const String& filename, unsigned int hash );
+  /**
+   * Loads the ruleset from the given image. Returns NULL if the file
+   * doesn't exist, is broken, or it's version or hash doesn't match.
+   */
+  static RuleSet* load( const String& filename, unsigned int hash );
+};
+
+#endif /* __GRAMMARIMAGE_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -38,7 +38,7 @@ public:
   /** 
    * Constructor, just runs it's inherited constructor. 
    */
-  GridGenerator( RuleSet* _ruleset ) : Generator( _ruleset ), map( NULL ) {};
+  GridGenerator( const RuleSet* _ruleset ) : Generator( _ruleset ), map( NULL ), baseCount( 0 ) {};
   /** 
    * Parses options. GridGenerator parses gridsnap, gridsize,
    * subdiv and fullslice options
@@ -86,6 +86,8 @@ private:
   int gridStep;
   /** Size of the grid. */
   int gridSize;
+  /** Number of bases added so far, used to assign each base a team color. */
+  int baseCount;
   /**
    * Plots a road from the given point, either horizontally or
    * vertically. Collision states whether the plotting should be
@@ -22,6 +22,7 @@
 #include <stdarg.h>
 #include <iostream> 
 #include <fstream> 
+#include "Thread.h"
 
 #ifdef _WIN32
   #pragma warning (push)
@@ -33,13 +34,14 @@
  * @brief Logger class for the generator
  *
  * The logger class is a utility class for debugging BZWGen, it handles
- * information, error and warning messages for BZWGen. 
+ * information, error and warning messages for BZWGen. Logging is thread
+ * safe, as zones may be generated concurrently.
  */
 class LoggerSingleton {
   /**
-   * Buffer for formating of the message using vsnprintf
+   * Mutex serializing the output of messages.
    */
-  char buffer[160];
+  Mutex mutex;
   /** 
    * Log level of messages going to the standard output (cout)
    */
@@ -65,11 +67,13 @@ public:
    */
   void log( int level, const char *str, ... ) {
     if ( !needsLogging( level ) ) return;
+    char buffer[160];
     va_list va;
     va_start( va, str );
     if ( vsnprintf( buffer, 159, str, va ) == -1 )
       std::cerr << "LoggerSingleton::log, buffer is too small!\n" ;
     va_end( va );
+    MutexLock lock( mutex );
     if ( level <= outputLogLevel ) std::cout << buffer << "\n";
     if ( level <= fileLogLevel && fileStream ) (*fileStream) << buffer << "\n";
   }
@@ -77,11 +81,13 @@ public:
    * Message logging, shortcut for logging without level (meaning always).
    */
   void log( const char *str, ... ) {
+    char buffer[160];
     va_list va;
     va_start( va, str );
     if ( vsnprintf( buffer, 159, str, va ) == -1 )
       std::cerr << "LoggerSingleton::log, buffer is too small!\n" ;
     va_end( va );
+    MutexLock lock( mutex );
     std::cout << buffer << "\n";
     if ( fileStream ) (*fileStream) << buffer << "\n";
   }
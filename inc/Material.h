@@ -37,7 +37,7 @@ public:
   Material( const int _name, const String& _path, bool _noradar = false ) 
     : name( _name ), path( _path ), noradar( _noradar ) {};
   /** Outputs the material to the passed output class. */
-  void output( Output& out ) {
+  void output( Output& out ) const {
     out.material( name, path, noradar );
   }
 };
@@ -13,27 +13,101 @@
 #ifndef __MESH_H__
 #define __MESH_H__
 
+#include <map>
 #include "globals.h"
+#include "Arena.h"
 #include "Output.h"
 #include "Face.h"
 
+// A mesh and all of it's arrays are allocated from the arena of the zone
+// that derives it, and are freed together with the arena -- meshes are
+// never deleted.
+//
+// Faces are stored as flat arrays: a small record per face, and the
+// vertex and texcoord indices of all faces in two shared index buffers.
+// A face's indices are a range of the buffer with some room to grow,
+// a range that outgrows it's room moves to the end of the buffer. Faces
+// are accessed through Face handles. The components of MultiFaces are
+// kept in a side table.
 class Mesh {
-  IntVector freeVertices;
-  VertexVector inside;
-  VertexVector outside;
-  TexCoordVector tc;
-  FaceVector f;
-  VertexVector v;
-  VertexVector vbase;
+  typedef std::vector< Vertex, ArenaAllocator< Vertex > > VertexArray;
+  typedef std::vector< TexCoord, ArenaAllocator< TexCoord > > TexCoordArray;
+  typedef std::pair< const int, IndexVector* > ComponentEntry;
+  typedef std::map< int, IndexVector*, std::less< int >, ArenaAllocator< ComponentEntry > > ComponentMap;
+  // face flags
+  enum {
+    FACE_OUTPUT = 1,  // the face is sent to output
+    FACE_MULTI  = 2,  // the face is a MultiFace, see components
+    FACE_HIDDEN = 4   // replaced by a MultiFace, only kept as it's component
+  };
+  // material stored for IDs that don't fit the record
+  enum { NO_MATERIAL = 0xFFFF };
+  // size of the face geometry cache, a power of two
+  enum { GEOMETRY_CACHE_SIZE = 64 };
+  // per face data, 28 bytes
+  struct FaceRecord {
+    int first;                  // first vertex index in indices
+    int texFirst;               // first texcoord index in texIndices
+    int count;                  // number of vertex indices
+    int capacity;               // room reserved for them
+    int texCount;               // number of texcoord indices
+    int texCapacity;            // room reserved for them
+    unsigned short material;    // material ID, or NO_MATERIAL
+    unsigned short flags;       // FACE_* flags
+  };
+  // a node of the vertex to face adjacency lists
+  struct AdjacencyNode {
+    int face;
+    int next;
+  };
+  // a face geometry cache entry, face is -1 if unused
+  struct CachedGeometry {
+    int face;
+    FaceGeometry geometry;
+  };
+  Arena& arena;
+  IndexVector freeVertices;
+  VertexArray inside;
+  VertexArray outside;
+  TexCoordArray tc;
+  // hash index of tc, see addTexCoord; chains are linked through tcChain
+  IndexVector tcBuckets;
+  IndexVector tcChain;
+  std::vector< FaceRecord, ArenaAllocator< FaceRecord > > faces;
+  IndexVector indices;
+  IndexVector texIndices;
+  ComponentMap components;
+  VertexArray v;
+  VertexArray vbase;
+  // Vertex to face adjacency, linked lists in a pool with a free list,
+  // headed by adjacencyHead. Built by the first weld, and kept up to date
+  // by the Face methods from then on.
+  std::vector< AdjacencyNode, ArenaAllocator< AdjacencyNode > > adjacency;
+  IndexVector adjacencyHead;
+  int adjacencyFree;
+  bool adjacencyBuilt;
+  // per vertex stamp of the last write, see faceGeometry
+  std::vector< unsigned int, ArenaAllocator< unsigned int > > vstamp;
+  // direct mapped by face ID, allocated from the arena when first used
+  mutable CachedGeometry* geometryCache;
+  unsigned int stamp;
   bool passable;
+  friend class Face;
 public:
-  Mesh() : passable(false) {}
+  Mesh( Arena& _arena )
+    : arena(_arena), freeVertices(_arena), inside(_arena), outside(_arena), tc(_arena),
+      tcBuckets(_arena), tcChain(_arena),
+      faces(_arena), indices(_arena), texIndices(_arena),
+      components(std::less< int >(), ArenaAllocator< ComponentEntry >(_arena)),
+      v(_arena), vbase(_arena), adjacency(_arena), adjacencyHead(_arena), adjacencyFree(-1),
+      adjacencyBuilt(false), vstamp(_arena), geometryCache(NULL), stamp(0), passable(false) {}
+  inline Arena& getArena( ) {
+    return arena;
+  }
   int addVertex( Vertex vertex );
   int addTexCoord( TexCoord texCoord );
-  int addFace(Face* face) {
-    f.push_back( face );
-    return f.size()-1;
-  }
+  // adds an empty face with the given material, and returns it's ID
+  int addFace( int material = 0 );
   inline void addInsideVertex( Vertex vertex ) {
     inside.push_back( vertex );
   }
@@ -41,11 +115,17 @@ public:
   inline Vertex getVertex( int vertexID ) const {
     return v[vertexID];
   }
-  inline Face* getFace( int faceID ) {
-    return f[ faceID ];
+  inline Face getFace( int faceID ) {
+    return Face( this, faceID );
+  }
+  inline int faceCount( ) const {
+    return int( faces.size() );
+  }
+  inline int vertexCount( ) const {
+    return int( v.size() );
   }
   inline Vertex getFaceVertex( int faceID, int vertexID ) const {
-    return v[ f[ faceID ]->getVertex( vertexID ) ];
+    return v[ indices[ faces[ faceID ].first + vertexID ] ];
   }
   inline Vertex getFaceEdge( int faceID, int id1, int id2 ) const {
     return ( getFaceVertex( faceID, id2 ) - getFaceVertex( faceID, id1 ) );
@@ -53,19 +133,21 @@ public:
 
   inline void substituteVertex( int vertexID, Vertex vtx ) {
     v[vertexID] = vtx;
+    touchVertex( vertexID );
   }
-  inline void substituteFace( int faceID, Face* face ) {
-    f[ faceID ] = face;
-  }
+  // Replaces the face by a MultiFace, with the face as it's only component.
+  void makeMultiFace( int faceID );
+  // Returns the component face IDs of the MultiFace.
+  IndexVector& faceComponents( int faceID );
 
   inline void setPassable( ) {
     passable = true;
   }
 
-  void extrudeFace(int fid, double amount, int mat = 0, IntVector* result = NULL);
-  IntVector* splitFace(int fid, DoubleVector* splitData, bool horizontal, double ssnap = 0.0);
+  void extrudeFace(int fid, double amount, int mat = 0, IndexVector* result = NULL);
+  void splitFace(int fid, DoubleVector* splitData, bool horizontal, double ssnap, IndexVector* result);
   void expandFace( int faceID, double amount );
-  IntVector* repeatSubdivdeFace(int fid, double snap, bool horizontal);
+  void repeatSubdivdeFace(int fid, double snap, bool horizontal, IndexVector* result);
   void chamferFace( int faceID, double amount );
   void taperFace( int faceID, double amount );
   void scaleFace( int faceID, double x, double y );
@@ -82,26 +164,150 @@ public:
 
   int createNGon(Vertex center, double radius, int n);
 
-  Vertex faceNormal( int faceID );
-  Vertex faceCenter( int faceID );
+  // Returns the geometry of the face. The values are cached by the mesh
+  // and only recomputed after the face's vertex list or one of it's
+  // vertices changed, so face() conditions evaluated on an unchanged face
+  // are cheap. The reference is only valid until the next call.
+  const FaceGeometry& faceGeometry( int faceID ) const;
+  inline Vertex faceNormal( int faceID ) const {
+    return faceGeometry( faceID ).normal;
+  }
+  inline Vertex faceCenter( int faceID ) const {
+    return faceGeometry( faceID ).center;
+  }
   inline double faceH( int faceID ) const {
-    return getFaceEdge( faceID, 1, 0 ).length();
+    return faceGeometry( faceID ).h;
   }
   inline double faceV( int faceID ) const {
-    return getFaceEdge( faceID, 1, 2 ).length();
+    return faceGeometry( faceID ).v;
   }
-  String faceToString(Face* face);
+  inline double faceArea( int faceID ) const {
+    const FaceGeometry& geometry = faceGeometry( faceID );
+    return geometry.h * geometry.v;
+  }
+  String faceToString( int faceID );
 
   void pushBase( int faceID );
   int rePushBase( );
-  ~Mesh();
 private:
   Vertex extensionVertex(int ida, int idb, int idc);
+  // links the texcoord into the hash index, growing it when needed
+  void indexTexCoord( int texCoordID );
+  // true if output() writes the face: it's outputable, not hidden, and
+  // it's material is known
+  static inline bool writable( const FaceRecord& face, int materialCount ) {
+    return ( face.flags & ( FACE_OUTPUT | FACE_HIDDEN ) ) == FACE_OUTPUT && int( face.material ) <= materialCount;
+  }
+  // records that the face uses the vertex, if the adjacency is built
+  inline void linkVertex( int faceID, int vertexID ) {
+    if ( adjacencyBuilt ) addAdjacency( faceID, vertexID );
+  }
+  // records that the face dropped one use of the vertex
+  inline void unlinkVertex( int faceID, int vertexID ) {
+    if ( adjacencyBuilt ) removeAdjacency( faceID, vertexID );
+  }
+  void buildAdjacency( );
+  void addAdjacency( int faceID, int vertexID );
+  void removeAdjacency( int faceID, int vertexID );
+  // marks the vertex as written, invalidating the geometry of it's faces
+  inline void touchVertex( int vertexID ) {
+    vstamp[vertexID] = ++stamp;
+  }
+  // drops the cached geometry of a face whose vertex list changed
+  inline void invalidateGeometry( int faceID ) {
+    if ( geometryCache != NULL && geometryCache[ faceID & ( GEOMETRY_CACHE_SIZE - 1 ) ].face == faceID )
+      geometryCache[ faceID & ( GEOMETRY_CACHE_SIZE - 1 ) ].face = -1;
+  }
+  // Makes room for needed indices in the range of buffer starting at
+  // first, moving it to the end of the buffer if it can't grow in place.
+  // The first count indices are kept. Returns the start of the range.
+  int* reserve( IndexVector& buffer, int& first, int& capacity, int count, int needed );
 };
 
 typedef std::vector<Mesh*> MeshVector;
 typedef MeshVector::iterator MeshVectIter;
 
+inline void Face::clearVertices( ) {
+  mesh->invalidateGeometry( id );
+  if ( mesh->adjacencyBuilt )
+    for ( int i = 0; i < mesh->faces[id].count; i++ )
+      mesh->removeAdjacency( id, getVertex( i ) );
+  mesh->faces[id].count = 0;
+}
+
+inline void Face::clearTexCoords( ) {
+  mesh->faces[id].texCount = 0;
+}
+
+inline void Face::addVertex( int vertexID ) {
+  Mesh::FaceRecord& face = mesh->faces[id];
+  mesh->invalidateGeometry( id );
+  int* vertices = mesh->reserve( mesh->indices, face.first, face.capacity, face.count, face.count + 1 );
+  vertices[ face.count++ ] = vertexID;
+  mesh->linkVertex( id, vertexID );
+}
+
+inline void Face::addTexCoord( int texCoordID ) {
+  Mesh::FaceRecord& face = mesh->faces[id];
+  int* texcoords = mesh->reserve( mesh->texIndices, face.texFirst, face.texCapacity, face.texCount, face.texCount + 1 );
+  texcoords[ face.texCount++ ] = texCoordID;
+}
+
+inline int Face::getVertex( int index ) const {
+  assert( index < mesh->faces[id].count );
+  return mesh->indices[ mesh->faces[id].first + index ];
+}
+
+inline int Face::getCyclicVertex( int index ) const {
+  int size = mesh->faces[id].count;
+  if (index >= 0) {
+    return getVertex(index % size);
+  } else {
+    return getVertex((index + size*int(-index/size+1)) % size);
+  }
+}
+
+inline int Face::getVertexIndex( int vertexID ) const {
+  const Mesh::FaceRecord& face = mesh->faces[id];
+  if ( face.count == 0 ) return -1;
+  const int* vertices = &mesh->indices[ face.first ];
+  for ( int i = 0; i < face.count; i++ )
+    if ( vertices[i] == vertexID )
+      return i;
+  return -1;
+}
+
+inline size_t Face::size( ) const {
+  return mesh->faces[id].count;
+}
+
+inline void Face::setMaterial( int materialID ) {
+  mesh->faces[id].material = (unsigned short)( materialID >= 0 && materialID < Mesh::NO_MATERIAL ? materialID : Mesh::NO_MATERIAL );
+}
+
+inline int Face::getMaterial( ) const {
+  return mesh->faces[id].material == Mesh::NO_MATERIAL ? -1 : int( mesh->faces[id].material );
+}
+
+inline void Face::setOutput( bool output ) {
+  if ( output )
+    mesh->faces[id].flags |= Mesh::FACE_OUTPUT;
+  else
+    mesh->faces[id].flags &= ~Mesh::FACE_OUTPUT;
+}
+
+inline bool Face::outputable( ) const {
+  return ( mesh->faces[id].flags & Mesh::FACE_OUTPUT ) != 0;
+}
+
+inline bool Face::hasTexCoords( ) const {
+  return mesh->faces[id].texCount > 0;
+}
+
+inline bool Face::isMultiFace( ) const {
+  return ( mesh->faces[id].flags & Mesh::FACE_MULTI ) != 0;
+}
+
 #endif /* __MESH_H__ */
 
 // Local Variables: ***
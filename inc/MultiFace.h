@@ -19,9 +19,6 @@
 #define __MULTIFACE_H__
 
 #include "globals.h"
-
-#include <memory>
-
 #include "Output.h"
 #include "Face.h"
 #include "Mesh.h"
@@ -31,53 +28,41 @@
  * @brief Class representing a composite mesh face.
  *
  * MultiFace holds a composite face made of many Faces. The faces can then 
- * be extracted from the MultiFace allowing complex shape handling.
+ * be extracted from the MultiFace allowing complex shape handling. Like
+ * Face, it's only a handle -- the component face IDs are kept by the Mesh,
+ * see Mesh::makeMultiFace.
  */
 class MultiFace : public Face {
   /**
-   * Vector of component face pointers. Managed and deleted by the class.
+   * Vector of component face IDs, held by the mesh.
    */
-  std::auto_ptr<FaceVector> comps;
-  /**
-   * As MultiFace has many complex operations, it needs a pointer to the 
-   * underlying mesh, to access vertex data.
-   */
-  Mesh* mesh;
+  IndexVector& comps;
 public:
   /**
-   * Standard constructor, takes the underlying mesh as an argument.
-   * Initializes the underlying component face vector.
+   * Standard constructor, takes the underlying mesh and the ID of a face 
+   * made a MultiFace by Mesh::makeMultiFace.
    */
-  MultiFace( Mesh* _mesh ) : Face( ), comps(new FaceVector), mesh( _mesh )
+  MultiFace( Mesh* _mesh, int _id ) : Face( _mesh, _id ), comps( _mesh->faceComponents( _id ) )
   {
   }
-  /**
-   * Standard destructor, disposes of the component vector.
-   */
-  virtual ~MultiFace() { }
   /**
    * Detaches a face from the MultiFace. The id here is the internal index 
-   * in the component vector. Returns a list of Mesh face ID's of the faces
-   * that are left after the detaching.
+   * in the component vector. Appends the Mesh face ID's of the faces that
+   * are left after the detaching to result, and returns false if there 
+   * are none.
    */
-  IntVector* detachFace( int id );
+  bool detachFace( int id, IndexVector* result );
   /**
    * Adds a new component to the MultiFace. The passed face must already
    * exist in the underlying mesh. Returns the internal component ID of the
    * added face.
    */
-  int addFace( Face* f );
-  /**
-   * Checks whether this face is a MultiFace or not. Returns true.
-   */
-  virtual bool isMultiFace() const { 
-    return true; 
-  }
+  int addFace( int faceID );
   /**
    * Returns the count of stored component faces.
    */
   int componentCount() { 
-    return comps->size(); 
+    return comps.size(); 
   }
 private:
   /**
@@ -86,12 +71,13 @@ private:
    */
   void updateFaces( double z );
   void storeFaces();
-  void refineFace( Face* f, Face* target );
+  void refineFace( Face f, Face target );
   bool vertexInside( int vid );
   bool vertexNearestIntersect( const Vector2Dd A, const Vector2Dd B, 
-    Vector2Dd &P, int &index, Face* face );
-  int pickRemovalIndex( Face *f, IntVector* visited );
-  Face* getOtherFaceWithVertex( Face* f, int vid );
+    Vector2Dd &P, int &index, Face face );
+  int pickRemovalIndex( Face f, IntVector* visited );
+  /** Returns the ID of another component holding the vertex, or -1. */
+  int getOtherFaceWithVertex( Face f, int vid );
   bool isLeftOfVectors( int x, int a, int b, int c );
 };
 
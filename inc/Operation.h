@@ -16,16 +16,30 @@
 
 #include "globals.h"
 #include "Expression.h"
+#include "ExpressionProgram.h"
+#include "Arena.h"
 #include "Mesh.h"
 
 class RuleSet; // To avoid .h file recursion
+class Rule;
 
+// operations are allocated from the grammar's Arena and never deleted,
+// names and arrays they hold are copied into the arena as well
 class Operation {
 protected:
-  RuleSet* ruleset;
-public:
-  Operation( RuleSet* _ruleset ) : ruleset( _ruleset ) {}
-  virtual int runMesh( Mesh*, int ) = 0;
+  const RuleSet* ruleset;
+public:
+  Operation( const RuleSet* _ruleset ) : ruleset( _ruleset ) {}
+  virtual int runMesh( ExecutionContext&, Mesh*, int ) const = 0;
+  // receives the result of a rule scheduled with callResume, after the
+  // rule is derived; returns the face the product continues with
+  virtual int resume( ExecutionContext&, Mesh*, int face, int ) const { return face; }
+  // binds rule references to the ruleset's rules, called once all rules
+  // are loaded; owner is the name of the rule holding the operation, and
+  // compiled expressions are allocated from the arena
+  virtual bool link( Arena&, const String& ) { return true; }
+  // writes the operation into a grammar image -- see GrammarWriter
+  virtual void write( GrammarWriter& out ) const { out.fail(); }
   virtual ~Operation() {}
 };
 
@@ -37,27 +51,34 @@ class OperationTemplate : public Operation {
 protected:
   typedef Expression* ExpressionPtr;
   ExpressionPtr exp[SIZE];
-  double value[SIZE];
 public:
-  OperationTemplate( RuleSet* _ruleset )
+  OperationTemplate( const RuleSet* _ruleset )
     : Operation( _ruleset ) {
     for ( int i = 0; i < SIZE; ++i )
        exp[i] = NULL;
   }
-  void flatten( Mesh* mesh, int face ) {
+  /**
+   * Evaluates the expressions into the passed array. The values are not
+   * stored in the operation, as it may be run by several threads at once.
+   */
+  void flatten( ExecutionContext& context, Mesh* mesh, int face, double* value ) const {
+    for ( int i = 0; i < SIZE; ++i )
+      value[i] = exp[i] ? exp[i]->calculate( context, mesh, face ) : 0.0;
+  }
+  bool link( Arena& arena, const String& ) {
     for ( int i = 0; i < SIZE; ++i )
-      if ( exp[i] )
-        value[i] = exp[i]->calculate( mesh, face );
+      exp[i] = ExpressionProgram::compileTree( arena, exp[i] );
+    return true;
   }
-  virtual ~OperationTemplate() {
+  void writeExpressions( GrammarWriter& out ) const {
     for ( int i = 0; i < SIZE; ++i )
-      deletePointer( exp[i] );
+      out.writeExpression( exp[i] );
   }
 };
 
 class OperationSingle : public OperationTemplate<1> {
 public:
-  OperationSingle( RuleSet* _ruleset, Expression* exp0 )
+  OperationSingle( const RuleSet* _ruleset, Expression* exp0 )
     : OperationTemplate<1>( _ruleset ) {
     exp[0] = exp0;
   }
@@ -65,7 +86,7 @@ public:
 
 class OperationDouble : public OperationTemplate<2> {
 public:
-  OperationDouble( RuleSet* _ruleset, Expression* exp0, Expression* exp1 )
+  OperationDouble( const RuleSet* _ruleset, Expression* exp0, Expression* exp1 )
     : OperationTemplate<2>( _ruleset ) {
     exp[0] = exp0;
     exp[1] = exp1;
@@ -74,7 +95,7 @@ public:
 
 class OperationTriple : public OperationTemplate<3> {
 public:
-  OperationTriple( RuleSet* _ruleset, Expression* exp0, Expression* exp1, Expression* exp2 )
+  OperationTriple( const RuleSet* _ruleset, Expression* exp0, Expression* exp1, Expression* exp2 )
     : OperationTemplate<3>( _ruleset ) {
     exp[0] = exp0;
     exp[1] = exp1;
@@ -84,7 +105,7 @@ public:
 
 class OperationQuad : public OperationTemplate<4> {
 public:
-  OperationQuad( RuleSet* _ruleset, Expression* exp0, Expression* exp1, Expression* exp2, Expression* exp3 )
+  OperationQuad( const RuleSet* _ruleset, Expression* exp0, Expression* exp1, Expression* exp2, Expression* exp3 )
     : OperationTemplate<4>( _ruleset ) {
     exp[0] = exp0;
     exp[1] = exp1;
@@ -94,166 +115,196 @@ public:
 };
 
 class OperationNonterminal : public Operation {
-  String ref;
+  const char* ref;
+  const Rule* rule;
 public:
-  OperationNonterminal( RuleSet* _ruleset, const char* _ref )
-    : Operation( _ruleset ), ref( _ref ) { };
-  int runMesh( Mesh* mesh, int face );
+  OperationNonterminal( const RuleSet* _ruleset, Arena& arena, const char* _ref )
+    : Operation( _ruleset ), ref( arena.copy( _ref ) ), rule( NULL ) { };
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  bool link( Arena& arena, const String& owner );
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_NONTERMINAL ); out.writeString( ref ); }
 };
 
 class OperationLoadMaterial : public Operation {
-  String id;
-  String filename;
+  int slot;
+  const char* filename;
   bool noradar;
 public:
-  OperationLoadMaterial( RuleSet* _ruleset, const char* _id, const char* _filename, bool _noradar )
-    : Operation( _ruleset ), id( _id ), filename( _filename ), noradar( _noradar ) { };
-  int runMesh( Mesh* mesh, int face );
+  OperationLoadMaterial( RuleSet* _ruleset, Arena& arena, const char* _id, const char* _filename, bool _noradar );
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void write( GrammarWriter& out ) const;
 };
 
 class OperationAddFace : public Operation {
-  String ref;
+  const char* ref;
+  const Rule* rule;
 public:
-  OperationAddFace( RuleSet* _ruleset, const char* _ref )
-    : Operation( _ruleset ), ref( _ref ) { };
-  int runMesh( Mesh* mesh, int face );
+  OperationAddFace( const RuleSet* _ruleset, Arena& arena, const char* _ref )
+    : Operation( _ruleset ), ref( arena.copy( _ref ) ), rule( NULL ) { };
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  int resume( ExecutionContext& context, Mesh* mesh, int face, int result ) const;
+  bool link( Arena& arena, const String& owner );
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_ADDFACE ); out.writeString( ref ); }
 };
 
 class OperationMultiFace : public Operation {
 public:
-  OperationMultiFace( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face );
+  OperationMultiFace( const RuleSet* _ruleset ) : Operation( _ruleset ) { };
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_MULTIFACE ); }
 };
 
 class OperationSpawn : public Operation {
-  String ref;
+  const char* ref;
+  const Rule* rule;
 public:
-  OperationSpawn( RuleSet* _ruleset, const char* _ref )
-    : Operation( _ruleset ), ref( _ref ) { };
-  int runMesh( Mesh* mesh, int face );
+  OperationSpawn( const RuleSet* _ruleset, Arena& arena, const char* _ref )
+    : Operation( _ruleset ), ref( arena.copy( _ref ) ), rule( NULL ) { };
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  bool link( Arena& arena, const String& owner );
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_SPAWN ); out.writeString( ref ); }
 };
 
 class OperationUnchamfer : public Operation {
 public:
-  OperationUnchamfer( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face ) {
-    size_t size = mesh->getFace(face)->size();
+  OperationUnchamfer( const RuleSet* _ruleset ) : Operation( _ruleset ) { };
+  int runMesh( ExecutionContext&, Mesh* mesh, int face ) const {
+    size_t size = mesh->getFace( face ).size();
     for ( size_t i = 0; i < size_t( size / 2 ); i++ ) {
       mesh->weldVertices(
-        mesh->getFace( face )->getVertex( i ),
-        mesh->getFace( face )->getVertex( i+1 )
+        mesh->getFace( face ).getVertex( i ),
+        mesh->getFace( face ).getVertex( i+1 )
       );
     }
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_UNCHAMFER ); }
 };
 
 class OperationFree : public Operation {
 public:
-  OperationFree( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face ) {
+  OperationFree( const RuleSet* _ruleset ) : Operation( _ruleset ) { };
+  int runMesh( ExecutionContext&, Mesh* mesh, int face ) const {
     mesh->freeFace( face );
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_FREE ); }
 };
 
 class OperationDriveThrough : public Operation {
 public:
-  OperationDriveThrough( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face ) {
+  OperationDriveThrough( const RuleSet* _ruleset ) : Operation( _ruleset ) { };
+  int runMesh( ExecutionContext&, Mesh* mesh, int face ) const {
     mesh->setPassable();
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_DRIVETHROUGH ); }
 };
 
 class OperationRemove : public Operation {
 public:
-  OperationRemove( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face ) {
-    mesh->getFace( face )->setOutput( false );
+  OperationRemove( const RuleSet* _ruleset ) : Operation( _ruleset ) { };
+  int runMesh( ExecutionContext&, Mesh* mesh, int face ) const {
+    mesh->getFace( face ).setOutput( false );
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_REMOVE ); }
 };
 
 class OperationTextureFull : public Operation {
 public:
-  OperationTextureFull( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face ) {
+  OperationTextureFull( const RuleSet* _ruleset ) : Operation( _ruleset ) { };
+  int runMesh( ExecutionContext&, Mesh* mesh, int face ) const {
     mesh->textureFaceFull( face );
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_TEXTUREFULL ); }
 };
 
 class OperationTextureClear : public Operation {
 public:
-  OperationTextureClear( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face ) {
-    mesh->getFace( face )->clearTexCoords();
+  OperationTextureClear( const RuleSet* _ruleset ) : Operation( _ruleset ) { };
+  int runMesh( ExecutionContext&, Mesh* mesh, int face ) const {
+    mesh->getFace( face ).clearTexCoords();
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_TEXTURECLEAR ); }
 };
 
 class OperationTexture : public Operation {
+  int snap;
+  int textile;
 public:
-  OperationTexture( RuleSet* _ruleset ) : Operation( _ruleset ) { };
-  int runMesh( Mesh* mesh, int face );
+  OperationTexture( RuleSet* _ruleset );
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_TEXTURE ); }
 };
 
 class OperationTextureQuad : public OperationQuad {
 public:
-  OperationTextureQuad( RuleSet* _ruleset, Expression* exp0, Expression* exp1, Expression* exp2, Expression* exp3 )
+  OperationTextureQuad( const RuleSet* _ruleset, Expression* exp0, Expression* exp1, Expression* exp2, Expression* exp3 )
     : OperationQuad( _ruleset, exp0, exp1, exp2, exp3 ) { };
-  int runMesh( Mesh* mesh, int face ) {
-    flatten( mesh, face );
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+    double value[4];
+    flatten( context, mesh, face, value );
     mesh->textureFaceQuad( face, value[0], value[1], value[2], value[3] );
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_TEXTUREQUAD ); writeExpressions( out ); }
 };
 
 class OperationScale : public OperationDouble {
 public:
-  OperationScale(RuleSet* _ruleset, Expression* x, Expression* y)
+  OperationScale(const RuleSet* _ruleset, Expression* x, Expression* y)
     : OperationDouble(_ruleset, x, y ) { };
-  int runMesh( Mesh* mesh, int face ) {
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
     if (mesh == NULL) return 0;
-    flatten( mesh, face );
+    double value[2];
+    flatten( context, mesh, face, value );
     mesh->scaleFace( face, value[0], value[1] );
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_SCALE ); writeExpressions( out ); }
 };
 
 class OperationTranslate : public OperationTriple {
 public:
-  OperationTranslate(RuleSet* _ruleset, Expression* x, Expression* y, Expression* z)
+  OperationTranslate(const RuleSet* _ruleset, Expression* x, Expression* y, Expression* z)
     : OperationTriple( _ruleset, x, y, z ) { };
-  int runMesh( Mesh* mesh, int face ) {
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
     if (mesh == NULL) return 0;
-    flatten( mesh, face );
+    double value[3];
+    flatten( context, mesh, face, value );
     mesh->translateFace( face, value[0], value[1], value[2] );
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_TRANSLATE ); writeExpressions( out ); }
 };
 
 class OperationTranslateR : public OperationTriple {
 public:
-  OperationTranslateR(RuleSet* _ruleset, Expression* x, Expression* y, Expression* z)
+  OperationTranslateR(const RuleSet* _ruleset, Expression* x, Expression* y, Expression* z)
     : OperationTriple( _ruleset, x, y, z ) { };
-  int runMesh( Mesh* mesh, int face ) {
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
     if (mesh == NULL) return 0;
+    double value[3];
+    flatten( context, mesh, face, value );
     mesh->translateFace( face, value[0]*mesh->faceH(face),
                                value[1]*mesh->faceV(face),
                                value[2]*mesh->faceCenter(face).z);
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_TRANSLATER ); writeExpressions( out ); }
 };
 
 
 class OperationNGon : public OperationDouble {
 public:
-  OperationNGon(RuleSet* _ruleset, Expression* _exp, Expression* _nsize = NULL)
+  OperationNGon(const RuleSet* _ruleset, Expression* _exp, Expression* _nsize = NULL)
     : OperationDouble( _ruleset, _exp, _nsize ) {}
-  int runMesh( Mesh* mesh,int face) {
-    flatten( mesh, face );
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+    double value[2];
+    flatten( context, mesh, face, value );
     mesh->freeFace(face);
 
     int sides = math::roundToInt( value[0] );
@@ -265,128 +316,163 @@ public:
 
     return face;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_NGON ); writeExpressions( out ); }
 };
 
 class OperationAssert : public OperationSingle {
 public:
-  OperationAssert( RuleSet* _ruleset, Expression* _exp )
+  OperationAssert( const RuleSet* _ruleset, Expression* _exp )
     : OperationSingle( _ruleset, _exp ) { }
-  int runMesh( Mesh* mesh, int face ) {
-    flatten( mesh, face );
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+    double value[1];
+    flatten( context, mesh, face, value );
     return value[0] >= 0.0 ? face : -1;
   }
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_ASSERT ); writeExpressions( out ); }
 };
 
 class OperationAssign : public OperationSingle {
 protected:
-  String attrname;
+  int slot;
 public:
-  OperationAssign( RuleSet* _ruleset, Expression* _exp, const char* _attrname )
-    : OperationSingle( _ruleset, _exp ), attrname( _attrname ) { }
-  int runMesh( Mesh*, int face );
+  OperationAssign( RuleSet* _ruleset, Expression* _exp, const char* _attrname );
+  int runMesh( ExecutionContext& context, Mesh*, int face ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_ASSIGN ); writeExpressions( out ); out.writeAttr( slot ); }
 };
 
 
 class OperationMaterial : public OperationSingle {
 public:
-  OperationMaterial( RuleSet* _ruleset, Expression* _exp )
+  OperationMaterial( const RuleSet* _ruleset, Expression* _exp )
     : OperationSingle( _ruleset, _exp ) { }
-  int runMesh( Mesh* mesh, int face ) {
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
     if ( mesh == NULL ) return 0;
-    flatten( mesh, face );
-    mesh->getFace( face )->setMaterial( math::roundToInt( value[0] ) );
+    double value[1];
+    flatten( context, mesh, face, value );
+    mesh->getFace( face ).setMaterial( math::roundToInt( value[0] ) );
     return face;
   };
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_MATERIAL ); writeExpressions( out ); }
 };
 
 class OperationExpand : public OperationSingle {
 public:
-  OperationExpand( RuleSet* _ruleset, Expression* _exp )
+  OperationExpand( const RuleSet* _ruleset, Expression* _exp )
     : OperationSingle( _ruleset, _exp ) { }
-  int runMesh( Mesh* mesh,int face ) {
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
     if ( mesh == NULL ) return 0;
-    flatten( mesh, face );
+    double value[1];
+    flatten( context, mesh, face, value );
     mesh->expandFace( face, value[0] );
     return face;
   };
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_EXPAND ); writeExpressions( out ); }
 };
 
 class OperationTaper : public OperationSingle {
 public:
-  OperationTaper( RuleSet* _ruleset, Expression* _exp )
+  OperationTaper( const RuleSet* _ruleset, Expression* _exp )
     : OperationSingle( _ruleset, _exp ) { }
-  int runMesh(Mesh* mesh,int face) {
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
     if ( mesh == NULL ) return 0;
-    flatten( mesh, face );
+    double value[1];
+    flatten( context, mesh, face, value );
     mesh->taperFace( face, value[0] );
     return face;
   };
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_TAPER ); writeExpressions( out ); }
 };
 
 class OperationChamfer : public OperationSingle {
 public:
-  OperationChamfer( RuleSet* _ruleset, Expression* _exp )
+  OperationChamfer( const RuleSet* _ruleset, Expression* _exp )
     : OperationSingle( _ruleset, _exp ) { }
-  int runMesh( Mesh* mesh, int face ) {
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
     if ( mesh == NULL ) return 0;
-    flatten( mesh, face );
+    double value[1];
+    flatten( context, mesh, face, value );
     mesh->chamferFace( face, value[0] );
     return face;
   };
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_CHAMFER ); writeExpressions( out ); }
 };
 
 class OperationMultifaces : public OperationSingle {
 protected:
-  StringVector* facerules;
+  // names of the face rules, NULL if there are none
+  const char** facerules;
+  // rules of facerules after linking, NULL for skipped faces
+  const Rule** facerefs;
+  int facecount;
   bool allsame;
 public:
-  OperationMultifaces( RuleSet* _ruleset, Expression* _exp, StringVector* _facerules );
-  int runMesh( Mesh* mesh, int, IntVector* faces );
-  ~OperationMultifaces() {
-    deletePointer( facerules );
-  }
+  // takes the face rules, which are copied into the arena and freed
+  OperationMultifaces( const RuleSet* _ruleset, Arena& arena, Expression* _exp, StringVector* _facerules );
+  // schedules the face rules on the passed faces
+  int runMesh( ExecutionContext& context, Mesh* mesh, int, IndexVector* faces ) const;
+  bool link( Arena& arena, const String& owner );
+  // writes the expression and the face rules, as passed to the constructor
+  void writeFaces( GrammarWriter& out ) const;
 };
 
 class OperationDetachFace : public OperationMultifaces {
 public:
-  OperationDetachFace( RuleSet* _ruleset, Expression* _exp, StringVector* _facerules )
-    : OperationMultifaces( _ruleset, _exp, _facerules ) { }
-  int runMesh( Mesh* mesh, int face );
+  OperationDetachFace( const RuleSet* _ruleset, Arena& arena, Expression* _exp, StringVector* _facerules )
+    : OperationMultifaces( _ruleset, arena, _exp, _facerules ) { }
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_DETACHFACE ); writeFaces( out ); }
 };
 
 
 class OperationExtrude : public OperationMultifaces {
 public:
-  OperationExtrude( RuleSet* _ruleset, Expression* _exp, StringVector* facerules )
-    : OperationMultifaces( _ruleset, _exp, facerules ) { }
-  int runMesh( Mesh* mesh, int face );
+  OperationExtrude( const RuleSet* _ruleset, Arena& arena, Expression* _exp, StringVector* facerules )
+    : OperationMultifaces( _ruleset, arena, _exp, facerules ) { }
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_EXTRUDE ); writeFaces( out ); }
 };
 
 class OperationExtrudeT : public OperationMultifaces {
+  int snap;
+  int textile;
 public:
-  OperationExtrudeT( RuleSet* _ruleset, Expression* _exp, StringVector* facerules )
-    : OperationMultifaces( _ruleset, _exp, facerules ) { }
-  int runMesh( Mesh* mesh, int face );
+  OperationExtrudeT( RuleSet* _ruleset, Arena& arena, Expression* _exp, StringVector* facerules );
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void write( GrammarWriter& out ) const { out.writeInt( GrammarWriter::OP_EXTRUDET ); writeFaces( out ); }
 };
 
 class OperationSplitFace : public OperationMultifaces {
   bool horiz;
-  ExpressionVector* splits;
-public:
-  OperationSplitFace( RuleSet* _ruleset, bool _horiz, StringVector* facerules, ExpressionVector* _splits, Expression* _esnap = NULL)
-    : OperationMultifaces( _ruleset, _esnap, facerules ), horiz( _horiz ), splits( _splits ) {}
-  int runMesh( Mesh* mesh, int face );
-  ~OperationSplitFace() {
-    deletePointerVector( splits );
+  Expression** splits;
+  int splitcount;
+public:
+  // takes the splits, which are copied into the arena and freed
+  OperationSplitFace( const RuleSet* _ruleset, Arena& arena, bool _horiz, StringVector* facerules, ExpressionVector* _splits, Expression* _esnap = NULL)
+    : OperationMultifaces( _ruleset, arena, _esnap, facerules ), horiz( _horiz ), 
+      splits( arena.copy( *_splits ) ), splitcount( int( _splits->size() ) ) {
+    delete _splits;
+  }
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  bool link( Arena& arena, const String& owner );
+  void write( GrammarWriter& out ) const {
+    out.writeInt( GrammarWriter::OP_SPLITFACE );
+    out.writeInt( horiz );
+    out.writeExpressions( splits, splitcount );
+    writeFaces( out );
   }
 };
 
 class OperationRepeat : public OperationMultifaces {
   bool horiz;
 public:
-  OperationRepeat( RuleSet* _ruleset, Expression* _exp, bool _horiz, StringVector* facerules )
-    : OperationMultifaces( _ruleset, _exp, facerules ), horiz( _horiz ) {}
-  int runMesh( Mesh* mesh, int face );
+  OperationRepeat( const RuleSet* _ruleset, Arena& arena, Expression* _exp, bool _horiz, StringVector* facerules )
+    : OperationMultifaces( _ruleset, arena, _exp, facerules ), horiz( _horiz ) {}
+  int runMesh( ExecutionContext& context, Mesh* mesh, int face ) const;
+  void write( GrammarWriter& out ) const {
+    out.writeInt( GrammarWriter::OP_REPEAT );
+    out.writeInt( horiz );
+    writeFaces( out );
+  }
 };
 
 
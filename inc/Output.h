@@ -18,8 +18,9 @@
 #ifndef __OUTPUT_H__
 #define __OUTPUT_H__
 
+#include <cstring>
 #include "globals.h"
-#include "Face.h"
+#include "AsyncWriter.h"
 
 /**
  * @class Output
@@ -28,12 +29,30 @@
  * Currently server as an abstraction over the BZW world format. Properly
  * rewritten (or made into an interface) could be used to output to any 
  * kind of output format.
+ *
+ * The text is formatted into a private buffer, and written to the stream
+ * in BUFFER_SIZE chunks. Numbers don't go through the stream either --
+ * they are formatted locale free, doubles with a fixed number of decimal
+ * places, see put().
+ *
+ * An Output created without a stream keeps all of the text in memory,
+ * growing the buffer as needed. It's used to serialize a zone on a worker
+ * thread, the text and the counters are then moved into the stream's 
+ * Output by append(), so the counters written by footer() are those of
+ * all the appended zones.
+ *
+ * An Output created with an AsyncWriter fills the writer's buffers 
+ * instead, and hands them to it's thread as they fill up.
  */
 class Output {
   /**
    * The passed outstream to which data will be written.
    */
   OutStream* outstream;
+  /**
+   * The writer the buffers are handed to, NULL if writing to a stream.
+   */
+  AsyncWriter* writer;
   /**
    * URL to the textures, BZW specific.
    */
@@ -50,99 +69,194 @@ class Output {
    * Number of written faces.
    */
   int faces;
+  /**
+   * Decimal places written for doubles.
+   */
+  int precision;
+  /**
+   * The output buffer, it's size and the number of bytes used.
+   */
+  char* buffer;
+  size_t capacity;
+  size_t used;
+  /**
+   * Number of times the buffer of an Output without a stream was grown,
+   * copying the text.
+   */
+  int grows;
 public:
-  Output(OutStream* _outstream, String _texturepath) : outstream(_outstream), texturepath(_texturepath ), vertices(0), texcoords(0), faces(0) {}
+  /** Size of the output buffer. */
+  static const size_t BUFFER_SIZE = 1 << 20;
+  /** Default number of decimal places, see put(). */
+  static const int DEFAULT_PRECISION = 4;
+  /** Maximum number of decimal places. */
+  static const int MAX_PRECISION = 9;
+  /** Size of the first buffer of an Output without a stream. */
+  static const size_t CHUNK_SIZE = 1 << 16;
+  Output(OutStream* _outstream, String _texturepath, int _precision = DEFAULT_PRECISION);
+  /**
+   * Constructor of an Output writing through the passed AsyncWriter.
+   */
+  Output(AsyncWriter* _writer, String _texturepath, int _precision = DEFAULT_PRECISION);
+  /**
+   * Constructor of an Output without a stream, keeping the text in memory
+   * until it's append()ed to another one.
+   */
+  Output(String _texturepath, int _precision = DEFAULT_PRECISION);
+  /** Destructor, flushes the buffer. */
+  ~Output();
+  /**
+   * Writes the buffered text to the stream, or hands the buffer to the
+   * writer. Does nothing if there's neither.
+   */
+  void flush();
+  /**
+   * Writes the text of the other Output, and adds it's counters to ours.
+   * The other Output is left empty. Text of half the buffer size and 
+   * more is written to the stream as it is, without copying it into the
+   * buffer.
+   */
+  void append(Output& other);
+  /**
+   * Hands the text of an Output without a stream over to the caller,
+   * without copying it. Returns the NUL terminated text, to be freed with
+   * delete[], and sets size to it's length. The Output starts a new 
+   * buffer.
+   */
+  char* detach(size_t& size);
+  /**
+   * Returns the number of times the text was copied into a larger buffer.
+   */
+  int getGrowCount() const {
+    return grows;
+  }
+  /**
+   * Returns the URL to the textures.
+   */
+  const String& getTexturePath() const {
+    return texturepath;
+  }
+  /**
+   * Returns the number of decimal places written for doubles.
+   */
+  int getPrecision() const {
+    return precision;
+  }
+  /**
+   * Returns the number of bytes buffered.
+   */
+  size_t size() const {
+    return used;
+  }
   void meshStart() { 
-    (*outstream) << "mesh\n"; 
+    (*this) << "mesh\n"; 
   }
   void meshEnd() { 
-    (*outstream) << "end\n\n"; 
+    (*this) << "end\n\n"; 
   }
   void meshPassable() { 
-    (*outstream) << " passable\n"; 
+    (*this) << " passable\n"; 
   }
   void vertex(Vertex v) { 
     vertices++;
-    (*outstream) << "  vertex " << v.x << " " << v.y << " " << v.z << "\n"; 
+    (*this) << "  vertex " << v.x << " " << v.y << " " << v.z << "\n"; 
   }
   void vertex(Vertex v, const char* name) { 
     vertices++;
-    (*outstream) << "  " << name << " " << v.x << " " << v.y << " " << v.z << "\n"; 
+    (*this) << "  " << name << " " << v.x << " " << v.y << " " << v.z << "\n"; 
   }
   void texCoord(TexCoord tc) { 
     texcoords++;
-    (*outstream) << "  texcoord " << tc.x << " " << tc.y << "\n"; 
-  }
-  void face(Face* f, int lastmat = -1) { 
-    if (!f->outputable()) return;
-    faces++;
-    (*outstream) << "  face\n";
-
-    if (lastmat >= 0) {
-      if (f->getMaterial() != lastmat) matref(f->getMaterial());
-    }
-
-    (*outstream) << "    vertices ";
-    for (size_t i = 0; i < f->size(); i++) {
-      (*outstream) << f->getVertex( i ) << " ";
-    }
-    (*outstream) << "\n";
-
-    if (f->hasTexCoords()) {
-      (*outstream) << "    texcoords ";
-      for (size_t i = 0; i < f->size(); i++) {
-        (*outstream) << f->getTexCoord( i ) << " ";
-      }
-      (*outstream) << "\n";
-    }
-
-    (*outstream) << "  endface\n";
+    (*this) << "  texcoord " << tc.x << " " << tc.y << "\n"; 
   }
+  /**
+   * Writes a face with the given vertex and texcoord indices, the
+   * texcoords are left out if empty. A matref is written before it if
+   * it's material differs from lastmat.
+   */
+  void face(const IntVector& vertices, const IntVector& texcoords, int material, int lastmat = -1);
   void matref(int matref) { 
-    (*outstream) << "  matref mat" << matref << "\n";
+    (*this) << "  matref mat" << matref << "\n";
   }
   void footer() {
-    (*outstream) << "\n\n# end of world\n";
-    (*outstream) << "# " << vertices <<" vertices\n";
-    (*outstream) << "# " << texcoords <<" texcoords\n";
-    (*outstream) << "# " << faces <<" faces\n\n";
-  }
-  void material(int matref, String& filename, bool noradar) { 
-    (*outstream) << "material\n";
-    (*outstream) << "  name mat" << matref << "\n";
-    (*outstream) << "  texture " << texturepath << filename;
-    if (texturepath.size() > 0) { (*outstream) << ".png"; }
-    (*outstream)  << "\n";
-    if (noradar) (*outstream) << "  noradar\n";
-    (*outstream) << "end\n\n";
+    (*this) << "\n\n# end of world\n";
+    (*this) << "# " << vertices <<" vertices\n";
+    (*this) << "# " << texcoords <<" texcoords\n";
+    (*this) << "# " << faces <<" faces\n\n";
+  }
+  void material(int matref, const String& filename, bool noradar) { 
+    (*this) << "material\n";
+    (*this) << "  name mat" << matref << "\n";
+    (*this) << "  texture " << texturepath << filename;
+    if (texturepath.size() > 0) { (*this) << ".png"; }
+    (*this)  << "\n";
+    if (noradar) (*this) << "  noradar\n";
+    (*this) << "end\n\n";
   }
   void baseZone(Vertex A, Vertex B, int color, bool ctfSafe) { 
-    (*outstream) << "base\n";
-    (*outstream) << "  position " << (A.x+B.x)/2 << " " << (A.y+B.y)/2 << " 0\n";
-    (*outstream) << "  size " << fabs(A.x-B.x)/2 << " " << fabs(A.y-B.y)/2 << " 0\n";
-    (*outstream) << "  color " << color << "\n";
-    (*outstream) << "end\n\n";
+    (*this) << "base\n";
+    (*this) << "  position " << (A.x+B.x)/2 << " " << (A.y+B.y)/2 << " 0\n";
+    (*this) << "  size " << fabs(A.x-B.x)/2 << " " << fabs(A.y-B.y)/2 << " 0\n";
+    (*this) << "  color " << color << "\n";
+    (*this) << "end\n\n";
 
     if( ctfSafe ) {
-      (*outstream) << "zone\n";
-      (*outstream) << "  position " << (A.x+B.x)/2 << " " << (A.y+B.y)/2 << " 0\n";
-      (*outstream) << "  size " << fabs(A.x-B.x)/2 << " " << fabs(A.y-B.y)/2 << " 0\n";
-      (*outstream) << "  safety " << color << "\n";
-      (*outstream) << "end\n\n";
+      (*this) << "zone\n";
+      (*this) << "  position " << (A.x+B.x)/2 << " " << (A.y+B.y)/2 << " 0\n";
+      (*this) << "  size " << fabs(A.x-B.x)/2 << " " << fabs(A.y-B.y)/2 << " 0\n";
+      (*this) << "  safety " << color << "\n";
+      (*this) << "end\n\n";
     }
   }
   void header(int size) { 
-    (*outstream) << "world\n";
-    (*outstream) << "  name BZWGen Generated City\n";
-    (*outstream) << "  size " << int(size / 2) << "\n";
-    (*outstream) << "end\n\n";
+    (*this) << "world\n";
+    (*this) << "  name BZWGen Generated City\n";
+    (*this) << "  size " << int(size / 2) << "\n";
+    (*this) << "end\n\n";
   }
   void info(int major, int minor, int revision) { 
-    (*outstream) << "#\n# BZWGen (" << major << "." << minor << "." << revision << ") generated map file\n#\n\n";  
+    (*this) << "#\n# BZWGen (" << major << "." << minor << "." << revision << ") generated map file\n#\n\n";  
+  }
+private:
+  /** Output isn't copyable, it owns the buffer. */
+  Output(const Output&);
+  Output& operator=(const Output&);
+  /**
+   * Appends the bytes to the buffer, flushing it first if they don't
+   * fit. Blocks bigger than the buffer are written directly, or split
+   * over the writer's buffers. Without a stream or writer the buffer 
+   * grows instead.
+   */
+  void put(const char* data, size_t size);
+  /**
+   * Appends an int.
+   */
+  void put(int value);
+  /**
+   * Appends a double rounded to precision decimal places, as printf's
+   * "%.*f" would, but with trailing zeros and the point left out. Values
+   * of 1e15 and up are written with 17 significant digits.
+   */
+  void put(double value);
+  Output& operator<<(const char* text) {
+    put(text, strlen(text));
+    return *this;
+  }
+  Output& operator<<(const String& text) {
+    put(text.c_str(), text.size());
+    return *this;
+  }
+  Output& operator<<(int value) {
+    put(value);
+    return *this;
+  }
+  Output& operator<<(double value) {
+    put(value);
+    return *this;
   }
 };
 
-#endif /* __(*outstream)PUT_H__ */
+#endif /* __OUTPUT_H__ */
 
 // Local Variables: ***
 // mode:C++ ***
@@ -20,6 +20,7 @@
 #include "Operation.h"
 #include "Expression.h"
 #include "Mesh.h"
+#include "Arena.h"
 
 /**
  * @class Product
@@ -31,10 +32,14 @@
  */
 class Product {
   /**
-   * A vector of operations for the given product, that are to be executed
-   * sequentially.
+   * An array of operations for the given product, that are to be executed
+   * sequentially. Allocated from the grammar's arena.
    */
-  OperationVector* operations;
+  Operation** operations;
+  /**
+   * Number of operations.
+   */
+  int count;
   /**
    * Rarity of the given product. The rarities of all the products in a
    * given rule should sum up to 1.0.
@@ -48,41 +53,74 @@ class Product {
 public:
   /**
    * Constructor, to be called by the parser. Takes the vector of operations,
-   * a rarity and condition. Initializes data, does nothing.
+   * which is copied into the arena and freed, a rarity and condition. The 
+   * product is allocated from the same arena.
+   */
+  Product( Arena& arena, OperationVector* _operations, double _rarity, Expression* _condition = NULL )
+    : operations( arena.copy( *_operations ) ), count( int( _operations->size() ) ), 
+      rarity( _rarity ), condition( _condition ) {
+    delete _operations;
+  }
+  /**
+   * Returns the number of operations. The operations are run in sequence
+   * by ExecutionContext::derive, each on the face returned by the 
+   * previous one, and the product fails if any of them returns -1.
+   */
+  int operationCount() const {
+    return count;
+  }
+  /**
+   * Returns the operation at the given index.
    */
-  Product( OperationVector* _operations, double _rarity, Expression* _condition = NULL )
-    : operations( _operations ), rarity( _rarity ), condition( _condition ) {};
+  const Operation* getOperation( int index ) const {
+    return operations[index];
+  }
   /**
-   * Run the sequence of operations on the given mesh and the given face.
-   * returns the face ID of the last result, or -1 if an error is encountered.
+   * Links the rule references of all the operations, and compiles the
+   * expressions into the arena. Owner is the name of the rule the product
+   * belongs to. Returns false if any reference couldn't be resolved.
    */
-  int runMesh( Mesh* mesh, int face ) {
-    for ( size_t i = 0; i < operations->size(); i++ ) {
-      face = operations->at( i )->runMesh( mesh, face );
-      if ( face == -1 ) return -1;
-    }
-    return face;
+  bool link( Arena& arena, const String& owner ) {
+    condition = ExpressionProgram::compileTree( arena, condition );
+    // a condition that always holds is no condition, which lets the rule
+    // put the product into it's selection table
+    double value;
+    if ( condition != NULL && condition->isConstant( value ) && value >= 0.0 )
+      condition = NULL;
+    bool result = true;
+    for ( int i = 0; i < count; i++ )
+      if ( !operations[i]->link( arena, owner ) ) result = false;
+    return result;
   }
   /**
    * Checks wether the conditions that were assigned to this product are
    * met. If no conditions are assigned, returns true.
    */
-  bool conditionsMet( Mesh* mesh, int face ) {
-    return condition == NULL ? true : ( condition->calculate( mesh,face ) >= 0.0 );
+  bool conditionsMet( ExecutionContext& context, Mesh* mesh, int face ) const {
+    return condition == NULL ? true : ( condition->calculate( context, mesh, face ) >= 0.0 );
+  }
+  /**
+   * Returns wether the product has a condition.
+   */
+  bool isConditional() const {
+    return condition != NULL;
   }
   /**
    * Rarity value accessor.
    */
-  double getRarity() {
+  double getRarity() const {
     return rarity;
   }
   /**
-   * Destructor, frees all operations, and disposes of the operation
-   * vector. Frees condition if present.
+   * Writes the product into a grammar image. Only valid before linking,
+   * which compiles the expressions.
    */
-  ~Product() {
-    deletePointerVector( operations );
-    deletePointer( condition );
+  void write( GrammarWriter& out ) const {
+    out.writeDouble( rarity );
+    out.writeExpression( condition );
+    out.writeInt( count );
+    for ( int i = 0; i < count; i++ )
+      operations[i]->write( out );
   }
 private:
   /**
@@ -18,36 +18,96 @@
 #ifndef __RANDOM_H__
 #define __RANDOM_H__
 
-#include <algorithm>
-
 /** 
  * @class Random
- * @brief Random number generation helper functions class.
+ * @brief Random number generation helper class.
  *
- * If the need arises, this file will also hold the mt1997 random number
- * generator implementation. The class is completely static as for the moment. 
+ * Each Random object is an independent random number stream, so that
+ * concurrent derivations don't share (and race on) the global rand()
+ * state. The generator is xoshiro128**, seeded through a splitmix32
+ * sequence. A stream is identified by a seed and a stream number, so the
+ * world seed together with the zone index gives every zone it's own
+ * reproducible stream. Requires unsigned int to be 32 bits wide.
  */
 class Random 
 {
+  /** Current generator state, never all zero. */
+  unsigned int state[4];
+  /** Rotates x left by k bits. */
+  static inline unsigned int rotl( unsigned int x, int k ) {
+    return ( x << k ) | ( x >> ( 32 - k ) );
+  }
+  /** Advances the splitmix32 sequence x and returns it's next output. */
+  static inline unsigned int splitmix( unsigned int& x ) {
+    unsigned int z = ( x += 0x9e3779b9u );
+    z = ( z ^ ( z >> 16 ) ) * 0x85ebca6bu;
+    z = ( z ^ ( z >> 13 ) ) * 0xc2b2ae35u;
+    return z ^ ( z >> 16 );
+  }
+  /** 
+   * Returns a number from the 0..range-1 range, without the modulo bias.
+   * Range must be positive. 
+   */
+  inline unsigned int uniform( unsigned int range ) {
+    // 2^32 mod range -- numbers below that are rejected, so that every
+    // result has the same number of preimages
+    unsigned int limit = ( 0u - range ) % range;
+    unsigned int r;
+    do r = next(); while ( r < limit );
+    return r % range;
+  }
 public:
+  /** Maximum value returned by next(). */
+  static const unsigned int MAX = 0xffffffffu;
+  /** Creates the given stream of the given seed. */
+  explicit Random( unsigned int _seed = 1, unsigned int stream = 0 ) { 
+    seed( _seed, stream ); 
+  }
+  /** 
+   * Reseeds the generator. Different streams of the same seed are 
+   * independent of each other. 
+   */
+  inline void seed( unsigned int _seed, unsigned int stream = 0 ) { 
+    unsigned int x = stream;
+    x = _seed ^ splitmix( x );
+    for ( int i = 0; i < 4; i++ ) state[i] = splitmix( x );
+    if ( ( state[0] | state[1] | state[2] | state[3] ) == 0 ) state[0] = 1;
+  }
+  /** Returns the next raw number from the 0..MAX range. */
+  inline unsigned int next() { 
+    unsigned int result = rotl( state[1] * 5, 7 ) * 9;
+    unsigned int t = state[1] << 9;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl( state[3], 11 );
+    return result;
+  }
+
   /** @name Integer randomization */
   /** Returns either 0 or 1 with a 50/50 chance. */
-  static inline int number01() { 
-    return rand()%2; 
+  inline int number01() { 
+    return int( next() >> 31 ); 
   }
-  /** Returns a number from the 0..range-1 range. */
-  static inline int numberMax( int range ) { 
-    return (range == 0) ? 0 : rand()%range; 
+  /** 
+   * Returns a number from the 0..range-1 range. A negative range gives
+   * a number from the 0..-range-1 range. 
+   */
+  inline int numberMax( int range ) { 
+    if ( range == 0 ) return 0;
+    return int( uniform( range < 0 ? 0u - (unsigned int)range : (unsigned int)range ) );
   }
   /** Returns a number from the min..max-1 range. */
-  static inline int numberRange( int min, int max ) { 
+  inline int numberRange( int min, int max ) { 
     return numberMax(max-min)+min; 
   }
   /** 
    * Returns a number from the min..max-1 range, the resultant number will be one 
    * that is a multiple of step in the given range. 
    */
-  static inline int numberRangeStep( int min, int max, int step ) { 
+  inline int numberRangeStep( int min, int max, int step ) { 
     if (step == 0) return 0; 
     int steps = int((max-min) / step);  
     return numberMax(steps+1)*step+min; 
@@ -55,22 +115,22 @@ public:
 
   /** @name Floating point randomization */
   /** Returns a floating point number from the 0..1 range. */
-  static inline double double01() { 
-    return (double)(rand()) / (double)(RAND_MAX); 
+  inline double double01() { 
+    return double( next() ) * ( 1.0 / double( MAX ) ); 
   }
   /** Returns a floating point number from the 0..range range. */
-  static inline double doubleMax( double range ) { 
+  inline double doubleMax( double range ) { 
     return double01()*range; 
   }
   /** Returns a floating point number from the min..max range. */
-  static inline double doubleRange( double min, double max ) { 
+  inline double doubleRange( double min, double max ) { 
     return doubleMax(max-min)+min; 
   }
   /** 
    * Returns a floating point number from the min..max-1 range, the resultant number will be one 
    * that is a multiple of step in the given range. 
    */
-  static inline double doubleRangeStep( double min, double max, double step ) { 
+  inline double doubleRangeStep( double min, double max, double step ) { 
     if (step == 0) return 0.0; 
    int steps = int((max-min) / step); 
     return numberMax(steps+1)*step + min; 
@@ -78,19 +138,19 @@ public:
 
   /** @name Boolean randomization */
   /** Returns a 50/50 chance as a boolean. */
-  static inline bool coin() { 
-    return rand()%2 == 0; 
+  inline bool coin() { 
+    return ( next() >> 31 ) == 0; 
   }
   /** Returns a percentage chance randomization as a boolean. */
-  static inline bool chance(int chance) { 
+  inline bool chance(int chance) { 
     return numberMax(100) < chance; 
   }
   /**
    * Returns a random sign, that is either 1 or -1 with a 50/50 
    * probability.
    */
-  static inline float sign() { 
-    return rand()%2 == 0 ? 1.0f : -1.0f; 
+  inline float sign() { 
+    return ( next() >> 31 ) == 0 ? 1.0f : -1.0f; 
   }
 };
 
@@ -21,6 +21,10 @@
 #include "globals.h"
 #include "Product.h"
 #include "Mesh.h"
+#include "Arena.h"
+
+/** Relative distance from a product boundary below which a roll is walked. */
+#define SELECTION_EPSILON 1e-9
 
 /**
  * @class Rule
@@ -36,39 +40,91 @@ class Rule {
    */
   String name;
   /**
-   * A vector of Product pointers, that this rule is made of.
+   * An array of Product pointers, that this rule is made of.
+   */
+  Product** products;
+  /**
+   * Number of products.
+   */
+  int count;
+  /**
+   * Product selection table, built by link(). Consecutive products
+   * without conditions form runs, and for every product this holds the
+   * index one past the end of the run starting at it. Products with a
+   * condition are a run of their own and hold their own index.
    */
-  ProductVector* products;
+  int* runEnd;
+  /**
+   * Cumulative rarities of the products within their run, so that the
+   * product a roll lands on can be found by binary search. Rolls within
+   * SELECTION_EPSILON of a boundary are walked product by product, which
+   * keeps the picks those of subtracting the rarities one by one.
+   */
+  double* cumulative;
 public:
   /**
-   * Standard constructor, only sets up members.
+   * Creates a rule in the arena. Takes the vector of products, which is
+   * copied into the arena and freed. The rule's name is the only thing
+   * of the grammar that needs a destructor, so the rule is registered 
+   * with the arena.
    */
-  Rule( const String& _name, ProductVector* _products )
-    : name( _name ), products( _products ) { };
+  static Rule* create( Arena& arena, const String& name, ProductVector* products ) {
+    return arena.own( new ( arena ) Rule( arena, name, products ) );
+  }
   /**
-   * Runs the rule on the passed mesh, on the passed face.
+   * Binds the rule references of the products to the rules of the 
+   * ruleset, and builds the product selection table in the arena. Returns
+   * false if any of the references is undefined.
    */
-  int runMesh( Mesh* mesh, int face );
+  bool link( Arena& arena );
   /**
    * Returns the name of the rule.
    */
-  String& getName() {
+  const String& getName() const {
     return name;
   }
   /**
-   * Standard destructor, deallocates all the stored products, and the
-   * product vector itself.
+   * Returns the position of the passed product in the rule, -1 if it
+   * doesn't belong to the rule.
    */
-  ~Rule() {
-    deletePointerVector( products );
-  };
-private:
+  int productIndex( const Product* product ) const {
+    for ( int i = 0; i < count; i++ )
+      if ( products[i] == product ) return i;
+    return -1;
+  }
   /**
    * Returns a product for the given mesh/face. The choice of product
    * is dependent on the rule, and may be based on a random pick, and/or
    * on conditions to the passed mesh/face.
+   *
+   * A single roll is consumed by the products in order, products whose
+   * conditions aren't met are skipped. Conditions are only evaluated when
+   * the roll reaches their product, and runs of unconditional products 
+   * are crossed by a binary search in the selection table.
+   */
+  Product* getProduct( ExecutionContext& context, Mesh* mesh, int face ) const;
+  /**
+   * Writes the rule and it's products into a grammar image.
+   */
+  void write( GrammarWriter& out ) const {
+    out.writeString( name );
+    out.writeInt( count );
+    for ( int i = 0; i < count; i++ )
+      products[i]->write( out );
+  }
+private:
+  /**
+   * Constructor, only create() makes rules.
+   */
+  Rule( Arena& arena, const String& _name, ProductVector* _products )
+    : name( _name ), products( arena.copy( *_products ) ), count( int( _products->size() ) ),
+      runEnd( NULL ), cumulative( NULL ) {
+    delete _products;
+  }
+  /**
+   * Blocked copy constructor.
    */
-  Product* getProduct( Mesh* mesh, int face );
+  Rule( const Rule& );
 };
 
 typedef std::map <String, Rule*> RuleMap;
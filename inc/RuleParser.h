@@ -0,0 +1,121 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file RuleParser.h
+ * @brief Reentrant parser of the BZWGen rule files.
+ */
+
+#ifndef __RULEPARSER_H__
+#define __RULEPARSER_H__
+
+#include "globals.h"
+#include "Arena.h"
+
+class RuleSet;
+class Rule;
+union _YYSTYPE;
+
+/**
+ * @class RuleParser
+ * @brief Parse state of a single rule file.
+ *
+ * The whole file is read into memory, scanned by lex() and parsed by the
+ * pure bison parser, which keeps no global state -- so any number of 
+ * files may be parsed at once, each by it's own RuleParser. The parsed
+ * rules aren't added to the ruleset right away, they're collected by the
+ * parser and added by commit(), so that files parsed concurrently still
+ * define their rules in file order. The grammar objects are allocated
+ * from the parser's own arena, which the ruleset takes over on commit.
+ * Attributes are interned into the ruleset while parsing, under a lock 
+ * shared by all the parsers.
+ */
+class RuleParser {
+  /** Name of the parsed file, used in error messages. */
+  String filename;
+  /** Contents of the file. */
+  String source;
+  /** Scanning position in source. */
+  size_t pos;
+  /** Current line, counted from 1. */
+  int line;
+  /** Ruleset the rules belong to. */
+  RuleSet* ruleset;
+  /** Arena the parsed grammar objects are allocated from. */
+  Arena arena;
+  /** The parsed rules, in order of definition. */
+  std::vector< std::pair< String, Rule* > > rules;
+  /** Identifiers handed to the parser, freed with the parser. */
+  std::vector< char* > identifiers;
+  /** Set once the file is read and parsed without errors. */
+  bool parsed;
+public:
+  /** Constructor, takes the file name and the ruleset to parse for. */
+  RuleParser( const String& _filename, RuleSet* _ruleset ) 
+    : filename( _filename ), pos( 0 ), line( 1 ), ruleset( _ruleset ), parsed( false ) {}
+  /**
+   * Reads and parses the file. Returns false if it couldn't be read, or
+   * had errors. Thread safe.
+   */
+  bool parse( );
+  /**
+   * Parses the passed text instead of a file, the file name is only used
+   * in error messages. Thread safe.
+   */
+  bool parse( const String& text );
+  /**
+   * Adds the parsed rules to the ruleset, which takes over the arena. 
+   * Not thread safe, files are committed in order once parsed.
+   */
+  void commit( );
+  /** Returns true if the file was parsed without errors. */
+  bool isParsed( ) const {
+    return parsed;
+  }
+  /** Returns the name of the parsed file. */
+  const String& getFilename( ) const {
+    return filename;
+  }
+  /** @name Parser callbacks */
+  /** Returns the ruleset the rules are created for. */
+  RuleSet* getRuleSet( ) {
+    return ruleset;
+  }
+  /** Returns the arena the grammar objects are allocated from. */
+  Arena& getArena( ) {
+    return arena;
+  }
+  /** Collects a parsed rule. */
+  void addRule( const String& name, Rule* rule ) {
+    rules.push_back( std::make_pair( name, rule ) );
+  }
+  /** Returns the next token, and sets it's value. */
+  int lex( _YYSTYPE* value );
+  /** Reports a parse error at the current line. */
+  void error( const char* message );
+  /** Destructor, the rules that weren't committed go with the arena. */
+  ~RuleParser( );
+private:
+  /** Returns a copy of the passed text, owned by the parser. */
+  char* identifier( const char* text, size_t length );
+  /** Blocked copy constructor. */
+  RuleParser( const RuleParser& );
+};
+
+#endif /* __RULEPARSER_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
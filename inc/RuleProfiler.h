@@ -0,0 +1,141 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file RuleProfiler.h
+ * @brief Per-rule profiling of grammar derivations.
+ */
+
+#ifndef __RULEPROFILER_H__
+#define __RULEPROFILER_H__
+
+#include <map>
+#include "globals.h"
+#include "Thread.h"
+
+class Rule;
+class Product;
+
+/**
+ * @struct ProfileCounters
+ * @brief Counters collected for a rule or a product.
+ *
+ * Times are in seconds. Exclusive time excludes the rules called by the
+ * rule, and the faces and vertices are those added to the rule's mesh by
+ * the rule's own operations.
+ */
+struct ProfileCounters {
+  /** Number of invocations. */
+  unsigned long calls;
+  /** Number of invocations that returned -1. */
+  unsigned long failures;
+  /** Wall time including called rules. */
+  double inclusive;
+  /** Wall time excluding called rules. */
+  double exclusive;
+  /** Faces added. */
+  long faces;
+  /** Vertices added. */
+  long vertices;
+  /** Constructor, zeroes the counters. */
+  ProfileCounters( ) : calls( 0 ), failures( 0 ), inclusive( 0.0 ), exclusive( 0.0 ), faces( 0 ), vertices( 0 ) {}
+  /** Adds the passed counters to these. */
+  void add( const ProfileCounters& other ) {
+    calls     += other.calls;
+    failures  += other.failures;
+    inclusive += other.inclusive;
+    exclusive += other.exclusive;
+    faces     += other.faces;
+    vertices  += other.vertices;
+  }
+};
+
+/**
+ * @class RuleProfile
+ * @brief Profile counters of a set of derivations.
+ *
+ * A profile is filled by a single ExecutionContext, so it isn't locked.
+ * Profiles of separate derivations are merged into the RuleProfiler.
+ */
+class RuleProfile {
+public:
+  /** Counters of a rule and of each of it's chosen products. */
+  struct Entry {
+    ProfileCounters counters;
+    std::map< const Product*, ProfileCounters > products;
+  };
+  /** Type definition for the rule to entry map. */
+  typedef std::map< const Rule*, Entry > EntryMap;
+private:
+  /** The collected counters. */
+  EntryMap entries;
+public:
+  /**
+   * Records a single invocation of the rule, that picked the passed
+   * product -- NULL if it had none to pick.
+   */
+  void record( const Rule* rule, const Product* product, const ProfileCounters& sample ) {
+    Entry& entry = entries[rule];
+    entry.counters.add( sample );
+    if ( product != NULL ) entry.products[product].add( sample );
+  }
+  /** Adds the counters of the passed profile to this one. */
+  void merge( const RuleProfile& other );
+  /** Returns the collected counters. */
+  const EntryMap& getEntries( ) const {
+    return entries;
+  }
+};
+
+/**
+ * @class RuleProfiler
+ * @brief Collects the profiles of all derivations, and writes the report.
+ *
+ * Enabled with the -profilerules option. Every derivation is profiled
+ * into it's own RuleProfile, which is merged here when it's done, so the
+ * derivations don't contend for the lock while running.
+ */
+class RuleProfiler {
+  /** Lock guarding profile. */
+  Mutex mutex;
+  /** Merged profile of all the derivations. */
+  RuleProfile profile;
+  /** Time the profiler was created at. */
+  double start;
+public:
+  /** Constructor, starts the clock of the report. */
+  RuleProfiler( ) : start( monotonicTime() ) {}
+  /** Merges the profile of a finished derivation. Thread safe. */
+  void merge( const RuleProfile& derivation ) {
+    MutexLock lock( mutex );
+    profile.merge( derivation );
+  }
+  /**
+   * Writes the rules sorted by exclusive time as a text table to the
+   * given file. Returns false if the file couldn't be written.
+   */
+  bool writeText( const String& filename );
+  /** 
+   * Writes the counters as JSON to the given file. Returns false if the 
+   * file couldn't be written.
+   */
+  bool writeJSON( const String& filename );
+};
+
+#endif /* __RULEPROFILER_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -17,28 +17,57 @@
 #include "Rule.h"
 #include "Mesh.h"
 #include "Material.h"
-#define MAX_RECURSION 1000
+#include "ExecutionContext.h"
+#include "Thread.h"
+
+typedef std::map<String, int> AttributeSlotMap;
 
 class RuleSet {
+  // every object of the grammar is allocated from the arena, and freed
+  // with it
+  Arena arena;
   RuleMap rules;
-  AttributeMap attrmap;
-  int recursion;
-  MeshVector* meshes;
+  // attributes are interned into dense slots while parsing, attrs holds
+  // the global values every derivation starts with
+  AttributeSlotMap attrslots;
+  StringVector attrnames;
+  DoubleVector attrs;
+  BoolVector attrassigned;
+  BoolVector attrread;
+  // guards the attribute table, rule files are parsed concurrently
+  Mutex attrlock;
   MaterialVector materials;
+  // nesting depth limit of a single derivation
+  int maxDepth;
+  // collects the profiles of the derivations, NULL if not profiling
+  RuleProfiler* profiler;
 public:
-  RuleSet() : recursion(0), meshes(NULL) { }
-  MeshVector* run(Mesh* initial_mesh, int initial_face, String& rulename);
-  int runMesh(Mesh* mesh, int face, String& rulename);
-  int runNewMesh(Mesh* old_mesh, int old_face, String& rulename);
-  void loadMaterial(String& id, String& name, bool noradar);
-  void initialize() { String init = String("initialize"); runMesh(NULL,0,init); }
+  RuleSet() : maxDepth( DEFAULT_MAX_DEPTH ), profiler( NULL ) { }
+  MeshVector* run(ExecutionContext& context, Mesh* initial_mesh, int initial_face, String& rulename) const;
+  int runMesh(ExecutionContext& context, Mesh* mesh, int face, const String& rulename) const;
+  int runMesh(ExecutionContext& context, Mesh* mesh, int face, const Rule* rule) const;
+  void spawnMesh(ExecutionContext& context, Mesh* old_mesh, int old_face, const Rule* rule) const;
+  const Rule* findRule(const String& name, const String& owner) const;
+  bool link();
+  void initialize();
+  int internAttr(const String& name, bool assigned);
+  int findAttr(const String& name) const;
   void addAttr(const char* name, double value) { String temp = name; addAttr(temp,value); }
-  void addAttr(String& name, double value) { attrmap[name] = value; }
-  double getAttr(String& name); 
-  double getAttr(const char* name) { String temp = name; return getAttr(temp); }
+  void addAttr(const String& name, double value) { attrs[internAttr(name,true)] = value; }
+  double getAttr(const String& name) const;
+  double getAttr(const char* name) const { String temp = name; return getAttr(temp); }
+  const DoubleVector& getAttributes() const { return attrs; }
   void addRule(String& name, Rule* rule);
-  void output(Output& out );
-  int materialsCount() { return materials.size(); }
+  void output(Output& out ) const;
+  int materialsCount() const { return materials.size(); }
+  void setMaxDepth(int depth) { maxDepth = depth; }
+  int getMaxDepth() const { return maxDepth; }
+  void setProfiler(RuleProfiler* _profiler) { profiler = _profiler; }
+  const String& getAttrName(int slot) const { return attrnames[slot]; }
+  Arena& getArena() { return arena; }
+  // writes the attribute table and the rules into a grammar image, only
+  // valid before link
+  void write(GrammarWriter& out) const;
   ~RuleSet();
 };
 
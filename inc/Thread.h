@@ -0,0 +1,149 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file Thread.h
+ * @brief Minimal portable threading primitives for BZWGen.
+ *
+ * Native handles are kept opaque, so that including this file doesn't
+ * pull windows.h or pthread.h into every translation unit.
+ */
+
+#ifndef __THREAD_H__
+#define __THREAD_H__
+
+#include <cstddef>
+
+/**
+ * @class Mutex
+ * @brief Non-recursive mutual exclusion lock.
+ *
+ * Wraps a CRITICAL_SECTION on Windows and a pthread mutex elsewhere.
+ */
+class Mutex {
+  /** Opaque pointer to the native lock. */
+  void* handle;
+public:
+  /** Creates the native lock. */
+  Mutex();
+  /** Destroys the native lock. */
+  ~Mutex();
+  /** Blocks until the lock is acquired. */
+  void lock();
+  /** Releases the lock. */
+  void unlock();
+private:
+  friend class Condition;
+  /** Blocked copy constructor. */
+  Mutex( const Mutex& );
+  /** Blocked assignment operator. */
+  Mutex& operator=( const Mutex& );
+};
+
+/**
+ * @class MutexLock
+ * @brief Scoped lock, holds the passed Mutex for it's lifetime.
+ */
+class MutexLock {
+  /** The held mutex. */
+  Mutex& mutex;
+public:
+  /** Acquires the passed mutex. */
+  MutexLock( Mutex& _mutex ) : mutex( _mutex ) {
+    mutex.lock();
+  }
+  /** Releases the held mutex. */
+  ~MutexLock() {
+    mutex.unlock();
+  }
+private:
+  /** Blocked copy constructor. */
+  MutexLock( const MutexLock& other ) : mutex( other.mutex ) {}
+};
+
+/**
+ * @class Condition
+ * @brief Condition variable, lets threads wait for a state guarded by a Mutex.
+ *
+ * Wraps a CONDITION_VARIABLE on Windows and a pthread condition elsewhere.
+ * Waits may wake up spuriously, so the state has to be checked in a loop.
+ */
+class Condition {
+  /** Opaque pointer to the native condition. */
+  void* handle;
+public:
+  /** Creates the native condition. */
+  Condition();
+  /** Destroys the native condition. */
+  ~Condition();
+  /**
+   * Releases the held mutex, waits until woken up and acquires the mutex
+   * again.
+   */
+  void wait( Mutex& mutex );
+  /** Wakes up all waiting threads. */
+  void broadcast();
+private:
+  /** Blocked copy constructor. */
+  Condition( const Condition& );
+  /** Blocked assignment operator. */
+  Condition& operator=( const Condition& );
+};
+
+/**
+ * @class Thread
+ * @brief Abstract thread of execution.
+ *
+ * Derive and implement run(). The thread is started by start() and must be
+ * joined with join() before the object is destroyed.
+ */
+class Thread {
+  /** Opaque pointer to the native thread handle, NULL if not started. */
+  void* handle;
+public:
+  /** Constructor, does not start the thread. */
+  Thread() : handle( NULL ) {}
+  /** Starts the thread. Returns false if the thread couldn't be created. */
+  bool start();
+  /** Waits for the thread to finish. Does nothing if it wasn't started. */
+  void join();
+  /** The code executed by the thread. */
+  virtual void run() = 0;
+  /** Returns the number of processors available, at least 1. */
+  static int hardwareThreads();
+  /** Destructor, joins the thread if it's still running. */
+  virtual ~Thread();
+private:
+  /** Blocked copy constructor. */
+  Thread( const Thread& ) {}
+};
+
+/**
+ * Returns a monotonic wall clock time in seconds, counted from an
+ * unspecified point. Only differences of the returned values are 
+ * meaningful.
+ */
+double monotonicTime();
+
+/**
+ * Returns an id of the calling thread, unique among the running threads.
+ */
+unsigned long currentThreadId();
+
+#endif /* __THREAD_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -0,0 +1,115 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file ThreadPool.h
+ * @brief Work-stealing thread pool used for parallel generation.
+ */
+
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+#include <deque>
+#include <vector>
+#include "Thread.h"
+
+/**
+ * @class Task
+ * @brief A unit of work that can be scheduled on a ThreadPool.
+ */
+class Task {
+public:
+  /** Executes the task. May be called from any worker thread. */
+  virtual void run( ) = 0;
+  /**
+   * Returns the estimated cost of the task. Only the relative order of
+   * costs matters -- expensive tasks are scheduled first.
+   */
+  virtual double cost( ) const {
+    return 1.0;
+  }
+  /** Virtual destructor to suppress warnings. */
+  virtual ~Task( ) {}
+};
+
+/** Type definition for a vector of task pointers. */
+typedef std::vector< Task* > TaskVector;
+
+/**
+ * @class ThreadPool
+ * @brief Runs a batch of tasks on a fixed number of worker threads.
+ *
+ * Tasks are sorted by their estimated cost and dealt round robin into
+ * per-worker queues, so that every worker starts on the largest lot it
+ * owns. A worker whose queue runs dry steals the largest pending task from
+ * the other workers, hence a single expensive zone never keeps the rest of
+ * the batch waiting behind it. The calling thread acts as the first worker.
+ * The pool does not own the tasks.
+ */
+class ThreadPool {
+  /** Per-worker task queue and it's lock. */
+  struct Queue {
+    Mutex mutex;
+    std::deque< Task* > tasks;
+  };
+  /** Worker thread, runs ThreadPool::work for the given index. */
+  class Worker : public Thread {
+    ThreadPool* pool;
+    int index;
+  public:
+    Worker( ThreadPool* _pool, int _index ) : pool( _pool ), index( _index ) {}
+    void run( ) {
+      pool->work( index );
+    }
+  };
+  /** Number of workers, including the calling thread. */
+  int threads;
+  /** Tasks added, but not yet run. */
+  TaskVector pending;
+  /** One queue per worker. */
+  std::vector< Queue* > queues;
+  friend class Worker;
+public:
+  /**
+   * Constructor, takes the number of workers. Values lower than 1 mean
+   * one worker per available processor.
+   */
+  ThreadPool( int _threads );
+  /** Adds a task to the next batch. */
+  void addTask( Task* task ) {
+    pending.push_back( task );
+  }
+  /** Runs all added tasks and returns when all of them are complete. */
+  void run( );
+  /** Returns the number of workers. */
+  int getThreadCount( ) const {
+    return threads;
+  }
+  /** Destructor, frees the queues. */
+  ~ThreadPool( );
+private:
+  /** Worker loop -- drains the own queue, then steals from the others. */
+  void work( int index );
+  /** Pops the front task of the given queue, NULL if it's empty. */
+  Task* take( int index );
+  /** Blocked copy constructor. */
+  ThreadPool( const ThreadPool& ) {}
+};
+
+#endif /* __THREADPOOL_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -0,0 +1,163 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+/**
+ * @file Tracer.h
+ * @brief Timeline trace of the generation, in the Trace Event Format.
+ */
+
+#ifndef __TRACER_H__
+#define __TRACER_H__
+
+#include <vector>
+#include "globals.h"
+#include "Thread.h"
+
+/**
+ * @struct TraceEvent
+ * @brief A single completed span of the trace.
+ *
+ * Names and categories aren't copied, they have to outlive the tracer --
+ * they are either literals or the names of the loaded rules. Arguments
+ * that don't apply are -1 and aren't written.
+ */
+struct TraceEvent {
+  /** Name of the span. */
+  const char* name;
+  /** Category of the span -- "phase", "zone" or "rule". */
+  const char* category;
+  /** Start time in seconds, as returned by monotonicTime(). */
+  double start;
+  /** Duration in seconds. */
+  double duration;
+  /** Index of the zone the span belongs to. */
+  int zone;
+  /** Rule nesting depth. */
+  int depth;
+  /** Faces added during the span. */
+  int faces;
+  /** Track (thread) index, assigned by the Tracer. */
+  int track;
+};
+
+/** Type definition for a vector of trace events. */
+typedef std::vector< TraceEvent > TraceEventVector;
+
+/**
+ * @class TracerSingleton
+ * @brief Collects the trace events of all threads, and writes the trace.
+ *
+ * Enabled with the -trace option, the resulting file may be loaded into
+ * chrome://tracing or Perfetto. Every thread that records an event gets
+ * it's own track, the thread that enabled the tracer being track 0. 
+ * Spans of the generation phases are added one at a time, the rule spans
+ * of a derivation are collected without locking into a TraceEventVector 
+ * and added at once when the derivation is done. While disabled, adding
+ * costs a single test.
+ */
+class TracerSingleton {
+  /** Lock guarding events and threads. */
+  Mutex mutex;
+  /** Set if events are collected. */
+  bool enabled;
+  /** The collected events. */
+  TraceEventVector events;
+  /** Native ids of the threads, indexed by track. */
+  std::vector< unsigned long > threads;
+  /** Time the tracer was enabled at, written as time zero. */
+  double origin;
+public:
+  /** 
+   * Singleton instance accessor.
+   */
+  static TracerSingleton& getInstance() {
+    static TracerSingleton singleton;
+    return singleton;
+  }
+  /** Starts collecting events, the calling thread becomes track 0. */
+  void enable( );
+  /** Returns true if events are collected. */
+  bool isEnabled( ) const {
+    return enabled;
+  }
+  /** Adds an event on the track of the calling thread. Thread safe. */
+  void add( const TraceEvent& event ) {
+    if ( !enabled ) return;
+    MutexLock lock( mutex );
+    events.push_back( event );
+    events.back().track = track();
+  }
+  /** 
+   * Adds the events of a derivation on the track of the calling thread.
+   * Thread safe.
+   */
+  void add( const TraceEventVector& derivation );
+  /**
+   * Writes the trace as a JSON object to the given file. Returns false
+   * if the file couldn't be written.
+   */
+  bool write( const String& filename );
+private:
+  /** Returns the track of the calling thread, mutex has to be held. */
+  int track( );
+  /** 
+   * Blocked constructor.
+   */
+  TracerSingleton( ) : enabled( false ), origin( 0.0 ) {}
+  /** 
+   * Blocked copy constructor.
+   */
+  TracerSingleton( const TracerSingleton& ) {}
+};
+
+#define Tracer TracerSingleton::getInstance()
+
+/**
+ * @class TraceSpan
+ * @brief Scoped span, adds an event covering it's lifetime to the Tracer.
+ */
+class TraceSpan {
+  /** The event, start is 0 if the tracer was disabled. */
+  TraceEvent event;
+public:
+  /** Starts a span of the given name and category. */
+  TraceSpan( const char* name, const char* category = "phase", int zone = -1 ) {
+    event.name = name;
+    event.category = category;
+    event.start = Tracer.isEnabled() ? monotonicTime() : 0.0;
+    event.zone = zone;
+    event.depth = -1;
+    event.faces = -1;
+  }
+  /** Sets the number of faces reported by the span. */
+  void setFaces( int faces ) {
+    event.faces = faces;
+  }
+  /** Ends the span. */
+  ~TraceSpan( ) {
+    if ( event.start == 0.0 ) return;
+    event.duration = monotonicTime() - event.start;
+    Tracer.add( event );
+  }
+private:
+  /** Blocked copy constructor. */
+  TraceSpan( const TraceSpan& );
+};
+
+#endif /* __TRACER_H__ */
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -27,6 +27,7 @@
 #include "graph/PlanarGraph.h"
 #include "globals.h"
 #include "Output.h"
+#include "ThreadPool.h"
 
 // Forward declarations
 class Generator;
@@ -38,9 +39,10 @@ class Generator;
  * A zone represents a part of the map -- this part can be of arbitrary 
  * shape, represented internally as a pointer to a graph::Face. Zone 
  * itself is a abstract class, because it doesn't hold any information 
- * about generation nor output.
+ * about generation nor output. Zones are Tasks, so that the Generator may
+ * run them on a ThreadPool.
  */
-class Zone {
+class Zone : public Task {
 protected:
   /** 
    * Pointer to the Zone's generator.
@@ -50,6 +52,13 @@ protected:
    * Pointer to the zone's graph face.
    */
   graph::Face* face;
+  /**
+   * World seed and stream number of the zone's random stream, assigned
+   * by the Generator before run() is called.
+   */
+  unsigned int seed;
+  /** @copydoc seed */
+  unsigned int stream;
 public:
   /**
    * Constructor, initializes the necessary data, except that 
@@ -57,17 +66,31 @@ public:
    * generations of meshes should be done using run().
    */
   Zone( Generator* _generator, graph::Face* _face ) 
-    : generator( _generator ), face( _face ) {};
+    : generator( _generator ), face( _face ), seed( 1 ), stream( 0 ) {};
   /**
    * Runs mesh generation, preparing the zone for output. Pure 
-   * virtual method to be overridden.
+   * virtual method to be overridden. Zones may be run concurrently, 
+   * so run() may only change the zone itself.
    */
   virtual void run( ) = 0;
+  /**
+   * Sets the seed and stream number of the zone's random stream.
+   */
+  void setRandomStream( unsigned int _seed, unsigned int _stream ) {
+    seed = _seed;
+    stream = _stream;
+  }
   /**
    * Outputs the mesh information to the given Output object.
    * Pure virtual method to be overridden.
    */
   virtual void output( Output& ) = 0;
+  /**
+   * Frees the generated meshes once they were output, the zone can't be
+   * output again afterwards. Used when streaming the world, so that
+   * only the zones being generated hold memory. Does nothing by default.
+   */
+  virtual void release( ) {}
   /**
    * Virtual destructor to suppress warnings. 
    */
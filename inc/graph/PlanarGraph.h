@@ -197,14 +197,14 @@ public:
    */
   Edge* closestEdge( const Vector2Df v );
   /**
-   * Returns a random edge belonging to the graph. If no edge is present
-   * will return NULL.
+   * Returns a random edge belonging to the graph, drawn from the passed
+   * random stream. If no edge is present will return NULL.
    */
-  Edge* randomEdge( ) {
+  Edge* randomEdge( Random& random ) {
     if ( edges == 0 ) return NULL;
     Edge* edge = NULL;
     while ( edge == NULL ) {
-      edge = edgeList.get( Random::numberMax( edgeList.size( ) ) );
+      edge = edgeList.get( random.numberMax( edgeList.size( ) ) );
     };
     return edge;
   }
@@ -0,0 +1,81 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+#include "Arena.h"
+
+void Arena::grow( size_t size ) {
+  for ( void** link = &spare; *link != NULL; link = (void**)*link ) {
+    if ( ((size_t*)*link)[1] < size ) continue;
+    next = (char*)*link;
+    left = ((size_t*)next)[1];
+    *link = *(void**)next;
+    return;
+  }
+  // small arenas -- a single rule file -- stay small, the rest of the 
+  // current chunk is wasted, and a large object gets a chunk of it's own
+  size_t chunk = size_t( ARENA_CHUNK_SIZE );
+  if ( chunks.size() < 4 ) chunk = size_t( ARENA_FIRST_CHUNK_SIZE ) << chunks.size();
+  chunk = math::max( size, chunk );
+  next = new char[chunk];
+  left = chunk;
+  chunks.push_back( next );
+}
+
+void Arena::startReuse( ) {
+  size_t lists = ARENA_MAX_REUSE / ALIGNMENT + 1;
+  reuse = (void**)allocate( lists * sizeof( void* ) );
+  for ( size_t i = 0; i < lists; i++ ) reuse[i] = NULL;
+}
+
+const char* Arena::copy( const String& text ) {
+  char* result = (char*)allocate( text.size() + 1 );
+  memcpy( result, text.c_str(), text.size() + 1 );
+  return result;
+}
+
+void Arena::merge( Arena& other ) {
+  // the other arena's last chunk goes before ours, so that we keep 
+  // allocating from our own
+  chunks.insert( chunks.end() - ( chunks.empty() ? 0 : 1 ), other.chunks.begin(), other.chunks.end() );
+  finalizers.insert( finalizers.end(), other.finalizers.begin(), other.finalizers.end() );
+  used += other.used;
+  other.chunks.clear();
+  other.finalizers.clear();
+  other.next = NULL;
+  other.left = 0;
+  other.used = 0;
+  other.reuse = NULL;
+  other.spare = NULL;
+}
+
+void Arena::clear( ) {
+  for ( size_t i = finalizers.size(); i > 0; i-- )
+    finalizers[i - 1].destroy( finalizers[i - 1].object );
+  for ( size_t i = 0; i < chunks.size(); i++ )
+    delete[] chunks[i];
+  finalizers.clear();
+  chunks.clear();
+  next = NULL;
+  left = 0;
+  used = 0;
+  reuse = NULL;
+  spare = NULL;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
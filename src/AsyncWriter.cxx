@@ -0,0 +1,131 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "AsyncWriter.h"
+#include "Tracer.h"
+
+#ifdef _WIN32
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+AsyncWriter::AsyncWriter( size_t _bufferSize, int _maxBuffers ) 
+  : file( NULL ), sync( false ), bufferSize( _bufferSize ), maxBuffers( math::max( _maxBuffers, 2 ) ), 
+    allocated( 0 ), closing( false ), failed( false ), stalls( 0 ), writes( 0 ), written( 0 ), worker( this ) {}
+
+bool AsyncWriter::open( const String& filename, bool _sync ) {
+  if ( file != NULL ) return false;
+  file = fopen( filename.c_str(), "wb" );
+  if ( file == NULL ) return false;
+  // the buffers are written as they are
+  setvbuf( file, NULL, _IONBF, 0 );
+  sync = _sync;
+  closing = false;
+  failed = false;
+  if ( !worker.start() ) {
+    fclose( file );
+    file = NULL;
+    return false;
+  }
+  return true;
+}
+
+char* AsyncWriter::acquire( ) {
+  MutexLock lock( mutex );
+  if ( freeBuffers.empty() && allocated >= maxBuffers ) {
+    stalls++;
+    while ( freeBuffers.empty() ) changed.wait( mutex );
+  }
+  if ( freeBuffers.empty() ) {
+    allocated++;
+    return new char[bufferSize];
+  }
+  char* data = freeBuffers.back();
+  freeBuffers.pop_back();
+  return data;
+}
+
+void AsyncWriter::submit( char* data, size_t size ) {
+  MutexLock lock( mutex );
+  Block block;
+  block.data = data;
+  block.size = size;
+  queue.push_back( block );
+  changed.broadcast();
+}
+
+void AsyncWriter::work( ) {
+  for (;;) {
+    Block block;
+    bool skip;
+    {
+      MutexLock lock( mutex );
+      while ( queue.empty() && !closing ) changed.wait( mutex );
+      if ( queue.empty() ) return;
+      block = queue.front();
+      queue.pop_front();
+      skip = failed;
+    }
+    bool ok = true;
+    if ( !skip && block.size > 0 ) {
+      TraceSpan span( "write" );
+      ok = fwrite( block.data, 1, block.size, file ) == block.size;
+    }
+    MutexLock lock( mutex );
+    if ( !ok ) failed = true;
+    if ( !skip && block.size > 0 ) {
+      writes++;
+      written += block.size;
+    }
+    freeBuffers.push_back( block.data );
+    changed.broadcast();
+  }
+}
+
+bool AsyncWriter::close( ) {
+  if ( file == NULL ) return true;
+  {
+    MutexLock lock( mutex );
+    closing = true;
+    changed.broadcast();
+  }
+  worker.join();
+  if ( fflush( file ) != 0 ) failed = true;
+  if ( sync && !failed ) {
+    TraceSpan span( "sync" );
+#ifdef _WIN32
+    if ( _commit( _fileno( file ) ) != 0 ) failed = true;
+#else
+    if ( fsync( fileno( file ) ) != 0 ) failed = true;
+#endif
+  }
+  if ( fclose( file ) != 0 ) failed = true;
+  file = NULL;
+  Logger.log( 3, "AsyncWriter : %lu bytes in %d writes, %d of %d buffers used, waited for the disk %d times", 
+	      (unsigned long)written, writes, allocated, maxBuffers, stalls );
+  return !failed;
+}
+
+AsyncWriter::~AsyncWriter( ) {
+  close();
+  for ( size_t i = 0; i < freeBuffers.size(); i++ )
+    delete[] freeBuffers[i];
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -11,18 +11,28 @@
  */
 
 #include "BZWGenerator.h"
-#include "time.h"
 #include "Output.h"
 #include "GridGenerator.h"
 #include "FaceGenerator.h"
+#include "Tracer.h"
+#include "GrammarImage.h"
+#include "RuleParser.h"
+#include "ThreadPool.h"
+#include <memory>
 #include <sstream>
 #include <iostream>
 
 typedef std::ostringstream OutStringStream;
 
-extern int yyparse(RuleSet*);
-extern int yylineno;
-extern FILE* yyin;
+/** Parses a single rule file on the thread pool. */
+class ParseTask : public Task {
+  RuleParser* parser;
+public:
+  ParseTask( RuleParser* _parser ) : parser( _parser ) {}
+  void run( ) {
+    parser->parse();
+  }
+};
 
 #ifdef _USE_LIB_RULES_
 std::vector<void*> handleList;
@@ -139,26 +149,80 @@ int BZWGenerator::setup( ) {
     Logger.setFileLogLevel( fileDebugLevel );
   }
 
+  if ( cmd.Exists( "trace" ) ) {
+    tracename = cmd.GetDataS( "trace" );
+    Tracer.enable();
+  }
+
   getOptionI( detail,      "l", "detail" );
   getOptionS( texturepath, "t", "texture" );
+  precision = Output::DEFAULT_PRECISION;
+  if ( cmd.Exists( "precision" ) ) precision = cmd.GetDataI( "precision" );
+  streaming = cmd.Exists( "stream" );
   if ( getOptionS( temp, "r", "rulesdir" ) )
     ruledir.SetOSDir( temp.c_str() );
 
   COSFile file;
-  ruleset = new RuleSet();
-
+  std::vector< COSFile > sources;
+  StringVector sourcenames;
   while ( ruledir.GetNextFile( file, "*.set", false ) ) {
-    Logger.log( 1, "BZWGenerator : loading %s... ", file.GetOSName() );
-    file.Open( "r" );
-    yyin = file.GetFile();
-    if ( yyparse( ruleset ) == 0) {
-      Logger.log( 3, "BZWGenerator : loading done." );
+    sources.push_back( file );
+    sourcenames.push_back( file.GetOSName() );
+  }
+  unsigned int hash = GrammarImage::hashSources( sourcenames );
+  String imagename = String( ruledir.GetOSName() ) + "/" + GRAMMAR_IMAGE_NAME;
+  compileRules = cmd.Exists( "compilerules" );
+
+  {
+    TraceSpan span( "parsing rules" );
+    ruleset = compileRules ? NULL : GrammarImage::load( imagename, hash );
+    if ( ruleset != NULL ) {
+      Logger.log( 1, "BZWGenerator : loaded compiled rules %s.", imagename.c_str() );
     } else {
-      Logger.log( "BZWGenerator : loading %s failed!", file.GetOSName() );
+      ruleset = new RuleSet();
+      std::vector< RuleParser* > parsers;
+      for ( size_t i = 0; i < sources.size(); i++ ) {
+	Logger.log( 1, "BZWGenerator : loading %s... ", sources[i].GetOSName() );
+	parsers.push_back( new RuleParser( sources[i].GetOSName(), ruleset ) );
+      }
+      // the files are parsed on as many threads as the zones, and their
+      // rules added in file order afterwards
+      int threads = cmd.Exists( "threads" ) ? cmd.GetDataI( "threads" ) : 1;
+      if ( threads == 1 || parsers.size() < 2 ) {
+	for ( size_t i = 0; i < parsers.size(); i++ )
+	  parsers[i]->parse();
+      } else {
+	ThreadPool pool( threads );
+	std::vector< ParseTask > tasks;
+	for ( size_t i = 0; i < parsers.size(); i++ )
+	  tasks.push_back( ParseTask( parsers[i] ) );
+	for ( size_t i = 0; i < tasks.size(); i++ )
+	  pool.addTask( &tasks[i] );
+	pool.run();
+      }
+      bool failed = false;
+      for ( size_t i = 0; i < parsers.size(); i++ ) {
+	if ( parsers[i]->isParsed() ) {
+	  parsers[i]->commit();
+	} else {
+	  Logger.log( "BZWGenerator : loading %s failed!", parsers[i]->getFilename().c_str() );
+	  failed = true;
+	}
+      }
+      deletePointerVector( parsers );
+      if ( failed ) return 1;
+      Logger.log( 3, "BZWGenerator : loading done." );
+    }
+  }
+
+  if ( compileRules ) {
+    // the image holds the parsed rules only, so it's written before
+    // anything else touches the ruleset
+    if ( !GrammarImage::save( ruleset, imagename, hash ) ) {
+      Logger.log( "BZWGenerator : writing compiled rules %s failed!", imagename.c_str() );
       return 1;
     }
-    yylineno = 1;
-    file.Close();
+    Logger.log( 1, "BZWGenerator : compiled rules written to %s.", imagename.c_str() );
   }
 
   loadPlugIns();
@@ -166,16 +230,45 @@ int BZWGenerator::setup( ) {
   bool passsidewalk = ( cmd.Exists( "w" ) || cmd.Exists( "sidewalk" ) );
   experimental      = ( cmd.Exists( "e" ) || cmd.Exists( "experimental" ) );
 
+  // set after initialize below, as they always were, so that the
+  // command line wins over the ruleset -- declared here, so that link 
+  // doesn't report them as never assigned
+  ruleset->internAttr( "DETAIL", true );
+  ruleset->internAttr( "PASSABLE_SIDEWALK", true );
+  if ( cmd.Exists( "maxdepth" ) ) ruleset->setMaxDepth( cmd.GetDataI( "maxdepth" ) );
+  if ( cmd.Exists( "profilerules" ) ) {
+    profilename = cmd.GetDataS( "profilerules" );
+    profiler = new RuleProfiler();
+    ruleset->setProfiler( profiler );
+  }
+
+  TraceSpan span( "linking rules" );
+  ruleset->link();
   ruleset->initialize();
   ruleset->addAttr( "DETAIL",            double( detail ) );
   ruleset->addAttr( "PASSABLE_SIDEWALK", double( passsidewalk ? 1.0 : -1.0 ) );
 
-  srand( (unsigned int) time( NULL ) );
-
   return 0;
 }
 
 void BZWGenerator::generate( OutStream* outstream ) {
+  Output os( outstream, texturepath, precision );
+  generate( os );
+}
+
+void BZWGenerator::generate( AsyncWriter& writer ) {
+  Output os( &writer, texturepath, precision );
+  generate( os );
+}
+
+char* BZWGenerator::generate( size_t& size, int& copies ) {
+  Output os( texturepath, precision );
+  generate( os );
+  copies = os.getGrowCount();
+  return os.detach( size );
+}
+
+void BZWGenerator::generate( Output& os ) {
   Logger.log( 1, "BZWGenerator : initializing... " );
   std::auto_ptr<Generator> gen;
   if ( experimental )
@@ -186,14 +279,33 @@ void BZWGenerator::generate( OutStream* outstream ) {
   Logger.log( 1, "BZWGenerator : parsing options... " );
   gen->parseOptions( &cmd );
 
+  os.info( BZWGMajorVersion, BZWGMinorVersion, BZWGRevision );
+  if ( streaming ) gen->setStream( &os );
+
   Logger.log( 1, "BZWGenerator : generating... " );
-  gen->run( );
+  {
+    TraceSpan span( "generating" );
+    gen->run( );
+  }
 
-  Logger.log( 1, "BZWGenerator : outputing... " );
-  Output os( outstream, texturepath );
-  os.info( BZWGMajorVersion, BZWGMinorVersion, BZWGRevision );
-  gen->output( os );
+  if ( profiler != NULL ) {
+    Logger.log( 1, "BZWGenerator : writing rule profile to %s... ", profilename.c_str() );
+    if ( !profiler->writeText( profilename ) || !profiler->writeJSON( profilename + ".json" ) )
+      Logger.log( "BZWGenerator : Warning : couldn't write the rule profile to %s!", profilename.c_str() );
+  }
+
+  if ( !streaming ) {
+    Logger.log( 1, "BZWGenerator : outputing... " );
+    gen->output( os );
+  }
   os.footer( );
+  os.flush( );
+
+  if ( Tracer.isEnabled() ) {
+    Logger.log( 1, "BZWGenerator : writing trace to %s... ", tracename.c_str() );
+    if ( !Tracer.write( tracename ) )
+      Logger.log( "BZWGenerator : Warning : couldn't write the trace to %s!", tracename.c_str() );
+  }
 
   Logger.log( 1, "BZWGenerator : generation done. ");
 }
@@ -12,16 +12,27 @@
 
 #ifdef COMPILE_PLUGIN
 #include "BZWGeneratorPlugin.h"
-#include <sstream>
 
-typedef std::ostringstream OutStringStream;
+void BZWGeneratorPlugin::start() {
+  startTime = monotonicTime();
+  started = generation.start();
+  if (!started)
+    Logger.log( "BZWGeneratorPlugin : Warning : couldn't start the generation thread, generating on demand." );
+}
+
+void BZWGeneratorPlugin::generateWorld() {
+  if (!started) startTime = monotonicTime();
+  world = generate(worldSize, worldCopies);
+  readyTime = monotonicTime();
+  Logger.log( 2, "BZWGeneratorPlugin : world ready %.2f s after start, %lu bytes", readyTime - startTime, (unsigned long)worldSize );
+}
 
 void BZWGeneratorPlugin::process(bz_EventData *eventData) {
   if (eventData->eventType == bz_eWorldFinalized) {
     // This bothers me because this pointer has been given
     // out. Potential pointer into freed memory...
-    delete[] cstr;
-    cstr = 0;
+    delete[] world;
+    world = NULL;
     return;
   }
 
@@ -31,25 +42,22 @@ void BZWGeneratorPlugin::process(bz_EventData *eventData) {
 
   Logger.log( 2, "BZWGeneratorPlugin : bz_eGetWorldEvent called!" );
 
-  if (worldGenerated) {
-    bz_GetWorldEventData_V1 *getWorldData = (bz_GetWorldEventData_V1 *) eventData;
-    getWorldData->worldBlob = cstr;
-    getWorldData->generated = true;
-    return;
+  if (!worldGenerated) {
+    double waitStart = monotonicTime();
+    if (started)
+      generation.join();
+    else
+      generateWorld();
+    worldGenerated = true;
+    // the buffer goes to the server as it is, the only copies are those
+    // made while it grew
+    Logger.log( 2, "BZWGeneratorPlugin : waited %.2f s for the world, handed over with %d copies of the text while generating and 0 after", 
+		monotonicTime() - waitStart, worldCopies );
   }
 
-  OutStringStream outstream(OutStringStream::out);
-  generate(&outstream);
-
   bz_GetWorldEventData_V1 *getWorldData = (bz_GetWorldEventData_V1 *) eventData;
-
-  // The following code is so ugly that I barely can look at it.
-  delete[] cstr;
-  cstr = new char [outstream.str().size()+1];
-  strcpy (cstr, outstream.str().c_str());
-  getWorldData->worldBlob = cstr;
+  getWorldData->worldBlob = world;
   getWorldData->generated = true;
-  worldGenerated = true;
 }
 #endif // COMPILE_PLUGIN
 
@@ -51,6 +51,15 @@ void BZWGeneratorStandalone::printHelp() {
   printHelpCommand("l","detail","integer       sets the level of detail (1-3)(default: 3)");
   printHelpCommand("w","sidewalk","            sets sidewalks passable (default: false)");
   printHelpCommand("t","texture","URL          sets the URL for textures");
+  printHelpCommand("","fsync","                     syncs the output file to the disk before exiting (default: false)");
+  printHelpCommand("","precision","integer          sets the decimal places of coordinates, 0-9 (default: 4)");
+  printHelpCommand("","stream","                    writes each zone as soon as it's generated, and frees it (default: false)");
+  printHelpCommand("","threads","integer            sets number of parsing and generation threads, 0 for one per CPU (default: 1)");
+  printHelpCommand("","seed","integer               sets the world seed, the same seed and options give the same map (default: time)");
+  printHelpCommand("","maxdepth","integer           sets the rule nesting depth limit of a zone (default: 1000)");
+  printHelpCommand("","profilerules","filename     writes a per-rule profile to filename and filename.json");
+  printHelpCommand("","trace","filename            writes a timeline trace (chrome://tracing) to filename");
+  printHelpCommand("","compilerules","             compiles the rules into rules.bzwc in the rules directory and exits");
   printHelpCommand("e","experimental","        turns on experimental generator\n");
 }
 
@@ -64,6 +73,7 @@ int BZWGeneratorStandalone::parseCommandLine(int argc, char* argv[]) {
 
   outname = "map.bzw";
   getOptionS(outname,"o","output");
+  syncOutput = cmd.Exists("fsync");
   return 0;
 }
 
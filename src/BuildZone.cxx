@@ -15,22 +15,21 @@
 
 void BuildZone::run() {
   Logger.log( 4, "BuildZone : running at %s...", face->toString().c_str() );
-  Mesh* mesh = new Mesh();
+  Mesh* mesh = new ( arena ) Mesh( arena );
 
   graph::NodeVector nodes = face->getNodes();
 
-  Face* baseFace = new Face();
-  baseFace->setMaterial( 0 );
+  int baseFaceID = mesh->addFace( 0 );
+  Face baseFace = mesh->getFace( baseFaceID );
   for ( size_t i = 0; i < nodes.size(); i++ ) {
-    baseFace->addVertex( mesh->addVertex( Vertex( nodes[i]->vector().x, nodes[i]->vector().y, 0.0f ) ) );
+    baseFace.addVertex( mesh->addVertex( Vertex( nodes[i]->vector().x, nodes[i]->vector().y, 0.0f ) ) );
   }
 
-  int baseFaceID = mesh->addFace( baseFace );
-
   Logger.log( 4, "BuildZone : running ruleset 'start' rule..." );
   String rulename = String("start");
-  // Possible memory leak here?
-  meshes = generator->getRuleSet()->run( mesh, baseFaceID, rulename );
+  const RuleSet* ruleset = generator->getRuleSet();
+  ExecutionContext context( ruleset->getAttributes(), seed, stream );
+  meshes = ruleset->run( context, mesh, baseFaceID, rulename );
   Logger.log( 4, "BuildZone : complete" );
 }
 
@@ -40,8 +39,15 @@ void BuildZone::output( Output& out ) {
     (*itr)->output( out, generator->getRuleSet()->materialsCount() );
 }
 
+void BuildZone::release( ) {
+  delete meshes;
+  meshes = NULL;
+  arena.clear();
+}
+
 BuildZone::~BuildZone( ) {
-  deletePointerVector( meshes );
+  // the meshes themselves go away with the arena
+  delete meshes;
 }
 
 // Local Variables: ***
@@ -0,0 +1,152 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "ExecutionContext.h"
+#include "Rule.h"
+#include "Product.h"
+#include "Operation.h"
+
+int ExecutionContext::derive( const Rule* rule, Mesh* mesh, int face, int maxDepth ) {
+  size_t base = stack.size();
+  int depth = getDepth();
+  // the result of the first frame is returned, not handed down
+  call( rule, mesh, face );
+  calls.back().depth = depth + 1;
+  calls.back().parent = stack.empty() ? -1 : int( stack.size() ) - 1;
+  stack.push_back( calls.back() );
+  calls.clear();
+
+  for (;;) {
+    size_t top = stack.size() - 1;
+    Frame& frame = stack[top];
+
+    if ( frame.product == NULL ) {
+      // unresolved references were reported by link
+      if ( frame.rule != NULL ) {
+	Logger.log( 4, "ExecutionContext : rule '%s', depth %d", frame.rule->getName().c_str(), frame.depth );
+	if ( frame.depth > maxDepth ) {
+	  Logger.log( "ExecutionContext : Warning : depth %d reached in rule '%s'! Are you sure you have no infinite loops?", maxDepth, frame.rule->getName().c_str() );
+	  stack.resize( base );
+	  return -1;
+	}
+	if ( instrumented ) enterProfile( frame );
+	frame.product = frame.rule->getProduct( *this, frame.mesh, frame.face );
+      }
+      if ( frame.product == NULL ) {
+	if ( top == base ) return finish( -1 );
+	finish( -1 );
+      }
+      continue;
+    }
+
+    if ( frame.face == -1 || frame.next == frame.product->operationCount() ) {
+      if ( top == base ) return finish( frame.face );
+      finish( frame.face );
+      continue;
+    }
+
+    const Operation* operation = frame.product->getOperation( frame.next++ );
+    int result = operation->runMesh( *this, frame.mesh, frame.face );
+    // frame is still valid, scheduled calls aren't on the stack yet
+    frame.face = result;
+    if ( calls.empty() ) continue;
+    if ( result == -1 ) {
+      calls.clear();
+      continue;
+    }
+
+    int callDepth = frame.depth + 1;
+    if ( calls.size() == 1 && calls[0].mode == CALL_RETURN && frame.next == frame.product->operationCount() ) {
+      // tail call -- the product is done, the called rule's result is
+      // it's result, so the rule takes over the product's frame
+      if ( instrumented ) leaveProfile( frame, result );
+      calls[0].mode = frame.mode;
+      calls[0].caller = frame.caller;
+      calls[0].parent = frame.parent;
+      calls[0].depth = callDepth;
+      frame = calls[0];
+    } else {
+      // the first call has to run first, so it goes on top
+      for ( size_t i = calls.size(); i > 0; i-- ) {
+	calls[i - 1].depth = callDepth;
+	calls[i - 1].parent = int( top );
+	stack.push_back( calls[i - 1] );
+      }
+    }
+    calls.clear();
+  }
+}
+
+int ExecutionContext::finish( int result ) {
+  Frame done = stack.back();
+  stack.pop_back();
+  if ( instrumented && done.rule != NULL ) leaveProfile( done, result );
+  if ( done.mode == CALL_DROP ) return result;
+  Frame& frame = stack[done.parent];
+  if ( done.mode == CALL_RETURN )
+    frame.face = result;
+  else if ( done.mode == CALL_RESUME )
+    frame.face = done.caller->resume( *this, frame.mesh, frame.face, result );
+  return result;
+}
+
+void ExecutionContext::enterProfile( Frame& frame ) {
+  frame.start = monotonicTime();
+  frame.childTime = 0.0;
+  frame.faces = frame.mesh ? frame.mesh->faceCount() : 0;
+  frame.vertices = frame.mesh ? frame.mesh->vertexCount() : 0;
+  frame.childFaces = 0;
+  frame.childVertices = 0;
+}
+
+void ExecutionContext::leaveProfile( const Frame& frame, int result ) {
+  ProfileCounters sample;
+  sample.calls = 1;
+  sample.failures = result == -1 ? 1 : 0;
+  sample.inclusive = monotonicTime() - frame.start;
+  sample.exclusive = sample.inclusive - frame.childTime;
+  int faces = frame.mesh ? frame.mesh->faceCount() - frame.faces : 0;
+  int vertices = frame.mesh ? frame.mesh->vertexCount() - frame.vertices : 0;
+  sample.faces = faces - frame.childFaces;
+  sample.vertices = vertices - frame.childVertices;
+  if ( profile ) profile->record( frame.rule, frame.product, sample );
+
+  if ( trace ) {
+    TraceEvent event;
+    event.name = frame.rule->getName().c_str();
+    event.category = "rule";
+    event.start = frame.start;
+    event.duration = sample.inclusive;
+    event.zone = zone;
+    event.depth = frame.depth;
+    event.faces = faces;
+    trace->push_back( event );
+  }
+
+  // a rule called in tail position is charged to the caller's caller,
+  // as the caller is done when it runs
+  if ( frame.parent < 0 ) return;
+  Frame& parent = stack[frame.parent];
+  parent.childTime += sample.inclusive;
+  if ( parent.mesh == frame.mesh ) {
+    parent.childFaces += faces;
+    parent.childVertices += vertices;
+  }
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -10,32 +10,141 @@
  * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include <cstring>
+#include <cctype>
 #include "Expression.h"
+#include "ExpressionProgram.h"
 #include "RuleSet.h"
 
-double ExpressionAttribute::calculate( Mesh*, int ) {
-  return ruleset->getAttr( attrname );
-}
-
-double ExpressionFaceAttribute::calculate( Mesh* mesh, int face ) {
-  if ( attrname == "x" ) return mesh->faceCenter( face ).x;
-  if ( attrname == "y" ) return mesh->faceCenter( face ).y;
-  if ( attrname == "z" ) return mesh->faceCenter( face ).z;
-  if ( attrname == "h" ) return mesh->faceH( face );
-  if ( attrname == "v" ) return mesh->faceV( face );
-  if ( attrname == "s" ) return mesh->faceH( face ) * mesh->faceV( face );
-  if ( attrname == "n" ) return double( mesh->getFace( face )->size() );
-  if ( attrname == "c" ) {
-    if (mesh->getFace( face )->isMultiFace()) {
-      return double( ( ( MultiFace* ) mesh->getFace( face ) )->componentCount() );
-    } else {
-      Logger.log( 2, "Warning : face(c) called with non-MultiFace!");
-    }
+ExpressionAttribute::ExpressionAttribute( RuleSet* ruleset, const char* attrname )
+  : slot( ruleset->internAttr( attrname, false ) ) {
+}
+
+double ExpressionAttribute::calculate( ExecutionContext& context, Mesh*, int ) const {
+  return context.getAttr( slot );
+}
+
+double ExpressionFaceAttribute::calculate( ExecutionContext&, Mesh* mesh, int face ) const {
+  return value( attr, mesh, face );
+}
+
+double ExpressionFaceAttribute::value( Attribute attr, Mesh* mesh, int face ) {
+  switch ( attr ) {
+    case FACE_X : return mesh->faceCenter( face ).x;
+    case FACE_Y : return mesh->faceCenter( face ).y;
+    case FACE_Z : return mesh->faceCenter( face ).z;
+    case FACE_H : return mesh->faceH( face );
+    case FACE_V : return mesh->faceV( face );
+    case FACE_S : return mesh->faceArea( face );
+    case FACE_N : return double( mesh->getFace( face ).size() );
+    case FACE_C :
+      if ( mesh->getFace( face ).isMultiFace() )
+        return double( MultiFace( mesh, face ).componentCount() );
+      Logger.log( 2, "Warning : face(c) called with non-MultiFace!" );
+      break;
   }
-  Logger.log( 2, "Warning : Unknown face() attribute : '%s'!\n", attrname.c_str() );
   return 0.0;
 }
 
+int ExpressionFaceAttribute::attributeId( const char* attrname ) {
+  static const char* names = "xyzhvsnc";
+  if ( attrname == NULL || attrname[0] == '\0' || attrname[1] != '\0' ) return -1;
+  const char* found = strchr( names, tolower( attrname[0] ) );
+  if ( found == NULL ) return -1;
+  return int( found - names );
+}
+
+// compilation into ExpressionProgram bytecode
+
+void Expression::compile( ExpressionCompiler& compiler, int ) const {
+  compiler.fail();
+}
+
+static void compileChild( ExpressionCompiler& compiler, const Expression* child, int reg ) {
+  if ( child ) 
+    child->compile( compiler, reg );
+  else
+    compiler.emitConst( reg, 0.0 );
+}
+
+void ExpressionDouble::compileBinary( ExpressionCompiler& compiler, int reg, int op ) const {
+  compileChild( compiler, exp[0], reg );
+  compileChild( compiler, exp[1], reg + 1 );
+  compiler.emit( ExpressionProgram::Opcode( op ), reg, reg, reg + 1 );
+}
+
+void ExpressionConst::compile( ExpressionCompiler& compiler, int reg ) const {
+  compiler.emitConst( reg, value );
+}
+
+void ExpressionAttribute::compile( ExpressionCompiler& compiler, int reg ) const {
+  compiler.emit( ExpressionProgram::OP_ATTR, reg, 0, 0, slot );
+}
+
+void ExpressionFaceAttribute::compile( ExpressionCompiler& compiler, int reg ) const {
+  compiler.emit( ExpressionProgram::OP_FACE, reg, 0, 0, attr );
+}
+
+void ExpressionRandom::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileChild( compiler, exp[0], reg );
+  compileChild( compiler, exp[1], reg + 1 );
+  compileChild( compiler, exp[2], reg + 2 );
+  compiler.emit( ExpressionProgram::OP_RANDOM, reg, reg + 1, reg + 2 );
+}
+
+void ExpressionNeg::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileChild( compiler, exp[0], reg );
+  compiler.emit( ExpressionProgram::OP_NEG, reg, reg );
+}
+
+void ExpressionRound::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileChild( compiler, exp[0], reg );
+  compiler.emit( ExpressionProgram::OP_ROUND, reg, reg );
+}
+
+void ExpressionAdd::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileBinary( compiler, reg, ExpressionProgram::OP_ADD );
+}
+
+void ExpressionSub::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileBinary( compiler, reg, ExpressionProgram::OP_SUB );
+}
+
+void ExpressionDiv::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileBinary( compiler, reg, ExpressionProgram::OP_DIV );
+}
+
+void ExpressionMult::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileBinary( compiler, reg, ExpressionProgram::OP_MULT );
+}
+
+void ExpressionGreater::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileBinary( compiler, reg, ExpressionProgram::OP_GREATER );
+}
+
+void ExpressionEqual::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileBinary( compiler, reg, ExpressionProgram::OP_EQUAL );
+}
+
+// the logical operators only evaluate their right side if the left one
+// doesn't decide the result
+
+void ExpressionAnd::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileChild( compiler, exp[0], reg );
+  int jump = compiler.emit( ExpressionProgram::OP_JUMPNEG, reg, reg );
+  compileChild( compiler, exp[1], reg );
+  compiler.patchJump( jump );
+  compiler.emit( ExpressionProgram::OP_BOOL, reg, reg );
+}
+
+void ExpressionOr::compile( ExpressionCompiler& compiler, int reg ) const {
+  compileChild( compiler, exp[0], reg );
+  int jump = compiler.emit( ExpressionProgram::OP_JUMPNONNEG, reg, reg );
+  compileChild( compiler, exp[1], reg );
+  compiler.patchJump( jump );
+  compiler.emit( ExpressionProgram::OP_BOOL, reg, reg );
+}
+
 
 // Local Variables: ***
 // mode:C++ ***
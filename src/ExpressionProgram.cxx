@@ -0,0 +1,121 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "ExpressionProgram.h"
+
+Expression* ExpressionProgram::compileTree( Arena& arena, Expression* tree ) {
+  if ( tree == NULL ) return NULL;
+  ExpressionCompiler compiler;
+  tree->compile( compiler, 0 );
+  if ( compiler.failed ) {
+    Logger.log( 3, "ExpressionProgram : expression not compiled, using the tree." );
+    return tree;
+  }
+  return new ( arena ) ExpressionProgram( arena.copy( compiler.code ), int( compiler.code.size() ), arena.copy( compiler.constants ) );
+}
+
+bool ExpressionCompiler::fold( Opcode op, int dst, int a, int b ) {
+  int n = int( code.size() );
+  double x, y = 0.0;
+  switch ( op ) {
+    case OP_NEG : case OP_ROUND : case OP_BOOL :
+      if ( n < 1 || !isConst( n - 1, a ) ) return false;
+      x = constants[code[n - 1].arg];
+      code.pop_back();
+      break;
+    case OP_ADD : case OP_SUB : case OP_MULT : case OP_DIV : case OP_GREATER : case OP_EQUAL :
+      if ( n < 2 || !isConst( n - 2, a ) || !isConst( n - 1, b ) ) return false;
+      x = constants[code[n - 2].arg];
+      y = constants[code[n - 1].arg];
+      code.pop_back();
+      code.pop_back();
+      break;
+    default :
+      return false;
+  }
+  double result = 0.0;
+  switch ( op ) {
+    case OP_NEG     : result = -x; break;
+    case OP_ROUND   : result = math::roundToInt( x ); break;
+    case OP_BOOL    : result = x >= 0.0 ? 1.0 : -1.0; break;
+    case OP_ADD     : result = x + y; break;
+    case OP_SUB     : result = x - y; break;
+    case OP_MULT    : result = x * y; break;
+    case OP_DIV     : result = x / y; break;
+    case OP_GREATER : result = x > y ? 1.0 : -1.0; break;
+    case OP_EQUAL   : result = math::abs( x - y ) < 0.001f ? 1.0 : -1.0; break;
+    default : break;
+  }
+  emitConst( dst, result );
+  return true;
+}
+
+int ExpressionCompiler::emit( Opcode op, int dst, int a, int b, int arg ) {
+  if ( dst >= MAX_REGISTERS || a >= MAX_REGISTERS || b >= MAX_REGISTERS ) {
+    fail();
+    return 0;
+  }
+  if ( fold( op, dst, a, b ) ) return int( code.size() ) - 1;
+  Instruction instruction;
+  instruction.op  = (unsigned char)op;
+  instruction.dst = (unsigned char)dst;
+  instruction.a   = (unsigned char)a;
+  instruction.b   = (unsigned char)b;
+  instruction.arg = arg;
+  code.push_back( instruction );
+  return int( code.size() ) - 1;
+}
+
+void ExpressionCompiler::emitConst( int dst, double value ) {
+  constants.push_back( value );
+  emit( OP_CONST, dst, 0, 0, int( constants.size() ) - 1 );
+}
+
+double ExpressionProgram::calculate( ExecutionContext& context, Mesh* mesh, int face ) const {
+  double r[MAX_REGISTERS];
+  const Instruction* start = code;
+  const Instruction* end = start + count;
+  for ( const Instruction* i = start; i != end; ++i ) {
+    switch ( i->op ) {
+      case OP_CONST   : r[i->dst] = constants[i->arg]; break;
+      case OP_ATTR    : r[i->dst] = context.getAttr( i->arg ); break;
+      case OP_FACE    : r[i->dst] = ExpressionFaceAttribute::value( ExpressionFaceAttribute::Attribute( i->arg ), mesh, face ); break;
+      case OP_RANDOM  :
+        if ( fabs( r[i->b] ) < 0.0001f )
+          r[i->dst] = context.getRandom().doubleRange( r[i->dst], r[i->a] );
+        else
+          r[i->dst] = context.getRandom().doubleRangeStep( r[i->dst], r[i->a], r[i->b] );
+        break;
+      case OP_NEG     : r[i->dst] = -r[i->a]; break;
+      case OP_ROUND   : r[i->dst] = math::roundToInt( r[i->a] ); break;
+      case OP_ADD     : r[i->dst] = r[i->a] + r[i->b]; break;
+      case OP_SUB     : r[i->dst] = r[i->a] - r[i->b]; break;
+      case OP_MULT    : r[i->dst] = r[i->a] * r[i->b]; break;
+      case OP_DIV     : r[i->dst] = r[i->a] / r[i->b]; break;
+      case OP_GREATER : r[i->dst] = r[i->a] > r[i->b] ? 1.0 : -1.0; break;
+      case OP_EQUAL   : r[i->dst] = math::abs( r[i->a] - r[i->b] ) < 0.001f ? 1.0 : -1.0; break;
+      case OP_BOOL    : r[i->dst] = r[i->a] >= 0.0 ? 1.0 : -1.0; break;
+      // jump targets are at most end, and the loop increments i
+      case OP_JUMPNEG    : if ( r[i->a] <  0.0 ) i = start + i->arg - 1; break;
+      case OP_JUMPNONNEG : if ( r[i->a] >= 0.0 ) i = start + i->arg - 1; break;
+    }
+  }
+  return r[0];
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
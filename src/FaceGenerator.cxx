@@ -16,6 +16,7 @@
 #include "FloorZone.h"
 #include "BaseZone.h"
 #include "BuildZone.h"
+#include "Tracer.h"
 
 void FaceGenerator::parseOptions( CCommandLineArgs* opt ) {
   Generator::parseOptions( opt );
@@ -23,9 +24,18 @@ void FaceGenerator::parseOptions( CCommandLineArgs* opt ) {
 
 void FaceGenerator::run( ) {
   Logger.log( 2, "FaceGenerator : running..." );
-  runPrimaryRoadGeneration( );
-  runSecondaryRoadGeneration( );
-  pushZones( );
+  {
+    TraceSpan span( "primary roads" );
+    runPrimaryRoadGeneration( );
+  }
+  {
+    TraceSpan span( "secondary roads" );
+    runSecondaryRoadGeneration( );
+  }
+  {
+    TraceSpan span( "pushing zones" );
+    pushZones( );
+  }
   Generator::run( );
   Logger.log( 2, "FaceGenerator : run completed." );
 }
@@ -153,7 +163,7 @@ void FaceGenerator::subdivideFace( graph::Face* face, float threshold ) {
 }
 
 Vector2Df FaceGenerator::deviateVector( const Vector2Df v, double noise ) {
-  float theta = float( Random::doubleMax( noise ) * PI * Random::sign() );
+  float theta = float( random.doubleMax( noise ) * PI * random.sign() );
   return Vector2Df( cos( theta ) * v.x - sin( theta ) * v.y,
                     sin( theta ) * v.x + cos( theta ) * v.y );
 }
@@ -162,7 +172,7 @@ void FaceGenerator::growRoads( graph::Node* node, size_t branching,
                                float segmentLength, float noise,
                                float threshold ) {
   Logger.log( 4, "FaceGenerator : grow roads on node #%s..." , node->toString( ).c_str() );
-  int branches = math::roundToInt( branching * Random::doubleRange( 1.0f - noise, 1.0f + noise ) );
+  int branches = math::roundToInt( branching * random.doubleRange( 1.0f - noise, 1.0f + noise ) );
 
   // lets get the owner of the node
   graph::PlanarGraph* graph = node->getGraph();
@@ -191,7 +201,7 @@ void FaceGenerator::growRoads( graph::Node* node, size_t branching,
     Logger.log( 4, "FaceGenerator : direction %s" , direction.toString( ).c_str() );
 
     direction = deviateVector( direction, noise );
-    direction = direction * (float)segmentLength * (float)Random::doubleRange( 1.0 - noise, 1.0 + noise );
+    direction = direction * (float)segmentLength * (float)random.doubleRange( 1.0 - noise, 1.0 + noise );
     //direction = math::precision( direction, 0.1f );
 
     Vector2Df target = node->vector() + direction;
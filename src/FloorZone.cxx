@@ -19,21 +19,18 @@ void FloorZone::run() {
 
   graph::NodeVector nodes = face->getNodes();
 
-  Face* swface = new Face();
-  swface->setMaterial( materialID );
+  Face swface = mesh.getFace( mesh.addFace( materialID ) );
   for (size_t i = 0; i < nodes.size(); i++) {
-    swface->addVertex( mesh.addVertex( Vertex( nodes[i]->vector().x, nodes[i]->vector().y, 0.001f ) ) );
+    swface.addVertex( mesh.addVertex( Vertex( nodes[i]->vector().x, nodes[i]->vector().y, 0.001f ) ) );
   }
 
   double texX = (nodes[2]->vector().x - nodes[0]->vector().x) / step;
   double texY = (nodes[2]->vector().y - nodes[0]->vector().y) / step;
 
-  swface->addTexCoord( mesh.addTexCoord( TexCoord(0.0,0.0) ) );
-  swface->addTexCoord( mesh.addTexCoord( rotated ? TexCoord(0.0 ,texX) : TexCoord(texX,0.0) ) );
-  swface->addTexCoord( mesh.addTexCoord( rotated ? TexCoord(texY,texX) : TexCoord(texX,texY) ) );
-  swface->addTexCoord( mesh.addTexCoord( rotated ? TexCoord(texY,0.0)  : TexCoord(0,texY) ) );
-
-  mesh.addFace(swface);
+  swface.addTexCoord( mesh.addTexCoord( TexCoord(0.0,0.0) ) );
+  swface.addTexCoord( mesh.addTexCoord( rotated ? TexCoord(0.0 ,texX) : TexCoord(texX,0.0) ) );
+  swface.addTexCoord( mesh.addTexCoord( rotated ? TexCoord(texY,texX) : TexCoord(texX,texY) ) );
+  swface.addTexCoord( mesh.addTexCoord( rotated ? TexCoord(texY,0.0)  : TexCoord(0,texY) ) );
 }
 
 
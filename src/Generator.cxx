@@ -11,6 +11,157 @@
  */
 
 #include "Generator.h"
+#include "Tracer.h"
+
+/**
+ * Runs a zone inside of a trace span, so that the zones show up on the
+ * tracks of the workers that ran them.
+ */
+class TracedZone : public Task {
+  Zone* zone;
+  int index;
+public:
+  TracedZone( Zone* _zone, int _index ) : zone( _zone ), index( _index ) {}
+  void run( ) {
+    TraceSpan span( "zone", "zone", index );
+    zone->run();
+  }
+  double cost( ) const {
+    return zone->cost();
+  }
+};
+
+/**
+ * Runs the zones on worker threads and writes them to an Output in zone
+ * order, as soon as they're complete. Unlike the ThreadPool the zones are
+ * taken in order, each is serialized into an Output of it's own by the
+ * worker that ran it, and released. Zones that were already run are only
+ * serialized, and kept. The completed zones wait in a reorder buffer
+ * until the zones before them are written. A worker doesn't start
+ * a zone more than WINDOW zones per thread past the first one not yet 
+ * written, so that a slow zone doesn't let the buffer grow with the world.
+ * The calling thread acts as the first worker, and whichever worker 
+ * completes the first zone not written writes the buffered ones.
+ */
+class ZoneStream {
+  /** Worker thread, runs ZoneStream::work. */
+  class Worker : public Thread {
+    ZoneStream* zoneStream;
+  public:
+    Worker( ZoneStream* _zoneStream ) : zoneStream( _zoneStream ) {}
+    void run( ) {
+      zoneStream->work();
+    }
+  };
+  /** Zones started, per thread, before the first one not yet written. */
+  static const size_t WINDOW = 2;
+  /** The zones, and the Output they are written to. */
+  ZoneVector& zones;
+  Output& out;
+  /** Set if the zones have to be run, and released once written. */
+  bool generate;
+  /** Zones that may be started past the first one not yet written. */
+  size_t window;
+  /** Guards the fields below. */
+  Mutex mutex;
+  /** Broadcasted when a zone was written. */
+  Condition written;
+  /** Index of the next zone to run. */
+  size_t next;
+  /** Index of the first zone not yet written. */
+  size_t first;
+  /** Set while a worker writes the buffered zones. */
+  bool writing;
+  /** The reorder buffer, completed zones waiting for the ones before. */
+  std::vector< Output* > chunks;
+  friend class Worker;
+public:
+  ZoneStream( ZoneVector& _zones, Output& _out, bool _generate ) 
+    : zones( _zones ), out( _out ), generate( _generate ), window( WINDOW ), 
+      next( 0 ), first( 0 ), writing( false ), chunks( _zones.size(), (Output*)NULL ) {}
+  /** Runs and writes all zones on the given number of threads. */
+  void run( int threads );
+private:
+  /** Worker loop, runs zones until there are none left. */
+  void work( );
+  /** 
+   * Returns the next zone to run, or -1 if there are none left. Blocks 
+   * while the window is full.
+   */
+  int take( );
+  /**
+   * Takes the next buffered zone to write, or returns NULL and stops
+   * writing if it isn't complete yet. Counts the previous one as 
+   * written, if there was one.
+   */
+  Output* nextChunk( bool wrote );
+};
+
+void ZoneStream::run( int threads ) {
+  window = WINDOW * size_t( threads );
+  std::vector< Worker* > workers;
+  for ( int i = 1; i < threads; i++ ) {
+    Worker* worker = new Worker( this );
+    if ( !worker->start() ) {
+      Logger.log( "ZoneStream : Warning : couldn't start worker thread %d!", i );
+      delete worker;
+      continue;
+    }
+    workers.push_back( worker );
+  }
+  work();
+  for ( size_t i = 0; i < workers.size(); i++ )
+    workers[i]->join();
+  deletePointerVector( workers );
+}
+
+int ZoneStream::take( ) {
+  MutexLock lock( mutex );
+  while ( next < zones.size() && next >= first + window ) written.wait( mutex );
+  if ( next >= zones.size() ) return -1;
+  return int( next++ );
+}
+
+Output* ZoneStream::nextChunk( bool wrote ) {
+  MutexLock lock( mutex );
+  if ( wrote ) {
+    first++;
+    written.broadcast();
+  }
+  if ( first == chunks.size() || chunks[first] == NULL ) {
+    writing = false;
+    return NULL;
+  }
+  Output* chunk = chunks[first];
+  chunks[first] = NULL;
+  return chunk;
+}
+
+void ZoneStream::work( ) {
+  for ( int index = take(); index >= 0; index = take() ) {
+    Output* chunk = new Output( out.getTexturePath(), out.getPrecision() );
+    if ( generate ) {
+      TraceSpan span( "zone", "zone", index );
+      zones[index]->run();
+      zones[index]->output( *chunk );
+      zones[index]->release();
+    } else {
+      TraceSpan span( "zone output", "zone", index );
+      zones[index]->output( *chunk );
+    }
+    {
+      MutexLock lock( mutex );
+      chunks[index] = chunk;
+      if ( writing ) continue;
+      writing = true;
+    }
+    // only one worker writes at a time, the others keep running zones
+    for ( Output* ready = nextChunk( false ); ready != NULL; ready = nextChunk( true ) ) {
+      out.append( *ready );
+      delete ready;
+    }
+  }
+}
 
 void Generator::parseOptions(CCommandLineArgs* opt) {
   size = 800;
@@ -24,22 +175,76 @@ void Generator::parseOptions(CCommandLineArgs* opt) {
   if (opt->Exists("bases")) { bases = opt->GetDataI("bases"); }
 
   if (opt->Exists("ctfsafe")) { ctfSafe = true; }
+
+  if (opt->Exists("threads")) { threads = opt->GetDataI("threads"); }
+
+  if (opt->Exists("seed")) { seed = (unsigned int)opt->GetDataI("seed"); }
+  random.seed(seed);
+  Logger.log( 1, "Generator : world seed is %u", seed );
 }
 
 void Generator::run() {
-  Logger.log( 2, "Generator : generating zones..." );
-  for (ZoneVectIter itr = zones.begin(); itr!= zones.end(); ++itr) (*itr)->run();
+  // the zone streams only depend on the world seed and the zone index
+  unsigned int stream = 1;
+  for (ZoneVectIter itr = zones.begin(); itr!= zones.end(); ++itr) (*itr)->setRandomStream( seed, stream++ );
+
+  if ( streamOutput != NULL ) {
+    outputHeader( *streamOutput );
+    if ( threads == 1 ) {
+      Logger.log( 2, "Generator : generating and outputing zones..." );
+      for (size_t i = 0; i < zones.size(); i++) {
+        TraceSpan span( "zone", "zone", int( i ) );
+        zones[i]->run();
+        zones[i]->output( *streamOutput );
+        zones[i]->release();
+      }
+      return;
+    }
+    int count = threads < 1 ? Thread::hardwareThreads() : threads;
+    Logger.log( 2, "Generator : generating and outputing zones on %d threads...", count );
+    ZoneStream zoneStream( zones, *streamOutput, true );
+    zoneStream.run( count );
+    return;
+  }
+
+  std::vector< TracedZone > tasks;
+  for (size_t i = 0; i < zones.size(); i++) tasks.push_back( TracedZone( zones[i], int( i ) ) );
+
+  if ( threads == 1 ) {
+    Logger.log( 2, "Generator : generating zones..." );
+    for (size_t i = 0; i < tasks.size(); i++) tasks[i].run();
+    return;
+  }
+
+  ThreadPool pool( threads );
+  Logger.log( 2, "Generator : generating zones on %d threads...", pool.getThreadCount() );
+  for (size_t i = 0; i < tasks.size(); i++) pool.addTask( &tasks[i] );
+  pool.run();
 }
 
-void Generator::output(Output& out) {
+void Generator::outputHeader(Output& out) {
   out.header(size);
 
   Logger.log( 2, "Generator : outputing materials..." );
   for (MaterialVectIter iter = mats.begin(); iter != mats.end(); ++iter) (*iter).output(out);
   if (ruleset != NULL) ruleset->output(out);
+}
+
+void Generator::output(Output& out) {
+  TraceSpan span( "output" );
+  outputHeader(out);
+
+  if ( threads == 1 ) {
+    Logger.log( 2, "Generator : outputing zones..." );
+    for (ZoneVectIter iter = zones.begin(); iter != zones.end(); ++iter)  (*iter)->output(out);
+    return;
+  }
 
-  Logger.log( 2, "Generator : outputing zones..." );
-  for (ZoneVectIter iter = zones.begin(); iter != zones.end(); ++iter)  (*iter)->output(out);
+  // the zones are serialized in parallel, and written in order
+  int count = threads < 1 ? Thread::hardwareThreads() : threads;
+  Logger.log( 2, "Generator : outputing zones on %d threads...", count );
+  ZoneStream zoneStream( zones, out, false );
+  zoneStream.run( count );
 }
 
 
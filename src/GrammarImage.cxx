@@ -0,0 +1,451 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+#include "GrammarImage.h"
+#include "RuleSet.h"
+#include "Rule.h"
+#include "Product.h"
+#include "Operation.h"
+#include "Expression.h"
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+#else
+  #include <sys/types.h>
+  #include <sys/stat.h>
+  #include <sys/mman.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+/** Magic string the image starts with. */
+static const char imageMagic[8] = "BZWGRAM";
+/** Written in native byte order, tells images of other machines apart. */
+static const int imageByteOrder = 0x01020304;
+
+/**
+ * Image header. The body follows it.
+ */
+struct ImageHeader {
+  char magic[8];
+  int version;
+  int byteOrder;
+  /** Hash of the rule files, see GrammarImage::hashSources. */
+  unsigned int hash;
+  /** Size and hash of the body. */
+  int size;
+  unsigned int checksum;
+};
+
+/** Adds the passed bytes to a FNV-1a hash. */
+static unsigned int hashBytes( unsigned int hash, const void* data, size_t size ) {
+  const unsigned char* bytes = (const unsigned char*)data;
+  for ( size_t i = 0; i < size; i++ )
+    hash = ( hash ^ bytes[i] ) * 16777619u;
+  return hash;
+}
+
+/** Starting value of FNV-1a hashes. */
+static const unsigned int hashBasis = 2166136261u;
+
+/**
+ * Read-only memory mapping of a whole file. The mapping is empty if the
+ * file couldn't be mapped.
+ */
+class MappedFile {
+  const char* data;
+  size_t size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+public:
+  MappedFile( const String& filename );
+  const char* getData( ) const {
+    return data;
+  }
+  size_t getSize( ) const {
+    return size;
+  }
+  ~MappedFile( );
+};
+
+#ifdef _WIN32
+
+MappedFile::MappedFile( const String& filename ) : data( NULL ), size( 0 ), mapping( NULL ) {
+  file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+  if ( file == INVALID_HANDLE_VALUE ) return;
+  DWORD length = GetFileSize( file, NULL );
+  if ( length == INVALID_FILE_SIZE || length == 0 ) return;
+  mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+  if ( mapping == NULL ) return;
+  data = (const char*)MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+  if ( data != NULL ) size = length;
+}
+
+MappedFile::~MappedFile( ) {
+  if ( data != NULL ) UnmapViewOfFile( data );
+  if ( mapping != NULL ) CloseHandle( mapping );
+  if ( file != INVALID_HANDLE_VALUE ) CloseHandle( file );
+}
+
+#else
+
+MappedFile::MappedFile( const String& filename ) : data( NULL ), size( 0 ) {
+  int file = open( filename.c_str(), O_RDONLY );
+  if ( file < 0 ) return;
+  struct stat info;
+  if ( fstat( file, &info ) == 0 && info.st_size > 0 ) {
+    void* mapped = mmap( NULL, size_t( info.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+    if ( mapped != MAP_FAILED ) {
+      data = (const char*)mapped;
+      size = size_t( info.st_size );
+    }
+  }
+  // the mapping stays valid once the descriptor is closed
+  close( file );
+}
+
+MappedFile::~MappedFile( ) {
+  if ( data != NULL ) munmap( (void*)data, size );
+}
+
+#endif
+
+/**
+ * Reads a grammar image body, creating the objects through the same
+ * constructors the parser uses. Reading past the end or an unknown tag
+ * marks the reader as failed, every object read so far is allocated
+ * from the ruleset's arena, so that it can simply be deleted.
+ */
+class GrammarReader {
+  const char* pos;
+  const char* end;
+  RuleSet* ruleset;
+  Arena& arena;
+  bool failed;
+public:
+  GrammarReader( const char* data, size_t size, RuleSet* _ruleset )
+    : pos( data ), end( data + size ), ruleset( _ruleset ), arena( _ruleset->getArena() ), failed( false ) {}
+  /** Returns true if the whole body was read without errors. */
+  bool done( ) const {
+    return !failed && pos == end;
+  }
+  int readInt( ) {
+    int value = 0;
+    if ( size_t( end - pos ) < sizeof( value ) ) {
+      failed = true;
+      return 0;
+    }
+    memcpy( &value, pos, sizeof( value ) );
+    pos += sizeof( value );
+    return value;
+  }
+  double readDouble( ) {
+    double value = 0.0;
+    if ( size_t( end - pos ) < sizeof( value ) ) {
+      failed = true;
+      return 0.0;
+    }
+    memcpy( &value, pos, sizeof( value ) );
+    pos += sizeof( value );
+    return value;
+  }
+  String readString( ) {
+    int length = readInt();
+    if ( length < 0 || length > end - pos ) {
+      failed = true;
+      return String();
+    }
+    pos += length;
+    return String( pos - length, size_t( length ) );
+  }
+  /** Reads a count, negative or unreadable counts fail the reader. */
+  int readCount( ) {
+    int count = readInt();
+    if ( count < 0 ) failed = true;
+    return failed ? 0 : count;
+  }
+  StringVector* readStrings( ) {
+    int count = readInt();
+    if ( count < 0 ) return NULL;
+    StringVector* strings = new StringVector();
+    for ( int i = 0; i < count && !failed; i++ )
+      strings->push_back( readString() );
+    return strings;
+  }
+  Expression* readExpression( );
+  ExpressionVector* readExpressions( ) {
+    int count = readCount();
+    ExpressionVector* expressions = new ExpressionVector();
+    for ( int i = 0; i < count && !failed; i++ )
+      expressions->push_back( readExpression() );
+    return expressions;
+  }
+  Operation* readOperation( );
+  Product* readProduct( ) {
+    double rarity = readDouble();
+    Expression* condition = readExpression();
+    int count = readCount();
+    OperationVector* operations = new OperationVector();
+    for ( int i = 0; i < count && !failed; i++ )
+      operations->push_back( readOperation() );
+    return new ( arena ) Product( arena, operations, rarity, condition );
+  }
+  void readRule( ) {
+    String name = readString();
+    int count = readCount();
+    ProductVector* products = new ProductVector();
+    for ( int i = 0; i < count && !failed; i++ )
+      products->push_back( readProduct() );
+    ruleset->addRule( name, Rule::create( arena, name, products ) );
+  }
+  void readRuleSet( ) {
+    int attrs = readCount();
+    for ( int i = 0; i < attrs && !failed; i++ ) {
+      String name = readString();
+      int flags = readInt();
+      if ( flags & 1 ) ruleset->internAttr( name, true );
+      if ( flags & 2 ) ruleset->internAttr( name, false );
+    }
+    int rules = readCount();
+    for ( int i = 0; i < rules && !failed; i++ )
+      readRule();
+  }
+private:
+  /** Reads the face rules of a multiface operation. */
+  void readFaces( Expression*& expression, StringVector*& faces ) {
+    expression = readExpression();
+    faces = readStrings();
+  }
+};
+
+// operands are read into locals first, as the evaluation order of 
+// constructor arguments is unspecified
+
+Expression* GrammarReader::readExpression( ) {
+  int tag = readInt();
+  if ( failed ) return NULL;
+  Expression* a = NULL;
+  Expression* b = NULL;
+  switch ( tag ) {
+    case GrammarWriter::EXP_NULL : return NULL;
+    case GrammarWriter::EXP_CONST : return new ( arena ) ExpressionConst( readDouble() );
+    case GrammarWriter::EXP_ATTRIBUTE : return new ( arena ) ExpressionAttribute( ruleset, readString().c_str() );
+    case GrammarWriter::EXP_FACE : {
+      int attr = readInt();
+      if ( attr < ExpressionFaceAttribute::FACE_X || attr > ExpressionFaceAttribute::FACE_C ) break;
+      return new ( arena ) ExpressionFaceAttribute( ExpressionFaceAttribute::Attribute( attr ) );
+    }
+    case GrammarWriter::EXP_RANDOM : {
+      a = readExpression();
+      b = readExpression();
+      return new ( arena ) ExpressionRandom( a, b, readExpression() );
+    }
+    case GrammarWriter::EXP_NEG   : return new ( arena ) ExpressionNeg( readExpression() );
+    case GrammarWriter::EXP_ROUND : return new ( arena ) ExpressionRound( readExpression() );
+    default : break;
+  }
+  if ( tag >= GrammarWriter::EXP_ADD && tag <= GrammarWriter::EXP_OR ) {
+    a = readExpression();
+    b = readExpression();
+    switch ( tag ) {
+      case GrammarWriter::EXP_ADD     : return new ( arena ) ExpressionAdd( a, b );
+      case GrammarWriter::EXP_SUB     : return new ( arena ) ExpressionSub( a, b );
+      case GrammarWriter::EXP_DIV     : return new ( arena ) ExpressionDiv( a, b );
+      case GrammarWriter::EXP_MULT    : return new ( arena ) ExpressionMult( a, b );
+      case GrammarWriter::EXP_GREATER : return new ( arena ) ExpressionGreater( a, b );
+      case GrammarWriter::EXP_EQUAL   : return new ( arena ) ExpressionEqual( a, b );
+      case GrammarWriter::EXP_AND     : return new ( arena ) ExpressionAnd( a, b );
+      case GrammarWriter::EXP_OR      : return new ( arena ) ExpressionOr( a, b );
+    }
+  }
+  failed = true;
+  return NULL;
+}
+
+Operation* GrammarReader::readOperation( ) {
+  int tag = readInt();
+  if ( failed ) return NULL;
+  Expression* e[4] = { NULL, NULL, NULL, NULL };
+  StringVector* faces = NULL;
+  switch ( tag ) {
+    case GrammarWriter::OP_NONTERMINAL    : return new ( arena ) OperationNonterminal( ruleset, arena, readString().c_str() );
+    case GrammarWriter::OP_ADDFACE        : return new ( arena ) OperationAddFace( ruleset, arena, readString().c_str() );
+    case GrammarWriter::OP_SPAWN          : return new ( arena ) OperationSpawn( ruleset, arena, readString().c_str() );
+    case GrammarWriter::OP_MULTIFACE      : return new ( arena ) OperationMultiFace( ruleset );
+    case GrammarWriter::OP_UNCHAMFER      : return new ( arena ) OperationUnchamfer( ruleset );
+    case GrammarWriter::OP_FREE           : return new ( arena ) OperationFree( ruleset );
+    case GrammarWriter::OP_DRIVETHROUGH   : return new ( arena ) OperationDriveThrough( ruleset );
+    case GrammarWriter::OP_REMOVE         : return new ( arena ) OperationRemove( ruleset );
+    case GrammarWriter::OP_TEXTUREFULL    : return new ( arena ) OperationTextureFull( ruleset );
+    case GrammarWriter::OP_TEXTURECLEAR   : return new ( arena ) OperationTextureClear( ruleset );
+    case GrammarWriter::OP_TEXTURE        : return new ( arena ) OperationTexture( ruleset );
+    case GrammarWriter::OP_LOADMATERIAL : {
+      String id = readString();
+      String filename = readString();
+      bool noradar = readInt() != 0;
+      return new ( arena ) OperationLoadMaterial( ruleset, arena, id.c_str(), filename.c_str(), noradar );
+    }
+    case GrammarWriter::OP_TEXTUREQUAD :
+      for ( int i = 0; i < 4; i++ ) e[i] = readExpression();
+      return new ( arena ) OperationTextureQuad( ruleset, e[0], e[1], e[2], e[3] );
+    case GrammarWriter::OP_SCALE :
+      for ( int i = 0; i < 2; i++ ) e[i] = readExpression();
+      return new ( arena ) OperationScale( ruleset, e[0], e[1] );
+    case GrammarWriter::OP_TRANSLATE :
+      for ( int i = 0; i < 3; i++ ) e[i] = readExpression();
+      return new ( arena ) OperationTranslate( ruleset, e[0], e[1], e[2] );
+    case GrammarWriter::OP_TRANSLATER :
+      for ( int i = 0; i < 3; i++ ) e[i] = readExpression();
+      return new ( arena ) OperationTranslateR( ruleset, e[0], e[1], e[2] );
+    case GrammarWriter::OP_NGON :
+      for ( int i = 0; i < 2; i++ ) e[i] = readExpression();
+      return new ( arena ) OperationNGon( ruleset, e[0], e[1] );
+    case GrammarWriter::OP_ASSERT   : return new ( arena ) OperationAssert( ruleset, readExpression() );
+    case GrammarWriter::OP_MATERIAL : return new ( arena ) OperationMaterial( ruleset, readExpression() );
+    case GrammarWriter::OP_EXPAND   : return new ( arena ) OperationExpand( ruleset, readExpression() );
+    case GrammarWriter::OP_TAPER    : return new ( arena ) OperationTaper( ruleset, readExpression() );
+    case GrammarWriter::OP_CHAMFER  : return new ( arena ) OperationChamfer( ruleset, readExpression() );
+    case GrammarWriter::OP_ASSIGN : {
+      e[0] = readExpression();
+      String name = readString();
+      return new ( arena ) OperationAssign( ruleset, e[0], name.c_str() );
+    }
+    case GrammarWriter::OP_DETACHFACE :
+      readFaces( e[0], faces );
+      return new ( arena ) OperationDetachFace( ruleset, arena, e[0], faces );
+    case GrammarWriter::OP_EXTRUDE :
+      readFaces( e[0], faces );
+      return new ( arena ) OperationExtrude( ruleset, arena, e[0], faces );
+    case GrammarWriter::OP_EXTRUDET :
+      readFaces( e[0], faces );
+      return new ( arena ) OperationExtrudeT( ruleset, arena, e[0], faces );
+    case GrammarWriter::OP_SPLITFACE : {
+      bool horiz = readInt() != 0;
+      ExpressionVector* splits = readExpressions();
+      readFaces( e[0], faces );
+      return new ( arena ) OperationSplitFace( ruleset, arena, horiz, faces, splits, e[0] );
+    }
+    case GrammarWriter::OP_REPEAT : {
+      bool horiz = readInt() != 0;
+      readFaces( e[0], faces );
+      return new ( arena ) OperationRepeat( ruleset, arena, e[0], horiz, faces );
+    }
+  }
+  failed = true;
+  return NULL;
+}
+
+void GrammarWriter::writeAttr( int slot ) {
+  writeString( ruleset->getAttrName( slot ) );
+}
+
+void GrammarWriter::writeStrings( const char* const* strings, int count ) {
+  if ( strings == NULL ) {
+    writeInt( -1 );
+    return;
+  }
+  writeInt( count );
+  for ( int i = 0; i < count; i++ )
+    writeString( strings[i] );
+}
+
+void GrammarWriter::writeExpression( const Expression* expression ) {
+  if ( expression == NULL )
+    writeInt( EXP_NULL );
+  else
+    expression->write( *this );
+}
+
+void GrammarWriter::writeExpressions( Expression* const* expressions, int count ) {
+  writeInt( count );
+  for ( int i = 0; i < count; i++ )
+    writeExpression( expressions[i] );
+}
+
+bool GrammarWriter::save( const String& filename, unsigned int hash ) const {
+  if ( failed ) return false;
+  ImageHeader header;
+  memcpy( header.magic, imageMagic, sizeof( header.magic ) );
+  header.version = GRAMMAR_IMAGE_VERSION;
+  header.byteOrder = imageByteOrder;
+  header.hash = hash;
+  header.size = int( data.size() );
+  header.checksum = hashBytes( hashBasis, data.data(), data.size() );
+  FILE* file = fopen( filename.c_str(), "wb" );
+  if ( file == NULL ) return false;
+  bool written = fwrite( &header, sizeof( header ), 1, file ) == 1 
+    && fwrite( data.data(), 1, data.size(), file ) == data.size();
+  return fclose( file ) == 0 && written;
+}
+
+unsigned int GrammarImage::hashSources( const StringVector& filenames ) {
+  // the file names are hashed without the path, including the 
+  // terminating zero, so that names and contents can't be confused
+  unsigned int hash = hashBasis;
+  for ( size_t i = 0; i < filenames.size(); i++ ) {
+    String::size_type slash = filenames[i].find_last_of( "/\\" );
+    String name = slash == String::npos ? filenames[i] : filenames[i].substr( slash + 1 );
+    hash = hashBytes( hash, name.c_str(), name.size() + 1 );
+    FILE* file = fopen( filenames[i].c_str(), "rb" );
+    if ( file == NULL ) continue;
+    char buffer[4096];
+    size_t count;
+    while ( ( count = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 )
+      hash = hashBytes( hash, buffer, count );
+    fclose( file );
+  }
+  return hash;
+}
+
+bool GrammarImage::save( const RuleSet* ruleset, const String& filename, unsigned int hash ) {
+  GrammarWriter out( ruleset );
+  ruleset->write( out );
+  return out.save( filename, hash );
+}
+
+RuleSet* GrammarImage::load( const String& filename, unsigned int hash ) {
+  MappedFile file( filename );
+  ImageHeader header;
+  if ( file.getSize() < sizeof( header ) ) return NULL;
+  memcpy( &header, file.getData(), sizeof( header ) );
+  if ( memcmp( header.magic, imageMagic, sizeof( header.magic ) ) != 0 
+       || header.version != GRAMMAR_IMAGE_VERSION || header.byteOrder != imageByteOrder 
+       || header.hash != hash || header.size < 0 
+       || size_t( header.size ) != file.getSize() - sizeof( header ) ) 
+    return NULL;
+  const char* body = file.getData() + sizeof( header );
+  if ( hashBytes( hashBasis, body, size_t( header.size ) ) != header.checksum ) {
+    Logger.log( "GrammarImage : Warning : image %s is damaged!", filename.c_str() );
+    return NULL;
+  }
+  RuleSet* ruleset = new RuleSet();
+  GrammarReader in( body, size_t( header.size ), ruleset );
+  in.readRuleSet();
+  if ( !in.done() ) {
+    Logger.log( "GrammarImage : Warning : image %s is damaged!", filename.c_str() );
+    delete ruleset;
+    return NULL;
+  }
+  return ruleset;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -16,8 +16,7 @@
 #include "FloorZone.h"
 #include "BaseZone.h"
 #include "BuildZone.h"
-
-int BaseZone::colorCount = 1;
+#include "Tracer.h"
 
 void GridGenerator::parseOptions( CCommandLineArgs* opt ) {
   Generator::parseOptions( opt );
@@ -77,8 +76,8 @@ void GridGenerator::plotRoad(int x, int y, bool horiz, bool collision) {
 
 void GridGenerator::performSlice(bool full, int snapmod, bool horiz) {
   int bmod = bases > 0 ? 2 : 1;
-  int x = Random::numberRangeStep(snap,gridSize-snap*bmod,snapmod*snap);
-  int y = Random::numberRangeStep(snap,gridSize-snap*bmod,snapmod*snap);
+  int x = random.numberRangeStep(snap,gridSize-snap*bmod,snapmod*snap);
+  int y = random.numberRangeStep(snap,gridSize-snap*bmod,snapmod*snap);
 
   Logger.log( 3, "GridGenerator : slice (%d,%d)...", x, y );
 
@@ -124,7 +123,7 @@ void GridGenerator::growZone(int x,int y,CellType type) {
     addZone(new FloorZone(this,face,gridStep,roadxid,true));
   } else if (type == BASE) {
     Logger.log( 3, "GridGenerator : base zone added (%d,%d * %d,%d)", x, y, xe, ye );
-    addZone(new BaseZone(this,face, ctfSafe));
+    addZone(new BaseZone(this,face, ctfSafe, ++baseCount));
   } else {
     Logger.log( 3, "GridGenerator : building zone added (%d,%d * %d,%d)", x, y, xe, ye );
     addZone(new BuildZone(this,face));
@@ -150,34 +149,42 @@ void GridGenerator::run() {
     }
   }
 
-  bool horiz = Random::coin();
+  bool horiz = random.coin();
 
   Logger.log( 2, "GridGenerator : full slices (%d)...", fullslice );
-  for (int i = 0; i < fullslice; i++) {
-    horiz = !horiz;
-    performSlice(true,3,horiz);
+  {
+    TraceSpan span( "full slices" );
+    for (int i = 0; i < fullslice; i++) {
+      horiz = !horiz;
+      performSlice(true,3,horiz);
+    }
   }
 
   Logger.log( 2, "GridGenerator : subdivision (%d)...", subdiv );
-  for (int i = fullslice; i < subdiv; i++) {
-    horiz = !horiz;
-    performSlice(false,1,horiz);
+  {
+    TraceSpan span( "subdivision" );
+    for (int i = fullslice; i < subdiv; i++) {
+      horiz = !horiz;
+      performSlice(false,1,horiz);
+    }
   }
 
   Logger.log( 2, "GridGenerator : pushing zones..." );
-
-  int y = 0;
-  int x = 0;
-  do {
-    x = 0;
+  {
+    TraceSpan span( "pushing zones" );
+    int y = 0;
+    int x = 0;
     do {
-      if (node(x,y).zone == -1) {
-        growZone(x,y,node(x,y).type);
-      }
-      x++;
-    } while (x < gridSize);
-    y++;
-  } while (y < gridSize);
+      x = 0;
+      do {
+	if (node(x,y).zone == -1) {
+	  growZone(x,y,node(x,y).type);
+	}
+	x++;
+      } while (x < gridSize);
+      y++;
+    } while (y < gridSize);
+  }
 
   Generator::run();
   Logger.log( 2, "GridGenerator : run completed.");
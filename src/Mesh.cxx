@@ -11,57 +11,225 @@
  */
 
 #include "Mesh.h"
+#include "MultiFace.h"
+#include <algorithm>
+#include <climits>
+
+int* Mesh::reserve( IndexVector& buffer, int& first, int& capacity, int count, int needed ) {
+  if ( needed > capacity ) {
+    int room = math::max( math::max( needed, 4 ), 2 * capacity );
+    if ( first + capacity == int( buffer.size() ) ) {
+      buffer.resize( first + room );
+    } else {
+      // the old range is left unused
+      int moved = int( buffer.size() );
+      buffer.resize( moved + room );
+      for ( int i = 0; i < count; i++ ) buffer[moved + i] = buffer[first + i];
+      first = moved;
+    }
+    capacity = room;
+  }
+  return &buffer[first];
+}
+
+void Face::insertVertexBefore( int index, int vertexID ) {
+  Mesh::FaceRecord& face = mesh->faces[id];
+  mesh->invalidateGeometry( id );
+  int* vertices = mesh->reserve( mesh->indices, face.first, face.capacity, face.count, face.count + 1 );
+  for ( int i = face.count; i > index; i-- ) vertices[i] = vertices[i - 1];
+  vertices[index] = vertexID;
+  face.count++;
+  mesh->linkVertex( id, vertexID );
+}
+
+void Face::removeVertex( int index ) {
+  Mesh::FaceRecord& face = mesh->faces[id];
+  mesh->invalidateGeometry( id );
+  int* vertices = &mesh->indices[ face.first ];
+  mesh->unlinkVertex( id, vertices[index] );
+  for ( int i = index; i < face.count - 1; i++ ) vertices[i] = vertices[i + 1];
+  face.count--;
+}
+
+IndexVector Face::getVertices( ) const {
+  const Mesh::FaceRecord& face = mesh->faces[id];
+  IndexVector result( mesh->arena );
+  result.assign( mesh->indices.begin() + face.first, mesh->indices.begin() + face.first + face.count );
+  return result;
+}
+
+void Face::setVertices( const IndexVector& vtx ) {
+  clearVertices();
+  Mesh::FaceRecord& face = mesh->faces[id];
+  int* vertices = mesh->reserve( mesh->indices, face.first, face.capacity, 0, int( vtx.size() ) );
+  for ( size_t i = 0; i < vtx.size(); i++ ) {
+    vertices[i] = vtx[i];
+    mesh->linkVertex( id, vtx[i] );
+  }
+  face.count = int( vtx.size() );
+}
+
+IndexVector Face::getTexCoords( ) const {
+  const Mesh::FaceRecord& face = mesh->faces[id];
+  IndexVector result( mesh->arena );
+  result.assign( mesh->texIndices.begin() + face.texFirst, mesh->texIndices.begin() + face.texFirst + face.texCount );
+  return result;
+}
+
+void Face::setTexCoords( const IndexVector& tcd ) {
+  Mesh::FaceRecord& face = mesh->faces[id];
+  int* texcoords = mesh->reserve( mesh->texIndices, face.texFirst, face.texCapacity, 0, int( tcd.size() ) );
+  for ( size_t i = 0; i < tcd.size(); i++ ) texcoords[i] = tcd[i];
+  face.texCount = int( tcd.size() );
+}
+
+int Mesh::addFace( int material ) {
+  FaceRecord face;
+  face.first = int( indices.size() );
+  face.texFirst = int( texIndices.size() );
+  face.count = face.capacity = 0;
+  face.texCount = face.texCapacity = 0;
+  face.flags = FACE_OUTPUT;
+  faces.push_back( face );
+  int faceID = int( faces.size() ) - 1;
+  getFace( faceID ).setMaterial( material );
+  return faceID;
+}
+
+void Mesh::makeMultiFace( int faceID ) {
+  // the face moves to a new ID, where it's hidden from the mesh, and an
+  // empty MultiFace takes it's place
+  int component = int( faces.size() );
+  faces.push_back( faces[faceID] );
+  faces[component].flags |= FACE_HIDDEN;
+  FaceRecord& multi = faces[faceID];
+  multi.first = int( indices.size() );
+  multi.texFirst = int( texIndices.size() );
+  multi.count = multi.capacity = 0;
+  multi.texCount = multi.texCapacity = 0;
+  multi.material = 0;
+  multi.flags = FACE_OUTPUT | FACE_MULTI;
+  invalidateGeometry( faceID );
+  if ( adjacencyBuilt )
+    for ( int i = 0; i < int( faces[component].count ); i++ ) {
+      removeAdjacency( faceID, indices[ faces[component].first + i ] );
+      addAdjacency( component, indices[ faces[component].first + i ] );
+    }
+  MultiFace( this, faceID ).addFace( component );
+}
+
+IndexVector& Mesh::faceComponents( int faceID ) {
+  ComponentMap::iterator found = components.find( faceID );
+  if ( found != components.end() ) return *found->second;
+  IndexVector* list = new ( arena ) IndexVector( arena );
+  components.insert( ComponentEntry( faceID, list ) );
+  return *list;
+}
 
 int Mesh::addVertex( Vertex vertex ) {
   if (freeVertices.size() > 0) {
     int free = freeVertices[ freeVertices.size() - 1 ];
     freeVertices.pop_back();
     v[free] = vertex;
+    touchVertex( free );
     return free;
   } else {
     v.push_back( vertex );
+    vstamp.push_back( ++stamp );
     return v.size()-1;
   }
 }
 
+namespace {
+  // Side of the texcoord hash grid. Texcoords that are equal within
+  // EPSILON are at most one cell apart, even after rounding.
+  const double TEXCOORD_CELL = 2 * EPSILON;
+  // Largest cell, so that the neighbouring cells still fit an int.
+  const double TEXCOORD_CELL_LIMIT = double( INT_MAX / 2 );
+
+  // Far away texcoords share the cell at the limit, which keeps equal
+  // ones at most one cell apart. NaN equals nothing, it goes to cell 0.
+  inline int texCoordCell( double x ) {
+    double cell = floor( x / TEXCOORD_CELL );
+    if ( cell != cell ) return 0;
+    return int( math::max( -TEXCOORD_CELL_LIMIT, math::min( cell, TEXCOORD_CELL_LIMIT ) ) );
+  }
+
+  inline unsigned int texCoordHash( int x, int y ) {
+    return ( (unsigned int)x * 73856093u ) ^ ( (unsigned int)y * 19349663u );
+  }
+}
+
+// Returns the first texcoord equal to the passed one, as the linear scan
+// did, or adds it. The candidates are the texcoords in the 3x3 cells
+// around it's cell.
 int Mesh::addTexCoord( TexCoord texCoord ) {
-  for ( size_t i = 0; i < tc.size(); i++ ) {
-    if ( tc[i].equals( texCoord ) ) return i;
+  if ( !tcBuckets.empty() ) {
+    int cx = texCoordCell( texCoord.x );
+    int cy = texCoordCell( texCoord.y );
+    unsigned int mask = (unsigned int)tcBuckets.size() - 1;
+    int found = -1;
+    for ( int dx = -1; dx <= 1; dx++ )
+      for ( int dy = -1; dy <= 1; dy++ )
+        for ( int i = tcBuckets[ texCoordHash( cx + dx, cy + dy ) & mask ]; i >= 0; i = tcChain[i] )
+          if ( ( found < 0 || i < found ) && tc[i].equals( texCoord ) ) found = i;
+    if ( found >= 0 ) return found;
   }
   tc.push_back( texCoord );
+  indexTexCoord( int( tc.size() ) - 1 );
   return tc.size() - 1;
 }
 
+void Mesh::indexTexCoord( int texCoordID ) {
+  tcChain.push_back( -1 );
+  if ( tc.size() * 2 > tcBuckets.size() ) {
+    // rehash everything, the new texcoord included
+    size_t buckets = tcBuckets.empty() ? 16 : tcBuckets.size() * 2;
+    tcBuckets.assign( buckets, -1 );
+    for ( size_t i = 0; i < tc.size(); i++ ) {
+      unsigned int bucket = texCoordHash( texCoordCell( tc[i].x ), texCoordCell( tc[i].y ) ) & ( buckets - 1 );
+      tcChain[i] = tcBuckets[bucket];
+      tcBuckets[bucket] = int( i );
+    }
+    return;
+  }
+  const TexCoord& texCoord = tc[texCoordID];
+  unsigned int bucket = texCoordHash( texCoordCell( texCoord.x ), texCoordCell( texCoord.y ) ) & ( tcBuckets.size() - 1 );
+  tcChain[texCoordID] = tcBuckets[bucket];
+  tcBuckets[bucket] = texCoordID;
+}
+
 int Mesh::createNGon(Vertex center, double radius, int n) {
-  Face* face = new Face();
+  int faceID = addFace();
+  Face face = getFace( faceID );
   double step = (2*double(M_PI))/n;
   for (int i = 0; i < n; i++) {
     int vt = addVertex(center+Vertex(radius*cos(step*double(i)-step/2),radius*sin(step*double(i)-step/2),0.0));
-    face->addVertex(vt);
+    face.addVertex(vt);
   }
-  return addFace(face);
+  return faceID;
 }
 
-void Mesh::extrudeFace( int faceID, double amount, int mat, IntVector* result ) {
+void Mesh::extrudeFace( int faceID, double amount, int mat, IndexVector* result ) {
+  Face face = getFace( faceID );
   Vertex dir = faceNormal(faceID)*amount;
-  IntVector base   = f[faceID]->getVertices();
-  IntVector top;
+  IndexVector base( face.getVertices() );
+  IndexVector top( arena );
 
   int size = base.size();
 
   for (int i = 0; i < size; i++) {
     top.push_back(addVertex(v[base.at(i)]+dir));
   }
-  f[faceID]->setVertices( top );
+  face.setVertices( top );
 
   for (int i = 0; i < size; i++) {
-    Face* face = new Face();
-    face->setMaterial(mat);
-    face->addVertex( base.at(i) );
-    face->addVertex( base.at(math::modNext(i,size)) );
-    face->addVertex( top.at(math::modNext(i,size)) );
-    face->addVertex( top.at(i) );
-    int added = addFace( face );
+    int added = addFace( mat );
+    Face side = getFace( added );
+    side.addVertex( base.at(i) );
+    side.addVertex( base.at(math::modNext(i,size)) );
+    side.addVertex( top.at(math::modNext(i,size)) );
+    side.addVertex( top.at(i) );
     if (result) result->push_back( added );
   }
 }
@@ -76,114 +244,192 @@ Vertex Mesh::extensionVertex(int ida, int idb, int idc) {
 }
 
 void Mesh::taperFace(int faceID, double amount) {
-  int size = f[faceID]->size();
+  Face face = getFace( faceID );
+  int size = face.size();
   Vertex c = faceCenter( faceID );
   for ( int i = 0; i < size; i++ ) {
     Vertex vv = getFaceVertex( faceID, i );
-    v[ f[faceID]->getVertex( i ) ] = ( vv - c ) * amount + c;
+    v[ face.getVertex( i ) ] = ( vv - c ) * amount + c;
+    touchVertex( face.getVertex( i ) );
   }
 }
 
 void Mesh::scaleFace( int faceID, double x, double y ) {
-  int size = f[faceID]->size();
+  Face face = getFace( faceID );
+  int size = face.size();
   Vertex c = faceCenter( faceID );
   for ( int i = 0; i < size; i++ ) {
     Vertex vc = getFaceVertex( faceID, i ) - c;
-    int vertexID = f[faceID]->getVertex( i );
+    int vertexID = face.getVertex( i );
     v[vertexID].x = vc.x * x + c.x;
     v[vertexID].y = vc.y * y + c.y;
+    touchVertex( vertexID );
   }
 }
 
 void Mesh::translateFace( int faceID, double x, double y, double z ) {
-  int size = f[faceID]->size();
+  Face face = getFace( faceID );
+  int size = face.size();
   for ( int i = 0; i < size; i++ ) {
-    int vertexID = f[faceID]->getVertex( i );
+    int vertexID = face.getVertex( i );
     v[vertexID].x += x;
     v[vertexID].y += y;
     v[vertexID].z += z;
+    touchVertex( vertexID );
   }
 }
 
 
 void Mesh::expandFace( int faceID, double amount  ) {
+  Face face = getFace( faceID );
   Vertex normal = faceNormal( faceID );
   // needs to be uniform
-  int size = f[faceID]->size();
+  int size = face.size();
   Vertex* nv = new Vertex[size];
   for ( int i = 0; i < size; i++ ) {
     Vertex a = getFaceEdge( faceID, math::modPrev( i, size ), math::modNext( i, size ) );
     Vertex b = getFaceEdge( faceID, math::modPrev( i, size ), i );
     double sign = math::sign( b.cross( a ).dot( normal ) );
     nv[i] = getFaceVertex( faceID, i) + extensionVertex(
-      f[faceID]->getVertex( math::modPrev( i, size ) ),
-      f[faceID]->getVertex( math::modNext( i, size ) ),
-      f[faceID]->getVertex( i ) ) * amount * sign;
+      face.getVertex( math::modPrev( i, size ) ),
+      face.getVertex( math::modNext( i, size ) ),
+      face.getVertex( i ) ) * amount * sign;
   }
   for ( int i = 0; i < size; i++ ) {
-    v[ f[faceID]->getVertex( i ) ] = nv[i];
+    v[ face.getVertex( i ) ] = nv[i];
+    touchVertex( face.getVertex( i ) );
   }
   delete[] nv;
 }
 
+void Mesh::buildAdjacency( ) {
+  adjacency.clear();
+  adjacencyFree = -1;
+  adjacencyHead.assign( v.size(), -1 );
+  adjacencyBuilt = true;
+  for ( size_t i = 0; i < faces.size(); i++ )
+    for ( int j = 0; j < int( faces[i].count ); j++ )
+      addAdjacency( int( i ), indices[ faces[i].first + j ] );
+}
+
+void Mesh::addAdjacency( int faceID, int vertexID ) {
+  if ( vertexID >= int( adjacencyHead.size() ) ) adjacencyHead.resize( vertexID + 1, -1 );
+  int node = adjacencyFree;
+  if ( node >= 0 ) {
+    adjacencyFree = adjacency[node].next;
+  } else {
+    node = int( adjacency.size() );
+    adjacency.push_back( AdjacencyNode() );
+  }
+  adjacency[node].face = faceID;
+  adjacency[node].next = adjacencyHead[vertexID];
+  adjacencyHead[vertexID] = node;
+}
+
+void Mesh::removeAdjacency( int faceID, int vertexID ) {
+  if ( vertexID >= int( adjacencyHead.size() ) ) return;
+  int* link = &adjacencyHead[vertexID];
+  while ( *link >= 0 && adjacency[*link].face != faceID ) link = &adjacency[*link].next;
+  if ( *link < 0 ) return;
+  int node = *link;
+  *link = adjacency[node].next;
+  adjacency[node].next = adjacencyFree;
+  adjacencyFree = node;
+}
+
 void Mesh::weldVertices( int a, int b ) {
   Vertex c = ( v[a] + v[b] )/2;
-  for (size_t i = 0; i < f.size(); i++) {
+  if ( !adjacencyBuilt ) buildAdjacency();
+  // only the faces using b are touched, each once
+  IndexVector users( arena );
+  if ( b < int( adjacencyHead.size() ) )
+    for ( int node = adjacencyHead[b]; node >= 0; node = adjacency[node].next )
+      users.push_back( adjacency[node].face );
+  std::sort( users.begin(), users.end() );
+  users.erase( std::unique( users.begin(), users.end() ), users.end() );
+  for (size_t u = 0; u < users.size(); u++) {
+    int i = users[u];
+    if ( faces[i].flags & FACE_HIDDEN ) continue;
+    Face face = getFace( i );
     int indexa = -1;
     int indexb = -1;
-    for (size_t j = 0; j < f[i]->size(); j++) {
-      if (f[i]->getVertex(j) == b) {
+    for (size_t j = 0; j < face.size(); j++) {
+      if (face.getVertex(j) == b) {
         indexb = j;
-      } else if (f[i]->getVertex(j) == a) {
+      } else if (face.getVertex(j) == a) {
         indexa = j;
       }
     }
     if (indexb != -1) {
-      IntVector vtx = f[i]->getVertices();
       if (indexa != -1) {
-        vtx.erase(vtx.begin()+indexb);
-        if (f[i]->hasTexCoords()) {
-          IntVector tcd = f[i]->getTexCoords();
-          tcd.erase(tcd.begin()+indexb);
-          f[i]->setTexCoords( tcd );
+        face.removeVertex( indexb );
+        if (indexb < int( faces[i].texCount )) {
+          int* texcoords = &texIndices[ faces[i].texFirst ];
+          for ( int j = indexb; j < int( faces[i].texCount ) - 1; j++ ) texcoords[j] = texcoords[j + 1];
+          faces[i].texCount--;
         }
       } else {
-        vtx[indexb] = a;
+        indices[ faces[i].first + indexb ] = a;
+        unlinkVertex( i, b );
+        linkVertex( i, a );
+        invalidateGeometry( i );
       }
-      f[i]->setVertices( vtx );
     }
   }
   v[a] = c;
+  touchVertex( a );
   freeVertices.push_back(b);
 }
 
 
 
-Vertex Mesh::faceCenter( int faceID ) {
+const FaceGeometry& Mesh::faceGeometry( int faceID ) const {
+  if ( geometryCache == NULL ) {
+    geometryCache = (CachedGeometry*)arena.allocate( sizeof( CachedGeometry ) * GEOMETRY_CACHE_SIZE );
+    for ( int i = 0; i < GEOMETRY_CACHE_SIZE; i++ ) {
+      new ( (void*)( geometryCache + i ) ) CachedGeometry();
+      geometryCache[i].face = -1;
+    }
+  }
+  CachedGeometry& entry = geometryCache[ faceID & ( GEOMETRY_CACHE_SIZE - 1 ) ];
+  FaceGeometry& geometry = entry.geometry;
+  const FaceRecord& face = faces[ faceID ];
+  int size = face.count;
+  if ( entry.face == faceID ) {
+    int i = 0;
+    while ( i < size && vstamp[ indices[ face.first + i ] ] <= geometry.stamp ) i++;
+    if ( i == size ) return geometry;
+  }
+
   Vertex c;
-  size_t size = f[ faceID ]->size();
-  for ( size_t i = 0; i < size; i++ )
+  for ( int i = 0; i < size; i++ )
     c = c + getFaceVertex( faceID, i );
-  return c / double(size);
-}
+  geometry.center = c / double(size);
+  geometry.h = size > 1 ? getFaceEdge( faceID, 1, 0 ).length() : 0.0;
+  geometry.v = size > 2 ? getFaceEdge( faceID, 1, 2 ).length() : 0.0;
+
+  // TODO : remove hack for multifaces;
+  // TODO : remove hack for non-quads;
+  if ( ( face.flags & FACE_MULTI ) || size != 4 ) {
+    geometry.normal = Vertex( 0.0, 0.0, 1.0 );
+  } else {
+    Vertex a = getFaceEdge( faceID, 1, 0 );
+    Vertex b = getFaceEdge( faceID, 2, 0 );
+    Vertex r = a.cross(b);
+    double length = r.length();
+    geometry.normal = r / length;
+  }
 
-// TODO : remove hack for multifaces;
-// TODO : remove hack for non-quads;
-Vertex Mesh::faceNormal( int faceID ) {
-  if ( f[faceID]->isMultiFace() ) return Vertex( 0.0, 0.0, 1.0 );
-  if ( f[faceID]->size() != 4 ) return Vertex( 0.0, 0.0, 1.0 );
-  Vertex a = getFaceEdge( faceID, 1, 0 );
-  Vertex b = getFaceEdge( faceID, 2, 0 );
-  Vertex r = a.cross(b);
-  double length = r.length();
-  return r / length;
+  geometry.stamp = stamp;
+  entry.face = faceID;
+  return geometry;
 }
 
-IntVector* Mesh::repeatSubdivdeFace( int fid, double snap, bool horizontal ) {
-  if ( f[ fid ]->size() != 4 ) {
-    IntVector* result = new IntVector();
+void Mesh::repeatSubdivdeFace( int fid, double snap, bool horizontal, IndexVector* result ) {
+  Face face = getFace( fid );
+  if ( face.size() != 4 ) {
     result->push_back( fid );
-    return result;
+    return;
   }
   double len = horizontal ? faceH(fid) : faceV(fid);
   snap = math::refineSnap(snap,len);
@@ -199,20 +445,18 @@ IntVector* Mesh::repeatSubdivdeFace( int fid, double snap, bool horizontal ) {
     stepB = getFaceEdge( fid, 1, 2 ) / double(count);
   }
 
-  IntVector* result = new IntVector();
-
-  int mat = f[fid]->getMaterial();
+  int mat = face.getMaterial();
 
   int ai = 0 , bi = 0;
   int pai = 0, pbi = 0;
   int as = 0, bs = 0;
 
   if (horizontal) {
-    as = f[fid]->getVertex(3);
-    bs = f[fid]->getVertex(0);
+    as = face.getVertex(3);
+    bs = face.getVertex(0);
   } else {
-    as = f[fid]->getVertex(0);
-    bs = f[fid]->getVertex(1);
+    as = face.getVertex(0);
+    bs = face.getVertex(1);
   }
   pai = as;
   pbi = bs;
@@ -227,21 +471,20 @@ IntVector* Mesh::repeatSubdivdeFace( int fid, double snap, bool horizontal ) {
     ai = addVertex(a);
     bi = addVertex(b);
 
-    Face* face = new Face();
-    face->setMaterial( mat );
-    face->clearVertices();
+    int added = addFace( mat );
+    Face part = getFace( added );
     if (horizontal) {
-      face->addVertex( pbi );
-      face->addVertex( bi );
-      face->addVertex( ai );
-      face->addVertex( pai );
+      part.addVertex( pbi );
+      part.addVertex( bi );
+      part.addVertex( ai );
+      part.addVertex( pai );
     } else {
-      face->addVertex( pai );
-      face->addVertex( pbi );
-      face->addVertex( bi );
-      face->addVertex( ai );
+      part.addVertex( pai );
+      part.addVertex( pbi );
+      part.addVertex( bi );
+      part.addVertex( ai );
     }
-    result->push_back( addFace( face ) );
+    result->push_back( added );
 
     pai = ai;
     pbi = bi;
@@ -250,30 +493,29 @@ IntVector* Mesh::repeatSubdivdeFace( int fid, double snap, bool horizontal ) {
   result->push_back(fid);
 
   if (horizontal) {
-    int idx1 = f[fid]->getVertex(1);
-    int idx2 = f[fid]->getVertex(2);
-    f[fid]->clearVertices();
-    f[fid]->addVertex( bi );
-    f[fid]->addVertex( idx1 );
-    f[fid]->addVertex( idx2 );
-    f[fid]->addVertex( ai );
+    int idx1 = face.getVertex(1);
+    int idx2 = face.getVertex(2);
+    face.clearVertices();
+    face.addVertex( bi );
+    face.addVertex( idx1 );
+    face.addVertex( idx2 );
+    face.addVertex( ai );
   } else {
-    int idx2 = f[fid]->getVertex(2);
-    int idx3 = f[fid]->getVertex(3);
-    f[fid]->clearVertices();
-    f[fid]->addVertex( ai );
-    f[fid]->addVertex( bi );
-    f[fid]->addVertex( idx2 );
-    f[fid]->addVertex( idx3 );
+    int idx2 = face.getVertex(2);
+    int idx3 = face.getVertex(3);
+    face.clearVertices();
+    face.addVertex( ai );
+    face.addVertex( bi );
+    face.addVertex( idx2 );
+    face.addVertex( idx3 );
   }
-  return result;
 }
 
-IntVector* Mesh::splitFace(int fid, DoubleVector* splitData, bool horizontal, double ssnap) {
-  if ( f[ fid ]->size() != 4 ) {
-    IntVector* result = new IntVector();
+void Mesh::splitFace(int fid, DoubleVector* splitData, bool horizontal, double ssnap, IndexVector* result) {
+  Face face = getFace( fid );
+  if ( face.size() != 4 ) {
     result->push_back( fid );
-    return result;
+    return;
   }
   Vertex stepA, stepB;
 
@@ -307,20 +549,18 @@ IntVector* Mesh::splitFace(int fid, DoubleVector* splitData, bool horizontal, do
     stepB = getFaceEdge( fid, 1, 2 ).norm();
   }
 
-  IntVector* result = new IntVector();
-
-  int mat = f[fid]->getMaterial();
+  int mat = face.getMaterial();
 
   int ai = 0 , bi = 0;
   int pai = 0, pbi = 0;
   int as = 0, bs = 0;
 
   if (horizontal) {
-    as = f[fid]->getVertex(3);
-    bs = f[fid]->getVertex(0);
+    as = face.getVertex(3);
+    bs = face.getVertex(0);
   } else {
-    as = f[fid]->getVertex(0);
-    bs = f[fid]->getVertex(1);
+    as = face.getVertex(0);
+    bs = face.getVertex(1);
   }
   pai = as;
   pbi = bs;
@@ -349,21 +589,20 @@ IntVector* Mesh::splitFace(int fid, DoubleVector* splitData, bool horizontal, do
       bi = addVertex(b);
     }
 
-    Face* face = new Face();
-    face->setMaterial( mat );
-    face->clearVertices();
+    int added = addFace( mat );
+    Face part = getFace( added );
     if (horizontal) {
-      face->addVertex( pbi );
-      face->addVertex( bi );
-      face->addVertex( ai );
-      face->addVertex( pai );
+      part.addVertex( pbi );
+      part.addVertex( bi );
+      part.addVertex( ai );
+      part.addVertex( pai );
     } else {
-      face->addVertex( pai );
-      face->addVertex( pbi );
-      face->addVertex( bi );
-      face->addVertex( ai );
+      part.addVertex( pai );
+      part.addVertex( pbi );
+      part.addVertex( bi );
+      part.addVertex( ai );
     }
-    result->push_back(addFace(face));
+    result->push_back( added );
 
     pai = ai;
     pbi = bi;
@@ -372,44 +611,90 @@ IntVector* Mesh::splitFace(int fid, DoubleVector* splitData, bool horizontal, do
   result->push_back(fid);
 
   if (horizontal) {
-    int idx1 = f[fid]->getVertex(1);
-    int idx2 = f[fid]->getVertex(2);
-    f[fid]->clearVertices( );
-    f[fid]->addVertex( bi );
-    f[fid]->addVertex( idx1 );
-    f[fid]->addVertex( idx2 );
-    f[fid]->addVertex( ai );
+    int idx1 = face.getVertex(1);
+    int idx2 = face.getVertex(2);
+    face.clearVertices( );
+    face.addVertex( bi );
+    face.addVertex( idx1 );
+    face.addVertex( idx2 );
+    face.addVertex( ai );
   } else {
-    int idx2 = f[fid]->getVertex(2);
-    int idx3 = f[fid]->getVertex(3);
-    f[fid]->clearVertices( );
-    f[fid]->addVertex( ai );
-    f[fid]->addVertex( bi );
-    f[fid]->addVertex( idx2 );
-    f[fid]->addVertex( idx3 );
+    int idx2 = face.getVertex(2);
+    int idx3 = face.getVertex(3);
+    face.clearVertices( );
+    face.addVertex( ai );
+    face.addVertex( bi );
+    face.addVertex( idx2 );
+    face.addVertex( idx3 );
   }
-
-  return result;
 }
 
 void Mesh::output(Output& out, int materialCount) {
   out.meshStart();
   int mat = -1;
+
+  // the scratch vectors are on the heap rather than in the arena, so
+  // the memory is reused by the next zone
+
+  // bucket the faces to write by material with a counting sort, faces of
+  // a material keep their order; start[m] is the first of material m
+  IntVector start( materialCount + 2, 0 );
+  for (size_t i = 0; i < faces.size(); i++)
+    if (writable(faces[i], materialCount)) start[faces[i].material + 1]++;
+  for (int m = 0; m <= materialCount; m++) start[m + 1] += start[m];
+  IntVector order( start[materialCount + 1], 0 );
+  IntVector next( start );
+  for (size_t i = 0; i < faces.size(); i++)
+    if (writable(faces[i], materialCount)) order[next[faces[i].material]++] = int(i);
+
+  // only the vertices and texcoords of written faces are written,
+  // renumbered in the order the faces first use them
+  IntVector vertexMap( v.size(), -1 );
+  IntVector texCoordMap( tc.size(), -1 );
+  IntVector vertexOrder;
+  IntVector texCoordOrder;
+  for (size_t k = 0; k < order.size(); k++) {
+    const FaceRecord& face = faces[order[k]];
+    for (int j = 0; j < int(face.count); j++) {
+      int& mapped = vertexMap[ indices[face.first + j] ];
+      if (mapped < 0) {
+        mapped = int(vertexOrder.size());
+        vertexOrder.push_back( indices[face.first + j] );
+      }
+    }
+    if (face.texCount != face.count) continue;
+    for (int j = 0; j < int(face.texCount); j++) {
+      int& mapped = texCoordMap[ texIndices[face.texFirst + j] ];
+      if (mapped < 0) {
+        mapped = int(texCoordOrder.size());
+        texCoordOrder.push_back( texIndices[face.texFirst + j] );
+      }
+    }
+  }
+
   for (size_t i = 0; i < inside.size(); i++) out.vertex(inside[i],"inside");
   for (size_t i = 0; i < outside.size(); i++) out.vertex(outside[i],"outside");
-  for (size_t i = 0; i < v.size(); i++) out.vertex(v[i]);
-  for (size_t i = 0; i < tc.size(); i++) out.texCoord(tc[i]);
+  for (size_t i = 0; i < vertexOrder.size(); i++) out.vertex(v[vertexOrder[i]]);
+  for (size_t i = 0; i < texCoordOrder.size(); i++) out.texCoord(tc[texCoordOrder[i]]);
   if (passable) out.meshPassable();
 
+  IntVector vertices;
+  IntVector texcoords;
   for (int m = 0; m <= materialCount; m++) {
-    for (size_t i = 0; i < f.size(); i++)
-      if (f[i]->getMaterial() == m) {
-        if (mat != m) out.matref(m);
-        if (passable) out.meshPassable();
-        mat = m;
-        out.face(f[i],mat);
-        mat = f[i]->getMaterial();
-      }
+    for (int k = start[m]; k < start[m + 1]; k++) {
+      const FaceRecord& face = faces[order[k]];
+      vertices.clear();
+      texcoords.clear();
+      for (int j = 0; j < int(face.count); j++)
+        vertices.push_back( vertexMap[ indices[face.first + j] ] );
+      if (face.texCount == face.count)
+        for (int j = 0; j < int(face.texCount); j++)
+          texcoords.push_back( texCoordMap[ texIndices[face.texFirst + j] ] );
+      if (mat != m) out.matref(m);
+      if (passable) out.meshPassable();
+      mat = m;
+      out.face(vertices,texcoords,m,mat);
+    }
   }
   out.meshEnd();
 }
@@ -417,12 +702,13 @@ void Mesh::output(Output& out, int materialCount) {
 // TODO: handle texcoords?
 // TODO: handle previous?
 void Mesh::chamferFace( int faceID, double amount ) {
+  Face face = getFace( faceID );
   IntVector old;
-  int size = f[faceID]->size();
+  int size = face.size();
   for (int i = 0; i < size; i++) {
-    old.push_back( f[faceID]->getVertex( i ) );
+    old.push_back( face.getVertex( i ) );
   }
-  f[faceID]->clearVertices();
+  face.clearVertices();
   VertexVector in;
   VertexVector out;
   for (int i = 0; i < size; i++) {
@@ -436,26 +722,29 @@ void Mesh::chamferFace( int faceID, double amount ) {
     a = in[ math::modPrev( i, size ) ] + a * af;
     b = in[ math::modNext( i, size ) ] + b * bf;
     v[old[i]] = a;
-    f[faceID]->addVertex( old[i] );
-    f[faceID]->addVertex( addVertex(b) );
+    touchVertex( old[i] );
+    face.addVertex( old[i] );
+    face.addVertex( addVertex(b) );
   }
 }
 
 // TODO: these coords could be reused!
 void Mesh::textureFaceFull( int faceID ) {
-  f[faceID]->clearTexCoords();
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( 0.0, 0.0 ) ) );
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( 1.0, 0.0 ) ) );
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( 1.0, 1.0 ) ) );
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( 0.0, 1.0 ) ) );
+  Face face = getFace( faceID );
+  face.clearTexCoords();
+  face.addTexCoord( addTexCoord( TexCoord( 0.0, 0.0 ) ) );
+  face.addTexCoord( addTexCoord( TexCoord( 1.0, 0.0 ) ) );
+  face.addTexCoord( addTexCoord( TexCoord( 1.0, 1.0 ) ) );
+  face.addTexCoord( addTexCoord( TexCoord( 0.0, 1.0 ) ) );
 }
 
 void Mesh::textureFaceQuad( int faceID, double au, double av, double bu, double bv ) {
-  f[faceID]->clearTexCoords();
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( au, av ) ) );
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( bu, av ) ) );
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( bu, bv ) ) );
-  f[faceID]->addTexCoord( addTexCoord( TexCoord( au, bv ) ) );
+  Face face = getFace( faceID );
+  face.clearTexCoords();
+  face.addTexCoord( addTexCoord( TexCoord( au, av ) ) );
+  face.addTexCoord( addTexCoord( TexCoord( bu, av ) ) );
+  face.addTexCoord( addTexCoord( TexCoord( bu, bv ) ) );
+  face.addTexCoord( addTexCoord( TexCoord( au, bv ) ) );
 }
 
 void Mesh::textureFace( int faceID, double snap, double tile ) {
@@ -465,38 +754,36 @@ void Mesh::textureFace( int faceID, double snap, double tile ) {
 }
 
 void Mesh::freeFace( int faceID ) {
-  f[faceID]->setOutput( false );
-  for ( size_t i = 0; i < f[faceID]->size(); i++ ) {
-    freeVertices.push_back( f[faceID]->getVertex( i ) );
+  Face face = getFace( faceID );
+  face.setOutput( false );
+  for ( size_t i = 0; i < face.size(); i++ ) {
+    freeVertices.push_back( face.getVertex( i ) );
   }
 }
 
-String Mesh::faceToString(Face* face) {
+String Mesh::faceToString( int faceID ) {
+  Face face = getFace( faceID );
   String result = "Face: ( ";
-  for ( size_t i = 0; i < face->size(); i++ )
-    result += v[ face->getVertex( i ) ].toString() + " ";
+  for ( size_t i = 0; i < face.size(); i++ )
+    result += v[ face.getVertex( i ) ].toString() + " ";
   result += ")";
   return result;
 }
 void Mesh::pushBase( int faceID ) {
+  Face face = getFace( faceID );
   vbase.clear();
-  for ( size_t i = 0; i < f[faceID]->size(); i++ ) {
-    vbase.push_back( v[ f[faceID]->getVertex( i ) ] );
+  for ( size_t i = 0; i < face.size(); i++ ) {
+    vbase.push_back( v[ face.getVertex( i ) ] );
   }
 }
 
 int Mesh::rePushBase( ) {
-  Face* clone = new Face();
+  int cloneID = addFace();
   int fsize = vbase.size();
   for (int i = 0; i < fsize; i++) {
-    clone->addVertex( addVertex( vbase[i] ) );
+    getFace( cloneID ).addVertex( addVertex( vbase[i] ) );
   }
-  return addFace(clone);
-}
-
-
-Mesh::~Mesh() {
-  deletePointerVector( f );
+  return cloneID;
 }
 
 
@@ -13,50 +13,50 @@
 #include "MultiFace.h"
 
 void MultiFace::updateFaces(double z) {
-  for ( size_t fi = 0; fi < comps->size(); fi++ ) {
-    Face* f = comps->at( fi );
-    IntVector vtx = f->getVertices();
-    for ( size_t t = 0; t < f->size(); t++ ) {
-      if (f->getTexCoord(t) < 0) {
-        int vi = f->getCyclicVertex( t );
+  for ( size_t fi = 0; fi < comps.size(); fi++ ) {
+    Face f = mesh->getFace( comps.at( fi ) );
+    IndexVector vtx( f.getVertices() );
+    for ( size_t t = 0; t < f.size(); t++ ) {
+      if (f.getTexCoord(t) < 0) {
+        int vi = f.getCyclicVertex( t );
         Vertex v = mesh->getVertex( vi );
         v.z = z;
         mesh->substituteVertex( vi, v );
       } else {
-        vtx[t] = getCyclicVertex( f->getTexCoord( t ) );
+        vtx[t] = getCyclicVertex( f.getTexCoord( t ) );
       }
     }
-    f->setVertices( vtx );
+    f.setVertices( vtx );
   }
 }
 
 void MultiFace::storeFaces() {
-  for (size_t fi = 0; fi < comps->size(); fi++) {
-    Face* f = comps->at(fi);
-    f->clearTexCoords();
-    for (size_t t = 0; t < f->size(); t++) {
-      f->addTexCoord( getVertexIndex( f->getCyclicVertex(t) ) );
+  for (size_t fi = 0; fi < comps.size(); fi++) {
+    Face f = mesh->getFace( comps.at(fi) );
+    f.clearTexCoords();
+    for (size_t t = 0; t < f.size(); t++) {
+      f.addTexCoord( getVertexIndex( f.getCyclicVertex(t) ) );
     }
   }
 }
 
 
-IntVector* MultiFace::detachFace(int id) {
+bool MultiFace::detachFace(int id, IndexVector* result) {
   printf("Detach face\n");
-  if (comps->size() < 2) return NULL;
-  if (id >= int(comps->size())) return NULL;
+  if (comps.size() < 2) return false;
+  if (id >= int(comps.size())) return false;
   updateFaces(mesh->getVertex(getVertex(0)).z);
   
-  IntVector* result  = new IntVector;
+  size_t detached = result->size();
   IntVector visited;
 
-  Face* f = comps->at(id);
+  Face f = mesh->getFace( comps.at(id) );
 
-  int index = pickRemovalIndex(comps->at(id),&visited);
+  int index = pickRemovalIndex(f,&visited);
 
   while (index >= 0) {
     printf("Element iteration...\n");
-    IntVector nvtx;
+    IndexVector nvtx( mesh->getArena() );
 
     int vid  = getCyclicVertex(index);
     int svid = getCyclicVertex(index);
@@ -66,10 +66,11 @@ IntVector* MultiFace::detachFace(int id) {
       int gindex = getVertexIndex(vid);
       printf("Vertex iteration...(%d,index = %d)\n",vid,gindex);
       if (gindex != -1) lastgindex = gindex;
-      int findex = f->getVertexIndex(vid);
+      int findex = f.getVertexIndex(vid);
       int oindex;
-      Face* oface = getOtherFaceWithVertex(f,vid);
-      oindex = (oface == NULL) ? -1 : oface->getVertexIndex(vid);
+      int ofaceID = getOtherFaceWithVertex(f,vid);
+      Face oface( mesh, ofaceID );
+      oindex = (ofaceID < 0) ? -1 : oface.getVertexIndex(vid);
 
       visited.push_back(vid);
       nvtx.push_back(vid);
@@ -77,16 +78,16 @@ IntVector* MultiFace::detachFace(int id) {
       if (oindex < 0 ) {
         printf("Remove (%d)\n",vid);
         removeVertex(gindex);
-        vid = f->getCyclicVertex(findex+1);
+        vid = f.getCyclicVertex(findex+1);
       } else {
-        int nextovid = oface->getCyclicVertex(oindex-1);
+        int nextovid = oface.getCyclicVertex(oindex-1);
         if (findex < 0) {
           if (gindex < 0) insertVertexBefore(lastgindex,vid);
           vid = nextovid;
         } else {
-          int nextfvid = f->getCyclicVertex(findex+1);
-          int prevfvid = f->getCyclicVertex(findex-1);
-          int prevovid = oface->getCyclicVertex(oindex-1);
+          int nextfvid = f.getCyclicVertex(findex+1);
+          int prevfvid = f.getCyclicVertex(findex-1);
+          int prevovid = oface.getCyclicVertex(oindex-1);
           if (nextovid == nextfvid) {
             vid = nextfvid;
           } else if (prevfvid == nextovid) {
@@ -98,26 +99,24 @@ IntVector* MultiFace::detachFace(int id) {
       }
     } while (vid != svid);
 
-    Face* nface = new Face();
-    nface->setMaterial( getMaterial() );
-    nface->setVertices( nvtx );
-    result->push_back(mesh->addFace(nface));
-    index = pickRemovalIndex(comps->at(id),&visited);
+    int nface = mesh->addFace( getMaterial() );
+    mesh->getFace( nface ).setVertices( nvtx );
+    result->push_back( nface );
+    index = pickRemovalIndex(f,&visited);
   }
 
   printf("Cleaning up\n");
 
-  comps->erase(comps->begin() + id);
+  comps.erase(comps.begin() + id);
 
-  if (result->size() == 0) {
+  bool found = result->size() > detached;
+  if (!found) {
     printf("Result Zero\n");
-    delete result;
-    result = NULL;
   }
   printf("Storing faces\n");
   storeFaces();
   printf("Done\n");
-  return result;
+  return found;
 }
 
 bool MultiFace::isLeftOfVectors(int x, int a, int b, int c) {
@@ -133,16 +132,16 @@ bool MultiFace::isLeftOfVectors(int x, int a, int b, int c) {
 
 // BUUUUUG, doesn't handle inter-face jumps when doing the cut edge!
 
-Face* MultiFace::getOtherFaceWithVertex(Face* f, int vid) {
-  for (size_t fi = 0; fi < comps->size(); fi++) {
-    if (comps->at(fi) != f && comps->at(fi)->hasVertex(vid)) return comps->at(fi);
+int MultiFace::getOtherFaceWithVertex(Face f, int vid) {
+  for (size_t fi = 0; fi < comps.size(); fi++) {
+    if (comps.at(fi) != f.getID() && mesh->getFace( comps.at(fi) ).hasVertex(vid)) return comps.at(fi);
   }
-  return NULL;
+  return -1;
 }
 
-int MultiFace::pickRemovalIndex( Face *f, IntVector* visited ) {
+int MultiFace::pickRemovalIndex( Face f, IntVector* visited ) {
   for ( size_t i = 0; i < size(); i++ ) {
-    if ( f->hasVertex( getCyclicVertex( i ) ) ) {
+    if ( f.hasVertex( getCyclicVertex( i ) ) ) {
       bool found = false;
       if ( visited->size() > 0 ) 
         for ( size_t k = 0; k < visited->size(); k++ )
@@ -156,31 +155,31 @@ int MultiFace::pickRemovalIndex( Face *f, IntVector* visited ) {
   return -1;
 }
 
-void MultiFace::refineFace( Face* f, Face* target ) {
+void MultiFace::refineFace( Face f, Face target ) {
   size_t i = 0;
-  while ( i < f->size() ) {
-    //printf("Intersect... (%d,%d)\n",i,modnext(i,f->size()));
+  while ( i < f.size() ) {
+    //printf("Intersect... (%d,%d)\n",i,modnext(i,f.size()));
     //      printf("Multi%s\n",mesh->faceToString(this).c_str());
     Vector2Dd ipoint;
     int index;
-    Vector2Dd fvi     = mesh->getVertex( f->getCyclicVertex(i) ).toVector2D();
-    Vector2Dd fvinext = mesh->getVertex( f->getCyclicVertex(i+1) ).toVector2D();
+    Vector2Dd fvi     = mesh->getVertex( f.getCyclicVertex(i) ).toVector2D();
+    Vector2Dd fvinext = mesh->getVertex( f.getCyclicVertex(i+1) ).toVector2D();
 
     if (vertexNearestIntersect(fvi,fvinext,ipoint,index,target)) {
       //printf("Nearerst found... (%d) %s : ",index,ipoint.toString().c_str());
-      if (fvinext.equals(mesh->getVertex( target->getCyclicVertex( index+1 ) ).toVector2D())) {
+      if (fvinext.equals(mesh->getVertex( target.getCyclicVertex( index+1 ) ).toVector2D())) {
         //printf("Is common\n");
       } else if (ipoint.equals(fvinext)) {
         //printf("Is samepoint with next\n");
-        target->insertVertexAfter(index,f->getCyclicVertex(i+1));
-      } else if (ipoint.equals(mesh->getVertex( target->getCyclicVertex(index+1) ).toVector2D())) {
+        target.insertVertexAfter(index,f.getCyclicVertex(i+1));
+      } else if (ipoint.equals(mesh->getVertex( target.getCyclicVertex(index+1) ).toVector2D())) {
         //printf("Is samepoint with itself\n");
-        f->insertVertexAfter(i,target->getCyclicVertex(index+1));
+        f.insertVertexAfter(i,target.getCyclicVertex(index+1));
       } else {
         //printf("Is normal\n");
-        int ipid = mesh->addVertex( Vertex( ipoint.x, ipoint.y, mesh->getVertex( f->getCyclicVertex( i ) ).z ) );
-        f->insertVertexAfter(i,ipid);
-        target->insertVertexAfter(index,ipid);
+        int ipid = mesh->addVertex( Vertex( ipoint.x, ipoint.y, mesh->getVertex( f.getCyclicVertex( i ) ).z ) );
+        f.insertVertexAfter(i,ipid);
+        target.insertVertexAfter(index,ipid);
       }
     }
     i++;
@@ -188,24 +187,25 @@ void MultiFace::refineFace( Face* f, Face* target ) {
 }
 
 
-int MultiFace::addFace( Face* f ) {
-  //printf("Addface start... (%d,%d)\n",size(),f->size());
+int MultiFace::addFace( int faceID ) {
+  Face f = mesh->getFace( faceID );
+  //printf("Addface start... (%d,%d)\n",size(),f.size());
   //    printf("Multi%s\n",mesh->faceToString(this).c_str());
   //    printf("Add%s\n",mesh->faceToString(f).c_str());
-  f->setOutput( false );
-  if ( comps->size() == 0 ) {
-    for ( size_t i = 0; i < f->size(); i++ ) 
-      vtx.push_back( f->getVertex( i ) );
+  f.setOutput( false );
+  if ( comps.size() == 0 ) {
+    for ( size_t i = 0; i < f.size(); i++ ) 
+      addVertex( f.getVertex( i ) );
   } else {
-    refineFace(f,this);
-    for (size_t i = 0; i < comps->size(); i++) refineFace(f,comps->at(i));
-    int fsize = f->size();
+    refineFace(f,*this);
+    for (size_t i = 0; i < comps.size(); i++) refineFace(f,mesh->getFace(comps.at(i)));
+    int fsize = f.size();
     int tsize = size();
     //printf("Refined... (%d,%d)\n",tsize,fsize);
-    IntVector newvtx;
+    IndexVector newvtx( mesh->getArena() );
     int index = 0;
     for (index = 0; index < fsize; index++) 
-      if (getVertexIndex(f->getCyclicVertex(index)) < 0 && !vertexInside(f->getCyclicVertex(index))) break;
+      if (getVertexIndex(f.getCyclicVertex(index)) < 0 && !vertexInside(f.getCyclicVertex(index))) break;
     // check if no vertices are inside?
     int end = index;
     bool newf = true;
@@ -216,25 +216,25 @@ int MultiFace::addFace( Face* f ) {
       //printf("--- %d,%d\n",index,newf);
       first = false;
       if (newf) {
-        newvtx.push_back(f->getCyclicVertex(index));
+        newvtx.push_back(f.getCyclicVertex(index));
 	next = math::modNext(index,fsize);
-        getvert = getVertexIndex(f->getCyclicVertex(next));
+        getvert = getVertexIndex(f.getCyclicVertex(next));
       } else {
         newvtx.push_back(getCyclicVertex(index));
         next = math::modNext(index,tsize);
-        getvert = f->getVertexIndex(getCyclicVertex(next));
+        getvert = f.getVertexIndex(getCyclicVertex(next));
       }
       if (getvert != -1) {
         newf = !newf;
         index = getvert;
       } else index = next;
     }
-    vtx = newvtx;
+    setVertices( newvtx );
   }
-  comps->push_back(f);
+  comps.push_back(faceID);
   storeFaces();
-  //printf("Addface end... (%d,%d)\n",size(),f->size());
-  return comps->size()-1;
+  //printf("Addface end... (%d,%d)\n",size(),f.size());
+  return comps.size()-1;
 }
 
 
@@ -253,15 +253,15 @@ bool MultiFace::vertexInside( int vid ) {
 }
 
 
-bool MultiFace::vertexNearestIntersect(const Vector2Dd A, const Vector2Dd B, Vector2Dd &P, int &index, Face* face) {
+bool MultiFace::vertexNearestIntersect(const Vector2Dd A, const Vector2Dd B, Vector2Dd &P, int &index, Face face) {
   double length = (A-B).length();
-  size_t tsize = face->size();
+  size_t tsize = face.size();
   double distance = length + 1.0;
   Vector2Dd R1;
   Vector2Dd R2;
   for ( size_t i = 0; i < tsize; i++ ) {
-    Vector2Dd C = mesh->getVertex( face->getCyclicVertex( i ) ).toVector2D();
-    Vector2Dd D = mesh->getVertex( face->getCyclicVertex(i+1) ).toVector2D();
+    Vector2Dd C = mesh->getVertex( face.getCyclicVertex( i ) ).toVector2D();
+    Vector2Dd D = mesh->getVertex( face.getCyclicVertex(i+1) ).toVector2D();
     int r = math::intersect2D(A,B,C,D,R1,R2);
     if (r > 0) {
       if (!R1.equals(C)) {
@@ -14,157 +14,239 @@
 #include "RuleSet.h"
 #include "MultiFace.h"
 
-int OperationNonterminal::runMesh( Mesh* mesh, int face ) {
-  return ruleset->runMesh( mesh, face, ref );
+int OperationNonterminal::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+  context.callReturn( rule, mesh, face );
+  return face;
+}
+
+bool OperationNonterminal::link( Arena&, const String& owner ) {
+  rule = ruleset->findRule( ref, owner );
+  return rule != NULL;
+}
+
+OperationLoadMaterial::OperationLoadMaterial( RuleSet* _ruleset, Arena& arena, const char* _id, const char* _filename, bool _noradar )
+  : Operation( _ruleset ), slot( _ruleset->internAttr( _id, true ) ), filename( arena.copy( _filename ) ), noradar( _noradar ) {
 }
 
-int OperationLoadMaterial::runMesh( Mesh*, int face ) {
-  ruleset->loadMaterial( id, filename, noradar );
+int OperationLoadMaterial::runMesh( ExecutionContext& context, Mesh*, int face ) const {
+  context.loadMaterial( slot, filename, noradar );
   return face;
 }
 
+void OperationLoadMaterial::write( GrammarWriter& out ) const {
+  out.writeInt( GrammarWriter::OP_LOADMATERIAL );
+  out.writeAttr( slot );
+  out.writeString( filename );
+  out.writeInt( noradar );
+}
+
 
-int OperationAddFace::runMesh( Mesh* mesh, int face ) {
-  if (!mesh->getFace( face )->isMultiFace()) {
+int OperationAddFace::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+  if (!mesh->getFace( face ).isMultiFace()) {
     Logger.log( "OperationAddFace: Error! addface passed on a non-MultiFace face!" );
     return face;
   }
   int newface = mesh->rePushBase();
-  newface = ruleset->runMesh( mesh, newface, ref );
-  ( (MultiFace*) mesh->getFace( face ) )->addFace( mesh->getFace( newface ) );
+  context.callResume( rule, mesh, newface, this );
+  return face;
+}
+
+int OperationAddFace::resume( ExecutionContext&, Mesh* mesh, int face, int result ) const {
+  if ( result == -1 ) return face;
+  MultiFace( mesh, face ).addFace( result );
   return face;
 }
 
-int OperationSpawn::runMesh( Mesh* mesh, int face ) {
-  ruleset->runNewMesh( mesh, face, ref );
+bool OperationAddFace::link( Arena&, const String& owner ) {
+  rule = ruleset->findRule( ref, owner );
+  return rule != NULL;
+}
+
+int OperationSpawn::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+  ruleset->spawnMesh( context, mesh, face, rule );
   return face;
 }
 
-int OperationAssign::runMesh( Mesh* mesh, int face ) {
-  flatten( mesh, face );
-  ruleset->addAttr( attrname, value[0] );
+bool OperationSpawn::link( Arena&, const String& owner ) {
+  rule = ruleset->findRule( ref, owner );
+  return rule != NULL;
+}
+
+OperationAssign::OperationAssign( RuleSet* _ruleset, Expression* _exp, const char* _attrname )
+  : OperationSingle( _ruleset, _exp ), slot( _ruleset->internAttr( _attrname, true ) ) {
+}
+
+int OperationAssign::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+  double value[1];
+  flatten( context, mesh, face, value );
+  context.setAttr( slot, value[0] );
   return face;
 }
 
-OperationMultifaces::OperationMultifaces( RuleSet* _ruleset, Expression* _exp, StringVector* _facerules )
-  : OperationSingle( _ruleset, _exp ), facerules( _facerules ), allsame( false )
+OperationMultifaces::OperationMultifaces( const RuleSet* _ruleset, Arena& arena, Expression* _exp, StringVector* _facerules )
+  : OperationSingle( _ruleset, _exp ), facerules( NULL ), facerefs( NULL ), facecount( 0 ), allsame( false )
 {
-  if ( facerules != NULL ) {
-    if ( facerules->size() == 0 ) {
-      delete facerules;
-      facerules = NULL;
-    } else {
-      if ( facerules->size() == 1 && facerules->at(0)[0] == '@' ) {
-        allsame = true;
-        facerules->at( 0 ).erase( 0, 1 );
-      }
+  if ( _facerules != NULL && _facerules->size() > 0 ) {
+    if ( _facerules->size() == 1 && _facerules->at(0)[0] == '@' ) {
+      allsame = true;
+      _facerules->at( 0 ).erase( 0, 1 );
     }
+    std::vector< const char* > names;
+    for ( size_t i = 0; i < _facerules->size(); i++ )
+      names.push_back( arena.copy( _facerules->at( i ) ) );
+    facecount = int( names.size() );
+    facerules = arena.copy( names );
+    facerefs = arena.copy( std::vector< const Rule* >( names.size(), (const Rule*)NULL ) );
   }
+  delete _facerules;
 }
 
-int OperationDetachFace::runMesh(Mesh* mesh,int face) {
-  if ( !mesh->getFace( face)->isMultiFace() ) {
+int OperationDetachFace::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+  if ( !mesh->getFace( face ).isMultiFace() ) {
     Logger.log( "OperationDetachFace: Error! detachface passed on a non-MultiFace face!" );
     return face;
   }
-  flatten( mesh,face );
-  std::auto_ptr<IntVector> faces(( (MultiFace*)mesh->getFace( face ) )->detachFace( math::roundToInt(value[0]) ));
-  if ( faces.get() != NULL ) {
-    OperationMultifaces::runMesh( mesh, face, faces.get() );
+  double value[1];
+  flatten( context, mesh, face, value );
+  IndexVector faces( mesh->getArena() );
+  if ( MultiFace( mesh, face ).detachFace( math::roundToInt(value[0]), &faces ) ) {
+    OperationMultifaces::runMesh( context, mesh, face, &faces );
   }
   return face;
 }
 
 
-int OperationMultifaces::runMesh( Mesh* mesh, int, IntVector* faces ) {
+int OperationMultifaces::runMesh( ExecutionContext& context, Mesh* mesh, int, IndexVector* faces ) const {
   if ( mesh == NULL ) return 0;
   if ( allsame ) {
     for ( size_t i = 0; i < faces->size(); i++ )
-      ruleset->runMesh( mesh, faces->at(i), facerules->at(0) );
+      context.call( facerefs[0], mesh, faces->at(i) );
     return 0;
   }
-  if ( facerules != NULL ) {
-    for ( size_t i = 0; i < facerules->size(); i++ ) {
-      if ( facerules->at(i).empty() ) continue;
-      if ( i >= faces->size() ) break;
-      ruleset->runMesh( mesh, faces->at(i), facerules->at(i) );
-    }
+  for ( int i = 0; i < facecount; i++ ) {
+    if ( facerefs[i] == NULL ) continue;
+    if ( i >= int( faces->size() ) ) break;
+    context.call( facerefs[i], mesh, faces->at(i) );
   }
   return 0;
 }
 
+void OperationMultifaces::writeFaces( GrammarWriter& out ) const {
+  out.writeExpression( exp[0] );
+  if ( !allsame ) {
+    out.writeStrings( facerules, facecount );
+    return;
+  }
+  // the constructor strips the '@' of a repeated face rule
+  String face = '@' + String( facerules[0] );
+  const char* faces[1] = { face.c_str() };
+  out.writeStrings( faces, 1 );
+}
+
+bool OperationMultifaces::link( Arena& arena, const String& owner ) {
+  OperationSingle::link( arena, owner );
+  bool result = true;
+  for ( int i = 0; i < facecount; i++ ) {
+    facerefs[i] = NULL;
+    if ( facerules[i][0] != '\0' ) {
+      facerefs[i] = ruleset->findRule( facerules[i], owner );
+      if ( facerefs[i] == NULL ) result = false;
+    }
+  }
+  return result;
+}
+
 
-int OperationExtrude::runMesh( Mesh* mesh, int face )
+int OperationExtrude::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const
 {
   if ( mesh == NULL ) return 0;
-  flatten( mesh, face );
+  double value[1];
+  flatten( context, mesh, face, value );
   if ( facerules != NULL ) {
-    IntVector faces;
-    mesh->extrudeFace( face, value[0], mesh->getFace( face )->getMaterial(), &faces );
-    OperationMultifaces::runMesh( mesh, face, &faces );
+    IndexVector faces( mesh->getArena() );
+    mesh->extrudeFace( face, value[0], mesh->getFace( face ).getMaterial(), &faces );
+    OperationMultifaces::runMesh( context, mesh, face, &faces );
   } else {
-    mesh->extrudeFace( face, value[0], mesh->getFace( face )->getMaterial() );
+    mesh->extrudeFace( face, value[0], mesh->getFace( face ).getMaterial() );
   }
   return face;
 }
 
-int OperationExtrudeT::runMesh( Mesh* mesh, int face )
+OperationExtrudeT::OperationExtrudeT( RuleSet* _ruleset, Arena& arena, Expression* _exp, StringVector* facerules )
+  : OperationMultifaces( _ruleset, arena, _exp, facerules ),
+    snap( _ruleset->internAttr( "SNAP", false ) ), textile( _ruleset->internAttr( "TEXTILE", false ) ) {
+}
+
+int OperationExtrudeT::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const
 {
   if (mesh == NULL) return 0;
-  flatten( mesh, face );
-  IntVector faces;
-  mesh->extrudeFace( face, value[0], mesh->getFace( face )->getMaterial(), &faces );
+  double value[1];
+  flatten( context, mesh, face, value );
+  IndexVector faces( mesh->getArena() );
+  mesh->extrudeFace( face, value[0], mesh->getFace( face ).getMaterial(), &faces );
 
-  double snap    = ruleset->getAttr( "SNAP" );
-  double textile = ruleset->getAttr( "TEXTILE" );
+  double snapvalue    = context.getAttr( snap );
+  double textilevalue = context.getAttr( textile );
 
   for ( size_t i = 0; i < faces.size(); i++ ) {
-    mesh->textureFace( faces.at(i), snap, textile );
+    mesh->textureFace( faces.at(i), snapvalue, textilevalue );
   }
   if ( facerules != NULL ) {
-    OperationMultifaces::runMesh( mesh, face, &faces );
+    OperationMultifaces::runMesh( context, mesh, face, &faces );
   }
   return face;
 }
 
-int OperationTexture::runMesh( Mesh* mesh, int face ) {
-  mesh->textureFace( face, ruleset->getAttr( "SNAP" ), ruleset->getAttr( "TEXTILE" ) );
+OperationTexture::OperationTexture( RuleSet* _ruleset )
+  : Operation( _ruleset ), 
+    snap( _ruleset->internAttr( "SNAP", false ) ), textile( _ruleset->internAttr( "TEXTILE", false ) ) {
+}
+
+int OperationTexture::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
+  mesh->textureFace( face, context.getAttr( snap ), context.getAttr( textile ) );
   return face;
 }
 
 
-int OperationSplitFace::runMesh( Mesh* mesh,int face ) {
+int OperationSplitFace::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const {
   if ( mesh == NULL ) return 0;
 
-  DoubleVector dv( splits->size() );
-  for ( size_t i = 0; i < splits->size(); i++ )
-    dv[i] = splits->at(i)->calculate( mesh, face );
+  DoubleVector dv( splitcount );
+  for ( int i = 0; i < splitcount; i++ )
+    dv[i] = splits[i]->calculate( context, mesh, face );
 
   double ssnap(0.0);
-  if (exp[0] != NULL) ssnap = exp[0]->calculate(mesh, face);
-  std::auto_ptr<IntVector> faces(mesh->splitFace( face, &dv, horiz, ssnap ));
+  if (exp[0] != NULL) ssnap = exp[0]->calculate(context, mesh, face);
+  IndexVector faces( mesh->getArena() );
+  mesh->splitFace( face, &dv, horiz, ssnap, &faces );
 
   if (facerules != NULL) {
-    OperationMultifaces::runMesh( mesh, face, faces.get() );
+    OperationMultifaces::runMesh( context, mesh, face, &faces );
   }
   return face;
 }
 
-int OperationRepeat::runMesh( Mesh* mesh,int face )
+bool OperationSplitFace::link( Arena& arena, const String& owner ) {
+  for ( int i = 0; i < splitcount; i++ )
+    splits[i] = ExpressionProgram::compileTree( arena, splits[i] );
+  return OperationMultifaces::link( arena, owner );
+}
+
+int OperationRepeat::runMesh( ExecutionContext& context, Mesh* mesh, int face ) const
 {
   if (mesh == NULL) return 0;
-  flatten( mesh, face );
-  std::auto_ptr<IntVector> faces(mesh->repeatSubdivdeFace( face, value[0], horiz ));
+  double value[1];
+  flatten( context, mesh, face, value );
+  IndexVector faces( mesh->getArena() );
+  mesh->repeatSubdivdeFace( face, value[0], horiz, &faces );
   if (facerules != NULL) {
-    OperationMultifaces::runMesh( mesh, face, faces.get() );
+    OperationMultifaces::runMesh( context, mesh, face, &faces );
   }
   return face;
 }
 
-int OperationMultiFace::runMesh(Mesh* mesh, int face) {
-  MultiFace* mf = new MultiFace(mesh);
-  mf->addFace(mesh->getFace(face));
-  mesh->substituteFace( face, mf );
+int OperationMultiFace::runMesh( ExecutionContext&, Mesh* mesh, int face ) const {
+  mesh->makeMultiFace( face );
   return face;
 }
 
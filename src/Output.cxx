@@ -0,0 +1,262 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "Output.h"
+#include <cstdio>
+
+namespace {
+  const double POWERS_OF_TEN[ Output::MAX_PRECISION + 1 ] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+  };
+
+  // Scaled values below this split exactly into whole and fraction.
+  const double MAX_SCALED = 1125899906842624.0; // 2^50
+
+  // Splits a into two halves with 26 significant bits each.
+  inline void split( double a, double& high, double& low ) {
+    double c = 134217729.0 * a; // 2^27 + 1
+    high = c - ( c - a );
+    low = a - high;
+  }
+
+  // Returns a * b - product exactly, where product is the rounded a * b
+  // (Dekker's product).
+  inline double productError( double a, double b, double product ) {
+    double ah, al, bh, bl;
+    split( a, ah, al );
+    split( b, bh, bl );
+    return ( ( ah * bh - product ) + ah * bl + al * bh ) + al * bl;
+  }
+
+  // Writes the decimal digits of value, returns the end.
+  inline char* formatUnsigned( char* out, unsigned long value ) {
+    char digits[20];
+    int count = 0;
+    do {
+      digits[count++] = char( '0' + value % 10 );
+      value /= 10;
+    } while ( value != 0 );
+    while ( count > 0 ) *out++ = digits[--count];
+    return out;
+  }
+
+  // Writes the decimal digits of a whole number below 2^53, returns the 
+  // end. Split in parts of nine digits, as unsigned long may be 32 bits.
+  inline char* formatWhole( char* out, double value ) {
+    double high = floor( value / 1e9 );
+    unsigned long low = (unsigned long)( value - high * 1e9 );
+    if ( high == 0.0 ) return formatUnsigned( out, low );
+    out = formatUnsigned( out, (unsigned long)high );
+    for ( int i = 8; i >= 0; i-- ) {
+      out[i] = char( '0' + low % 10 );
+      low /= 10;
+    }
+    return out + 9;
+  }
+}
+
+Output::Output(OutStream* _outstream, String _texturepath, int _precision) 
+  : outstream(_outstream), writer(NULL), texturepath(_texturepath ), vertices(0), texcoords(0), faces(0),
+    precision(math::min(math::max(_precision, 0), int(MAX_PRECISION))),
+    buffer(new char[BUFFER_SIZE]), capacity(BUFFER_SIZE), used(0), grows(0) {}
+
+Output::Output(AsyncWriter* _writer, String _texturepath, int _precision) 
+  : outstream(NULL), writer(_writer), texturepath(_texturepath ), vertices(0), texcoords(0), faces(0),
+    precision(math::min(math::max(_precision, 0), int(MAX_PRECISION))),
+    buffer(_writer->acquire()), capacity(_writer->getBufferSize()), used(0), grows(0) {}
+
+Output::Output(String _texturepath, int _precision) 
+  : outstream(NULL), writer(NULL), texturepath(_texturepath ), vertices(0), texcoords(0), faces(0),
+    precision(math::min(math::max(_precision, 0), int(MAX_PRECISION))),
+    buffer(new char[CHUNK_SIZE]), capacity(CHUNK_SIZE), used(0), grows(0) {}
+
+Output::~Output() {
+  if (writer != NULL) {
+    writer->submit(buffer, used);
+    return;
+  }
+  flush();
+  delete[] buffer;
+}
+
+void Output::flush() {
+  if (used == 0) return;
+  if (writer != NULL) {
+    writer->submit(buffer, used);
+    buffer = writer->acquire();
+  } else if (outstream != NULL) {
+    outstream->write(buffer, std::streamsize(used));
+  } else {
+    return;
+  }
+  used = 0;
+}
+
+void Output::append(Output& other) {
+  if (outstream != NULL && other.used >= capacity / 2) {
+    flush();
+    outstream->write(other.buffer, std::streamsize(other.used));
+  } else {
+    put(other.buffer, other.used);
+  }
+  vertices += other.vertices;
+  texcoords += other.texcoords;
+  faces += other.faces;
+  other.used = 0;
+  other.vertices = other.texcoords = other.faces = 0;
+}
+
+char* Output::detach(size_t& size) {
+  if (used == capacity) {
+    // room for the NUL
+    put("", 1);
+    used--;
+  }
+  buffer[used] = '\0';
+  char* text = buffer;
+  size = used;
+  buffer = new char[CHUNK_SIZE];
+  capacity = CHUNK_SIZE;
+  used = 0;
+  return text;
+}
+
+void Output::put(const char* data, size_t size) {
+  if (used + size > capacity) {
+    if (writer != NULL) {
+      // fill the buffers up, handing each to the writer
+      while (used + size > capacity) {
+        size_t part = capacity - used;
+        memcpy(buffer + used, data, part);
+        used += part;
+        data += part;
+        size -= part;
+        flush();
+      }
+    } else if (outstream == NULL) {
+      capacity = math::max(capacity * 2, used + size);
+      char* grown = new char[capacity];
+      memcpy(grown, buffer, used);
+      delete[] buffer;
+      buffer = grown;
+      grows++;
+    } else {
+      flush();
+      if (size > capacity) {
+        outstream->write(data, std::streamsize(size));
+        return;
+      }
+    }
+  }
+  memcpy(buffer + used, data, size);
+  used += size;
+}
+
+void Output::put(int value) {
+  char text[16];
+  char* end = text;
+  unsigned long magnitude = (unsigned long)value;
+  if (value < 0) {
+    *end++ = '-';
+    magnitude = 0UL - magnitude;
+  }
+  end = formatUnsigned(end, magnitude);
+  put(text, size_t(end - text));
+}
+
+void Output::put(double value) {
+  char text[32];
+  char* end = text;
+  if (!(fabs(value) < 1e15)) {
+    // huge, or not a number at all
+    put(text, size_t(sprintf(text, "%.17g", value)));
+    return;
+  }
+  double scale = POWERS_OF_TEN[precision];
+  // rounded as printf does, to the nearest and ties to even, using the
+  // exact product where the rounded one looks like a tie
+  double raw = fabs(value) * scale;
+  double scaled = floor(raw);
+  if (raw - scaled > 0.5) {
+    scaled += 1.0;
+  } else if (raw - scaled == 0.5) {
+    double error = productError(fabs(value), scale, raw);
+    if (error > 0.0 || (error == 0.0 && fmod(scaled, 2.0) != 0.0)) scaled += 1.0;
+  }
+  if (scaled == 0.0) {
+    // no "-0"
+    put("0", 1);
+    return;
+  }
+  if (!(scaled < MAX_SCALED)) {
+    // too many digits to split exactly, printf formats the same
+    end += sprintf(text, "%.*f", precision, value);
+    if (precision > 0) {
+      while (end[-1] == '0') end--;
+      if (end[-1] == '.') end--;
+    }
+    put(text, size_t(end - text));
+    return;
+  }
+  if (value < 0) *end++ = '-';
+  double whole = floor(scaled / scale);
+  // below 10^MAX_PRECISION, so it fits even a 32 bit unsigned long
+  unsigned long fraction = (unsigned long)(scaled - whole * scale);
+  end = formatWhole(end, whole);
+  if (fraction != 0) {
+    *end++ = '.';
+    int digits = precision;
+    while (fraction % 10 == 0) {
+      fraction /= 10;
+      digits--;
+    }
+    for (int i = digits - 1; i >= 0; i--) {
+      end[i] = char('0' + fraction % 10);
+      fraction /= 10;
+    }
+    end += digits;
+  }
+  put(text, size_t(end - text));
+}
+
+void Output::face(const IntVector& vertices, const IntVector& texcoords, int material, int lastmat) { 
+  faces++;
+  (*this) << "  face\n";
+
+  if (lastmat >= 0) {
+    if (material != lastmat) matref(material);
+  }
+
+  (*this) << "    vertices ";
+  for (size_t i = 0; i < vertices.size(); i++) {
+    (*this) << vertices[i] << " ";
+  }
+  (*this) << "\n";
+
+  if (!texcoords.empty()) {
+    (*this) << "    texcoords ";
+    for (size_t i = 0; i < texcoords.size(); i++) {
+      (*this) << texcoords[i] << " ";
+    }
+    (*this) << "\n";
+  }
+
+  (*this) << "  endface\n";
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -10,30 +10,68 @@
  * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include <algorithm>
 #include "Rule.h"
-#include "Random.h"
 
-Product* Rule::getProduct( Mesh* mesh, int face ) {
-  int size = products->size();
+Product* Rule::getProduct( ExecutionContext& context, Mesh* mesh, int face ) const {
+  int size = count;
   if ( size == 0 ) return NULL;
-  ProductVectIter itr = products->begin();
-  double roll = Random::double01();
-  do {
-    if ( (*itr)->conditionsMet( mesh, face ) ) {
-      double rarity = (*itr)->getRarity();
-      if ( rarity >= roll ) return (*itr);
-      roll -= rarity;
+  double roll = context.getRandom().double01();
+  int i = 0;
+  while ( i < size ) {
+    int end = runEnd[i];
+    if ( end > i ) {
+      const double* first = cumulative + i;
+      const double* last = cumulative + end;
+      const double* found = std::lower_bound( first, last, roll );
+      // a roll right at the boundary of two products is walked like a
+      // conditional run, subtracting one rarity after the other, so that
+      // the summed rarities can't round it onto a different product
+      double epsilon = SELECTION_EPSILON * math::max( 1.0, *( last - 1 ) );
+      if ( found != last && *found - roll > epsilon 
+	   && ( found == first || roll - *( found - 1 ) > epsilon ) )
+	return products[i + int( found - first )];
+      for ( ; i < end; i++ ) {
+	double rarity = products[i]->getRarity();
+	if ( rarity >= roll ) return products[i];
+	roll -= rarity;
+      }
+    } else {
+      Product* product = products[i];
+      if ( product->conditionsMet( context, mesh, face ) ) {
+	double rarity = product->getRarity();
+	if ( rarity >= roll ) return product;
+	roll -= rarity;
+      }
+      i++;
     }
-    ++itr;
-  } while ( itr != products->end() );
+  }
   Logger.log( 1, "Warning : Rule '%s' returned no product!", name.c_str() );
   return NULL;
 }
-int Rule::runMesh( Mesh* mesh, int face ) {
-  Logger.log( 4, "Rule : rule '%s' getting product...", name.c_str() );
-  Product* product = getProduct( mesh, face );
-  Logger.log( 4, "Rule : running product...", name.c_str() );
-  return product == NULL ? -1 : product->runMesh( mesh, face );
+bool Rule::link( Arena& arena ) {
+  bool result = true;
+  for ( int i = 0; i < count; i++ )
+    if ( !products[i]->link( arena, name ) ) result = false;
+
+  // Products with a negative rarity would break the ordering of the
+  // cumulative rarities, so they are handled like conditional ones.
+  int size = count;
+  IntVector ends( size, 0 );
+  DoubleVector sums( size, 0.0 );
+  for ( int i = size - 1; i >= 0; i-- ) {
+    Product* product = products[i];
+    bool table = !product->isConditional() && product->getRarity() >= 0.0;
+    ends[i] = !table ? i : ( i + 1 < size && ends[i + 1] > i + 1 ? ends[i + 1] : i + 1 );
+  }
+  for ( int i = 0; i < size; i++ ) {
+    double rarity = products[i]->getRarity();
+    bool start = i == 0 || ends[i] == i || ends[i - 1] != ends[i];
+    sums[i] = start ? rarity : sums[i - 1] + rarity;
+  }
+  runEnd = arena.copy( ends );
+  cumulative = arena.copy( sums );
+  return result;
 }
 
 // Local Variables: ***
@@ -0,0 +1,208 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "RuleParser.h"
+#include "RuleSet.h"
+#include "Rule.h"
+#include "Product.h"
+#include "Operation.h"
+#include "Expression.h"
+#include "parser.hxx"
+
+/** A keyword of the grammar, it's length and it's token. */
+struct Keyword {
+  const char* name;
+  size_t length;
+  int token;
+};
+
+#define KEYWORD( name, token ) { name, sizeof( name ) - 1, token }
+
+static const Keyword keywords[] = {
+  KEYWORD( "extrude", EXTRUDE ),
+  KEYWORD( "extrudet", EXTRUDET ),
+  KEYWORD( "expand", EXPAND ),
+  KEYWORD( "chamfer", CHAMFER ),
+  KEYWORD( "unchamfer", UNCHAMFER ),
+  KEYWORD( "random", RANDOM ),
+  KEYWORD( "assign", ASSIGN ),
+  KEYWORD( "scale", SCALE ),
+  KEYWORD( "translate", TRANSLATE ),
+  KEYWORD( "translater", TRANSLATER ),
+  KEYWORD( "material", MATERIAL ),
+  KEYWORD( "loadmaterial", LOADMATERIAL ),
+  KEYWORD( "loadmaterialnr", LOADMATERIALNR ),
+  KEYWORD( "multiface", MULTIFACE ),
+  KEYWORD( "repeath", REPEATH ),
+  KEYWORD( "repeatv", REPEATV ),
+  KEYWORD( "splith", SPLITH ),
+  KEYWORD( "splitv", SPLITV ),
+  KEYWORD( "face", FACE ),
+  KEYWORD( "addface", ADDFACE ),
+  KEYWORD( "detachface", DETACHFACE ),
+  KEYWORD( "free", FREE ),
+  KEYWORD( "ngon", NGON ),
+  KEYWORD( "drivethrough", DRIVETHROUGH ),
+  KEYWORD( "texture", TEXTURE ),
+  KEYWORD( "texturefull", TEXTUREFULL ),
+  KEYWORD( "texturequad", TEXTUREQUAD ),
+  KEYWORD( "textureclear", TEXTURECLEAR ),
+  KEYWORD( "assert", ASSERTION ),
+  KEYWORD( "spawn", SPAWN ),
+  KEYWORD( "remove", REMOVE ),
+  KEYWORD( "taper", TAPER ),
+  KEYWORD( "neg", NEG ),
+  KEYWORD( "round", ROUND )
+};
+
+static bool isDigit( char c ) {
+  return c >= '0' && c <= '9';
+}
+
+static bool isIdentifierStart( char c ) {
+  return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || c == '_';
+}
+
+static bool isIdentifier( char c ) {
+  return isIdentifierStart( c ) || isDigit( c );
+}
+
+bool RuleParser::parse( ) {
+  FILE* file = fopen( filename.c_str(), "rb" );
+  if ( file == NULL ) {
+    Logger.log( "RuleParser : couldn't open %s!", filename.c_str() );
+    return false;
+  }
+  String text;
+  char buffer[4096];
+  size_t count;
+  while ( ( count = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 )
+    text.append( buffer, count );
+  bool failed = ferror( file ) != 0;
+  fclose( file );
+  if ( failed ) {
+    Logger.log( "RuleParser : couldn't read %s!", filename.c_str() );
+    return false;
+  }
+  return parse( text );
+}
+
+bool RuleParser::parse( const String& text ) {
+  source = text;
+  pos = 0;
+  line = 1;
+  parsed = yyparse( this ) == 0;
+  return parsed;
+}
+
+void RuleParser::commit( ) {
+  for ( size_t i = 0; i < rules.size(); i++ )
+    ruleset->addRule( rules[i].first, rules[i].second );
+  rules.clear();
+  ruleset->getArena().merge( arena );
+}
+
+// The tokens are those of the flex scanner the grammar was written for,
+// including it's longest match rules -- a minus directly followed by a
+// digit starts a number, and a number may end with 'r'.
+int RuleParser::lex( YYSTYPE* value ) {
+  const char* text = source.c_str();
+  size_t size = source.size();
+  for (;;) {
+    if ( pos >= size ) return 0;
+    char c = text[pos];
+    if ( c == '\n' ) {
+      line++;
+      pos++;
+    } else if ( c == ' ' || c == '\t' || c == '\r' ) {
+      pos++;
+    } else if ( c == '#' ) {
+      while ( pos < size && text[pos] != '\n' && text[pos] != '\r' ) pos++;
+    } else {
+      break;
+    }
+  }
+
+  size_t start = pos;
+  char c = text[pos];
+  if ( c == '-' && pos + 1 < size && text[pos + 1] == '>' ) {
+    pos += 2;
+    return DEFSIGN;
+  }
+
+  if ( isDigit( c ) || ( c == '-' && pos + 1 < size && isDigit( text[pos + 1] ) ) ) {
+    if ( c == '-' ) pos++;
+    while ( pos < size && isDigit( text[pos] ) ) pos++;
+    if ( pos < size && text[pos] == '.' ) {
+      pos++;
+      while ( pos < size && isDigit( text[pos] ) ) pos++;
+    }
+    char number[64];
+    size_t length = math::min( pos - start, sizeof( number ) - 1 );
+    memcpy( number, text + start, length );
+    number[length] = '\0';
+    value->fl = atof( number );
+    // relative values are negative, only unsigned numbers can be relative
+    if ( c != '-' && pos < size && text[pos] == 'r' ) {
+      pos++;
+      value->fl = -value->fl;
+    }
+    return NUMBER;
+  }
+
+  if ( c == '$' && pos + 1 < size && isIdentifierStart( text[pos + 1] ) ) {
+    pos++;
+    while ( pos < size && isIdentifier( text[pos] ) ) pos++;
+    value->id = identifier( text + start + 1, pos - start - 1 );
+    return ATTRIBUTE;
+  }
+
+  if ( isIdentifierStart( c ) ) {
+    while ( pos < size && isIdentifier( text[pos] ) ) pos++;
+    size_t length = pos - start;
+    for ( size_t i = 0; i < sizeof( keywords ) / sizeof( keywords[0] ); i++ )
+      if ( keywords[i].length == length && strncmp( keywords[i].name, text + start, length ) == 0 )
+	return keywords[i].token;
+    value->id = identifier( text + start, length );
+    return NONTERM;
+  }
+
+  pos++;
+  return (unsigned char)c;
+}
+
+void RuleParser::error( const char* message ) {
+  Logger.log( "RuleParser : %s in %s at line %d", message, filename.c_str(), line );
+}
+
+char* RuleParser::identifier( const char* text, size_t length ) {
+  char* copy = new char[length + 1];
+  memcpy( copy, text, length );
+  copy[length] = '\0';
+  identifiers.push_back( copy );
+  return copy;
+}
+
+RuleParser::~RuleParser( ) {
+  for ( size_t i = 0; i < identifiers.size(); i++ )
+    delete[] identifiers[i];
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -0,0 +1,115 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <algorithm>
+#include "RuleProfiler.h"
+#include "Rule.h"
+
+void RuleProfile::merge( const RuleProfile& other ) {
+  for ( EntryMap::const_iterator itr = other.entries.begin(); itr != other.entries.end(); ++itr ) {
+    Entry& entry = entries[itr->first];
+    entry.counters.add( itr->second.counters );
+    std::map< const Product*, ProfileCounters >::const_iterator product = itr->second.products.begin();
+    for ( ; product != itr->second.products.end(); ++product )
+      entry.products[product->first].add( product->second );
+  }
+}
+
+typedef std::pair< const Rule*, const RuleProfile::Entry* > ProfileRow;
+
+// most expensive first, ties by name so that the report is stable
+static bool compareRows( const ProfileRow& a, const ProfileRow& b ) {
+  if ( a.second->counters.exclusive != b.second->counters.exclusive )
+    return a.second->counters.exclusive > b.second->counters.exclusive;
+  return a.first->getName() < b.first->getName();
+}
+
+static std::vector< ProfileRow > sortedRows( const RuleProfile& profile ) {
+  std::vector< ProfileRow > rows;
+  const RuleProfile::EntryMap& entries = profile.getEntries();
+  for ( RuleProfile::EntryMap::const_iterator itr = entries.begin(); itr != entries.end(); ++itr )
+    rows.push_back( ProfileRow( itr->first, &itr->second ) );
+  std::sort( rows.begin(), rows.end(), compareRows );
+  return rows;
+}
+
+// products in the order they're defined in the rule
+static std::vector< std::pair< int, const ProfileCounters* > > sortedProducts( const Rule* rule, const RuleProfile::Entry* entry ) {
+  std::vector< std::pair< int, const ProfileCounters* > > products;
+  std::map< const Product*, ProfileCounters >::const_iterator itr = entry->products.begin();
+  for ( ; itr != entry->products.end(); ++itr )
+    products.push_back( std::make_pair( rule->productIndex( itr->first ), &itr->second ) );
+  std::sort( products.begin(), products.end() );
+  return products;
+}
+
+static void writeTextRow( FILE* file, const char* name, const ProfileCounters& c ) {
+  fprintf( file, "%-32s %10lu %8lu %12.3f %12.3f %10ld %10ld\n", name, c.calls, c.failures,
+	   c.inclusive * 1000.0, c.exclusive * 1000.0, c.faces, c.vertices );
+}
+
+bool RuleProfiler::writeText( const String& filename ) {
+  MutexLock lock( mutex );
+  FILE* file = fopen( filename.c_str(), "w" );
+  if ( file == NULL ) return false;
+  std::vector< ProfileRow > rows = sortedRows( profile );
+  fprintf( file, "BZWGen rule profile, %d rules, %.3f s total wall time\n", int( rows.size() ), monotonicTime() - start );
+  fprintf( file, "Rules are sorted by exclusive time, faces and vertices are those added by the rule itself.\n\n" );
+  fprintf( file, "%-32s %10s %8s %12s %12s %10s %10s\n", "rule / product", "calls", "failed", "incl ms", "excl ms", "faces", "vertices" );
+  for ( size_t i = 0; i < rows.size(); i++ ) {
+    writeTextRow( file, rows[i].first->getName().c_str(), rows[i].second->counters );
+    std::vector< std::pair< int, const ProfileCounters* > > products = sortedProducts( rows[i].first, rows[i].second );
+    if ( products.size() < 2 ) continue;
+    for ( size_t j = 0; j < products.size(); j++ ) {
+      char name[32];
+      sprintf( name, "  product %d", products[j].first );
+      writeTextRow( file, name, *products[j].second );
+    }
+  }
+  return fclose( file ) == 0;
+}
+
+static void writeJSONCounters( FILE* file, const ProfileCounters& c ) {
+  fprintf( file, "\"calls\": %lu, \"failures\": %lu, \"inclusive\": %.9f, \"exclusive\": %.9f, \"faces\": %ld, \"vertices\": %ld",
+	   c.calls, c.failures, c.inclusive, c.exclusive, c.faces, c.vertices );
+}
+
+bool RuleProfiler::writeJSON( const String& filename ) {
+  MutexLock lock( mutex );
+  FILE* file = fopen( filename.c_str(), "w" );
+  if ( file == NULL ) return false;
+  std::vector< ProfileRow > rows = sortedRows( profile );
+  fprintf( file, "{\n  \"wall\": %.9f,\n  \"rules\": [\n", monotonicTime() - start );
+  for ( size_t i = 0; i < rows.size(); i++ ) {
+    // rule names are grammar identifiers, they need no escaping
+    fprintf( file, "    { \"name\": \"%s\", ", rows[i].first->getName().c_str() );
+    writeJSONCounters( file, rows[i].second->counters );
+    fprintf( file, ",\n      \"products\": [" );
+    std::vector< std::pair< int, const ProfileCounters* > > products = sortedProducts( rows[i].first, rows[i].second );
+    for ( size_t j = 0; j < products.size(); j++ ) {
+      fprintf( file, "%s\n        { \"index\": %d, ", j == 0 ? "" : ",", products[j].first );
+      writeJSONCounters( file, *products[j].second );
+      fprintf( file, " }" );
+    }
+    fprintf( file, " ] }%s\n", i + 1 < rows.size() ? "," : "" );
+  }
+  fprintf( file, "  ]\n}\n" );
+  return fclose( file ) == 0;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -18,41 +18,96 @@ void RuleSet::addRule( String& name, Rule* rule ) {
   rules[name] = rule;
 }
 
-double RuleSet::getAttr( String& name ) {
-  AttributeMap::iterator itr = attrmap.find( name );
-  if ( itr == attrmap.end() ) {
+int RuleSet::internAttr( const String& name, bool assigned ) {
+  MutexLock lock( attrlock );
+  AttributeSlotMap::iterator itr = attrslots.find( name );
+  int slot;
+  if ( itr == attrslots.end() ) {
+    slot = int( attrs.size() );
+    attrslots[name] = slot;
+    attrnames.push_back( name );
+    attrs.push_back( 0.0 );
+    attrassigned.push_back( false );
+    attrread.push_back( false );
+  } else {
+    slot = itr->second;
+  }
+  if ( assigned ) 
+    attrassigned[slot] = true;
+  else
+    attrread[slot] = true;
+  return slot;
+}
+
+int RuleSet::findAttr( const String& name ) const {
+  AttributeSlotMap::const_iterator itr = attrslots.find( name );
+  return itr == attrslots.end() ? -1 : itr->second;
+}
+
+double RuleSet::getAttr( const String& name ) const {
+  int slot = findAttr( name );
+  if ( slot == -1 ) {
     Logger.log( "RuleSet : Warning : attribute '%s' not found!", name.c_str() );
     return 0.0;
   }
-  return itr->second;
+  return attrs[slot];
 }
 
 
 
-int RuleSet::runMesh(Mesh* mesh, int face, String& rulename) {
-  Logger.log( 4, "RuleSet : runMesh, rule '%s', recursion level %d", rulename.c_str(), recursion );
-  if ( recursion == -1 ) return -1;
-  recursion++;
-  if ( recursion == MAX_RECURSION ) {
-    recursion = -1;
-    Logger.log( "RuleSet : Warning : Recursion level 1000 reached! Are you sure you have no infinite loops?");
-    return -1;
+const Rule* RuleSet::findRule( const String& name, const String& owner ) const {
+  RuleMap::const_iterator itr = rules.find( name );
+  if ( itr == rules.end() ) {
+    Logger.log( "RuleSet : Warning : rule '%s' references undefined rule '%s'!", owner.c_str(), name.c_str() );
+    return NULL;
   }
+  return itr->second;
+}
+
+bool RuleSet::link( ) {
+  // references are resolved once, so that running a rule doesn't need
+  // a lookup by name, and undefined rules are reported only here
+  int failed = 0;
+  for ( RuleMapIter itr = rules.begin(); itr != rules.end(); ++itr )
+    if ( !itr->second->link( arena ) ) failed++;
+  Logger.log( 3, "RuleSet : linked %d rules, %d with undefined references.", int( rules.size() ), failed );
+  Logger.log( 3, "RuleSet : grammar takes %d bytes in %d chunks.", int( arena.size() ), arena.chunkCount() );
+  // an attribute that's read but never assigned always evaluates to zero
+  for ( size_t i = 0; i < attrs.size(); i++ )
+    if ( attrread[i] && !attrassigned[i] ) {
+      Logger.log( "RuleSet : Warning : attribute '%s' is used, but never assigned!", attrnames[i].c_str() );
+      failed++;
+    }
+  Logger.log( 3, "RuleSet : %d attributes.", int( attrs.size() ) );
+  return failed == 0;
+}
 
-  RuleMapIter itr = rules.find( rulename );
+int RuleSet::runMesh(ExecutionContext& context, Mesh* mesh, int face, const String& rulename) const {
+  RuleMap::const_iterator itr = rules.find( rulename );
   if ( itr == rules.end() ) {
     Logger.log( "RuleSet : Warning : rule '%s' not found!", rulename.c_str() );
     return -1;
   }
-  Logger.log( 4, "RuleSet : runMesh, rule '%s', recursion level %d, running rule...", rulename.c_str(), recursion );
-  int result = itr->second->runMesh( mesh, face );
-  Logger.log( 4, "RuleSet : runMesh, rule '%s', recursion level %d, rule ran, result = %d...", rulename.c_str(), recursion, result );
+  return runMesh( context, mesh, face, itr->second );
+}
 
-  recursion--;
+int RuleSet::runMesh(ExecutionContext& context, Mesh* mesh, int face, const Rule* rule) const {
+  // unresolved references were reported by link
+  if ( rule == NULL ) return -1;
+  if ( profiler == NULL && !Tracer.isEnabled() ) return context.derive( rule, mesh, face, maxDepth );
+  RuleProfile profile;
+  TraceEventVector trace;
+  if ( profiler != NULL ) context.setProfile( &profile );
+  if ( Tracer.isEnabled() ) context.setTrace( &trace );
+  int result = context.derive( rule, mesh, face, maxDepth );
+  context.setProfile( NULL );
+  context.setTrace( NULL );
+  if ( profiler != NULL ) profiler->merge( profile );
+  Tracer.add( trace );
   return result;
 }
 
-MeshVector* RuleSet::run( Mesh* initial_mesh, int initial_face, String& rulename ) {
+MeshVector* RuleSet::run( ExecutionContext& context, Mesh* initial_mesh, int initial_face, String& rulename ) const {
   assert( initial_mesh );
   Logger.log( 4, "RuleSet : running rule '%s'", rulename.c_str() );
   Vertex normal = initial_mesh->faceNormal( initial_face );
@@ -60,45 +115,65 @@ MeshVector* RuleSet::run( Mesh* initial_mesh, int initial_face, String& rulename
     Logger.log( "RuleSet : run passed a face with bad normal : %s", normal.toString().c_str() );
     return NULL;
   }
-  meshes = new MeshVector();
+  MeshVector* meshes = new MeshVector();
+  context.setMeshes( meshes );
   meshes->push_back( initial_mesh );
   initial_mesh->pushBase( initial_face );
   initial_mesh->addInsideVertex( initial_mesh->faceCenter( initial_face ) + normal * 0.05f );
-  if ( runMesh( initial_mesh, initial_face, rulename ) == -1 )
+  if ( runMesh( context, initial_mesh, initial_face, rulename ) == -1 )
     Logger.log( "RuleSet : run failed with start rule '%s!'", rulename.c_str() );
   return meshes;
 }
 
-int RuleSet::runNewMesh( Mesh* old_mesh, int old_face, String& rulename ) {
-  Logger.log( 4, "RuleSet : runNewMesh, rule '%s'...", rulename.c_str() );
-  Mesh* newmesh = new Mesh();
-  Face* newface = new Face();
-  size_t size = old_mesh->getFace( old_face )->size();
+void RuleSet::spawnMesh( ExecutionContext& context, Mesh* old_mesh, int old_face, const Rule* rule ) const {
+  Logger.log( 4, "RuleSet : spawnMesh..." );
+  // the new mesh belongs to the zone, as the old one does
+  Arena& arena = old_mesh->getArena();
+  Mesh* newmesh = new ( arena ) Mesh( arena );
+  int newfaceid = newmesh->addFace( );
+  Face newface = newmesh->getFace( newfaceid );
+  size_t size = old_mesh->getFace( old_face ).size();
   for ( size_t i = 0; i < size; i++ ) {
-    newface->addVertex( i );
+    newface.addVertex( i );
     newmesh->addVertex( old_mesh->getFaceVertex( old_face, i ) );
   }
-  int newfaceid = newmesh->addFace( newface );
   newmesh->pushBase( newfaceid );
-  meshes->push_back( newmesh );
+  context.getMeshes()->push_back( newmesh );
   newmesh->addInsideVertex( newmesh->faceCenter( newfaceid ) + newmesh->faceNormal( newfaceid ) * 0.05f );
-  return runMesh( newmesh, newfaceid, rulename );
+  context.call( rule, newmesh, newfaceid );
+}
+
+void RuleSet::initialize( ) {
+  // initialize is the only derivation allowed to change the ruleset
+  // itself -- it loads the materials, and it's attributes become the 
+  // starting values of every later derivation
+  ExecutionContext context( attrs );
+  context.setMaterials( &materials );
+  String init = String( "initialize" );
+  runMesh( context, NULL, 0, init );
+  attrs = context.getAttributes();
 }
 
-void RuleSet::loadMaterial( String& id, String& name, bool noradar ) {
-  int matid = materials.size();
-  addAttr( id, double( matid ) );
-  materials.push_back( Material( matid, name, noradar ) );
+void RuleSet::write( GrammarWriter& out ) const {
+  // the slots are restored in order before the rules are read, so the
+  // loaded ruleset gets the same slots as the parsed one
+  out.writeInt( int( attrnames.size() ) );
+  for ( size_t i = 0; i < attrnames.size(); i++ ) {
+    out.writeString( attrnames[i] );
+    out.writeInt( ( attrassigned[i] ? 1 : 0 ) | ( attrread[i] ? 2 : 0 ) );
+  }
+  out.writeInt( int( rules.size() ) );
+  for ( RuleMap::const_iterator itr = rules.begin(); itr != rules.end(); ++itr )
+    itr->second->write( out );
 }
 
-void RuleSet::output( Output& out ) {
-  for ( MaterialVectIter itr = materials.begin(); itr!= materials.end(); ++itr )
+void RuleSet::output( Output& out ) const {
+  for ( MaterialVector::const_iterator itr = materials.begin(); itr!= materials.end(); ++itr )
     (*itr).output( out );
 }
 
 RuleSet::~RuleSet() {
-  for ( RuleMapIter itr = rules.begin();itr != rules.end(); ++itr )
-    delete itr->second;
+  // the rules are freed with the arena
 }
 
 // Local Variables: ***
@@ -0,0 +1,194 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "Thread.h"
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  // condition variables need Vista
+  #ifndef _WIN32_WINNT
+    #define _WIN32_WINNT 0x0600
+  #endif
+  #include <windows.h>
+#else
+  #include <pthread.h>
+  #include <unistd.h>
+  #include <time.h>
+#endif
+
+#ifdef _WIN32
+
+Mutex::Mutex() {
+  CRITICAL_SECTION* cs = new CRITICAL_SECTION;
+  InitializeCriticalSection( cs );
+  handle = cs;
+}
+
+Mutex::~Mutex() {
+  DeleteCriticalSection( (CRITICAL_SECTION*)handle );
+  delete (CRITICAL_SECTION*)handle;
+}
+
+void Mutex::lock() {
+  EnterCriticalSection( (CRITICAL_SECTION*)handle );
+}
+
+void Mutex::unlock() {
+  LeaveCriticalSection( (CRITICAL_SECTION*)handle );
+}
+
+Condition::Condition() {
+  CONDITION_VARIABLE* condition = new CONDITION_VARIABLE;
+  InitializeConditionVariable( condition );
+  handle = condition;
+}
+
+Condition::~Condition() {
+  delete (CONDITION_VARIABLE*)handle;
+}
+
+void Condition::wait( Mutex& mutex ) {
+  SleepConditionVariableCS( (CONDITION_VARIABLE*)handle, (CRITICAL_SECTION*)mutex.handle, INFINITE );
+}
+
+void Condition::broadcast() {
+  WakeAllConditionVariable( (CONDITION_VARIABLE*)handle );
+}
+
+static DWORD WINAPI threadEntry( LPVOID thread ) {
+  ( (Thread*)thread )->run();
+  return 0;
+}
+
+bool Thread::start() {
+  if ( handle ) return false;
+  handle = CreateThread( NULL, 0, threadEntry, this, 0, NULL );
+  return handle != NULL;
+}
+
+void Thread::join() {
+  if ( !handle ) return;
+  WaitForSingleObject( (HANDLE)handle, INFINITE );
+  CloseHandle( (HANDLE)handle );
+  handle = NULL;
+}
+
+int Thread::hardwareThreads() {
+  SYSTEM_INFO info;
+  GetSystemInfo( &info );
+  return info.dwNumberOfProcessors > 0 ? int( info.dwNumberOfProcessors ) : 1;
+}
+
+double monotonicTime() {
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency( &frequency );
+  QueryPerformanceCounter( &counter );
+  return double( counter.QuadPart ) / double( frequency.QuadPart );
+}
+
+unsigned long currentThreadId() {
+  return (unsigned long)GetCurrentThreadId();
+}
+
+#else
+
+Mutex::Mutex() {
+  pthread_mutex_t* mutex = new pthread_mutex_t;
+  pthread_mutex_init( mutex, NULL );
+  handle = mutex;
+}
+
+Mutex::~Mutex() {
+  pthread_mutex_destroy( (pthread_mutex_t*)handle );
+  delete (pthread_mutex_t*)handle;
+}
+
+void Mutex::lock() {
+  pthread_mutex_lock( (pthread_mutex_t*)handle );
+}
+
+void Mutex::unlock() {
+  pthread_mutex_unlock( (pthread_mutex_t*)handle );
+}
+
+Condition::Condition() {
+  pthread_cond_t* condition = new pthread_cond_t;
+  pthread_cond_init( condition, NULL );
+  handle = condition;
+}
+
+Condition::~Condition() {
+  pthread_cond_destroy( (pthread_cond_t*)handle );
+  delete (pthread_cond_t*)handle;
+}
+
+void Condition::wait( Mutex& mutex ) {
+  pthread_cond_wait( (pthread_cond_t*)handle, (pthread_mutex_t*)mutex.handle );
+}
+
+void Condition::broadcast() {
+  pthread_cond_broadcast( (pthread_cond_t*)handle );
+}
+
+extern "C" {
+  static void* threadEntry( void* thread ) {
+    ( (Thread*)thread )->run();
+    return NULL;
+  }
+}
+
+bool Thread::start() {
+  if ( handle ) return false;
+  pthread_t* thread = new pthread_t;
+  if ( pthread_create( thread, NULL, threadEntry, this ) != 0 ) {
+    delete thread;
+    return false;
+  }
+  handle = thread;
+  return true;
+}
+
+void Thread::join() {
+  if ( !handle ) return;
+  pthread_join( *(pthread_t*)handle, NULL );
+  delete (pthread_t*)handle;
+  handle = NULL;
+}
+
+int Thread::hardwareThreads() {
+  long count = sysconf( _SC_NPROCESSORS_ONLN );
+  return count > 0 ? int( count ) : 1;
+}
+
+double monotonicTime() {
+  timespec now;
+  clock_gettime( CLOCK_MONOTONIC, &now );
+  return double( now.tv_sec ) + double( now.tv_nsec ) * 1e-9;
+}
+
+unsigned long currentThreadId() {
+  return (unsigned long)pthread_self();
+}
+
+#endif
+
+Thread::~Thread() {
+  join();
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
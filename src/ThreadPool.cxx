@@ -0,0 +1,85 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <algorithm>
+#include "ThreadPool.h"
+#include "globals.h"
+
+static bool compareTaskCost( const Task* a, const Task* b ) {
+  return a->cost() > b->cost();
+}
+
+ThreadPool::ThreadPool( int _threads ) : threads( _threads ) {
+  if ( threads < 1 ) threads = Thread::hardwareThreads();
+  for ( int i = 0; i < threads; i++ )
+    queues.push_back( new Queue() );
+}
+
+Task* ThreadPool::take( int index ) {
+  MutexLock lock( queues[index]->mutex );
+  std::deque< Task* >& tasks = queues[index]->tasks;
+  if ( tasks.empty() ) return NULL;
+  Task* task = tasks.front();
+  tasks.pop_front();
+  return task;
+}
+
+void ThreadPool::work( int index ) {
+  for (;;) {
+    Task* task = take( index );
+    // No tasks are added while running, so once every queue was seen
+    // empty there's nothing left to steal.
+    for ( int i = 1; task == NULL && i < threads; i++ )
+      task = take( ( index + i ) % threads );
+    if ( task == NULL ) return;
+    task->run();
+  }
+}
+
+void ThreadPool::run( ) {
+  Logger.log( 3, "ThreadPool : running %d tasks on %d threads...", int( pending.size() ), threads );
+  std::stable_sort( pending.begin(), pending.end(), compareTaskCost );
+  for ( size_t i = 0; i < pending.size(); i++ )
+    queues[ i % threads ]->tasks.push_back( pending[i] );
+  pending.clear();
+
+  std::vector< Worker* > workers;
+  for ( int i = 1; i < threads; i++ ) {
+    Worker* worker = new Worker( this, i );
+    if ( !worker->start() ) {
+      Logger.log( "ThreadPool : Warning : couldn't start worker thread %d!", i );
+      delete worker;
+      continue;
+    }
+    workers.push_back( worker );
+  }
+
+  // The calling thread is worker 0, it will also steal the tasks of any
+  // worker that failed to start.
+  work( 0 );
+
+  for ( size_t i = 0; i < workers.size(); i++ )
+    workers[i]->join();
+  deletePointerVector( workers );
+}
+
+ThreadPool::~ThreadPool( ) {
+  deletePointerVector( queues );
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
@@ -0,0 +1,74 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "Tracer.h"
+
+void TracerSingleton::enable( ) {
+  MutexLock lock( mutex );
+  if ( enabled ) return;
+  origin = monotonicTime();
+  track();
+  enabled = true;
+}
+
+int TracerSingleton::track( ) {
+  unsigned long id = currentThreadId();
+  for ( size_t i = 0; i < threads.size(); i++ )
+    if ( threads[i] == id ) return int( i );
+  threads.push_back( id );
+  return int( threads.size() ) - 1;
+}
+
+void TracerSingleton::add( const TraceEventVector& derivation ) {
+  if ( !enabled || derivation.empty() ) return;
+  MutexLock lock( mutex );
+  int current = track();
+  size_t first = events.size();
+  events.insert( events.end(), derivation.begin(), derivation.end() );
+  for ( size_t i = first; i < events.size(); i++ ) events[i].track = current;
+}
+
+bool TracerSingleton::write( const String& filename ) {
+  MutexLock lock( mutex );
+  FILE* file = fopen( filename.c_str(), "w" );
+  if ( file == NULL ) return false;
+  fprintf( file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+  fprintf( file, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"bzwgen\"}}" );
+  for ( size_t i = 0; i < threads.size(); i++ ) {
+    if ( i == 0 )
+      fprintf( file, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}}" );
+    else
+      fprintf( file, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"worker %d\"}}", int( i ), int( i ) );
+  }
+  // times are in microseconds, names are literals and grammar
+  // identifiers, they need no escaping
+  for ( size_t i = 0; i < events.size(); i++ ) {
+    const TraceEvent& e = events[i];
+    fprintf( file, ",\n{\"ph\":\"X\",\"name\":\"%s\",\"cat\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+	     e.name, e.category, e.track, ( e.start - origin ) * 1e6, e.duration * 1e6 );
+    const char* separator = "";
+    if ( e.zone >= 0 )  { fprintf( file, "\"zone\":%d", e.zone ); separator = ","; }
+    if ( e.depth >= 0 ) { fprintf( file, "%s\"depth\":%d", separator, e.depth ); separator = ","; }
+    if ( e.faces >= 0 ) fprintf( file, "%s\"faces\":%d", separator, e.faces );
+    fprintf( file, "}}" );
+  }
+  fprintf( file, "\n]}\n" );
+  return fclose( file ) == 0;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8
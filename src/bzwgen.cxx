@@ -12,8 +12,8 @@
  * bzwgen.cxx -- main program file and main plugin file for BZWGen.
  */
 
-#include <fstream>
 #include "globals.h"
+#include "AsyncWriter.h"
 
 #ifdef COMPILE_PLUGIN
 
@@ -42,7 +42,8 @@ BZF_PLUGIN_CALL int bz_Load ( const char* commandLine )
   bz_registerEvent(bz_eGetWorldEvent, &BZWGen);
   bz_registerEvent(bz_eWorldFinalized, &BZWGen);
   
-  BZWGen.setup();
+  // the world is generated in the background until bzfs asks for it
+  if (BZWGen.setup() == 0) BZWGen.start();
 
   return 0;
 }
@@ -57,8 +58,19 @@ BZF_PLUGIN_CALL int bz_Unload ( void )
 int main (int argc, char* argv[]) {
   if (BZWGen.parseCommandLine(argc,argv)) return 0;
   if (BZWGen.setup()) return 1;
-  OutFileStream outstream(BZWGen.outname.c_str());
-  BZWGen.generate(&outstream);
+  if (BZWGen.compileRules) return 0;
+  // the map is written by the writer's thread while generating
+  AsyncWriter writer;
+  if (!writer.open(BZWGen.outname, BZWGen.syncOutput)) {
+    Logger.log("BZWGenerator : Error : couldn't create %s!", BZWGen.outname.c_str());
+    return 1;
+  }
+  BZWGen.generate(writer);
+  if (!writer.close()) {
+    Logger.log("BZWGenerator : Error : couldn't write %s!", BZWGen.outname.c_str());
+    return 1;
+  }
+  return 0;
 }
 #endif
 
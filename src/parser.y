@@ -7,12 +7,11 @@
 #include "Product.h"
 #include "Operation.h"
 #include "Expression.h"
-
-void yyerror(RuleSet *ruleset, char* s);
-int yylex();
-void yyunput(int, char*);
+#include "RuleParser.h"
 %}
-%parse-param {RuleSet *ruleset}
+%define api.pure
+%parse-param {RuleParser *parser}
+%lex-param {RuleParser *parser}
 %union _YYSTYPE {
   char *id;
   double fl;
@@ -24,6 +23,16 @@ void yyunput(int, char*);
   Operation* o;
   Expression* e;
 }
+%{
+static int yylex(YYSTYPE* value, RuleParser* parser) {
+  return parser->lex(value);
+}
+static void yyerror(RuleParser* parser, const char* s) {
+  parser->error(s);
+}
+// grammar objects are allocated from the parser's arena
+#define ARENA parser->getArena()
+%}
 %start ruleset
 %token TRANSLATER TRANSLATE SCALE TEST ROUND NEG ASSERTION FACE TAPER SPAWN CHAMFER 
 %token TEXTURE TEXTUREFULL TEXTUREQUAD TEXTURECLEAR MATERIAL LOADMATERIAL LOADMATERIALNR
@@ -48,7 +57,7 @@ void yyunput(int, char*);
 ruleset : /* empty */
   | ruleset NONTERM products ';' { 
     String name = String($2);
-    ruleset->addRule(name,new Rule(name,$3));
+    parser->addRule(name,Rule::create(ARENA,name,$3));
   }
 ;
 cond : /* empty */ { $$ = NULL; }
@@ -57,8 +66,8 @@ cond : /* empty */ { $$ = NULL; }
 products : /* empty */ { $$ = new ProductVector(); }
   | products product { $$ = $1; $$->push_back($2); }
 ;
-product : DEFSIGN NUMBER ':' cond ops { $$ = new Product($5,$2,$4); }
-  | DEFSIGN cond ops { $$ = new Product($3,1.0,$2); }
+product : DEFSIGN NUMBER ':' cond ops { $$ = new (ARENA) Product(ARENA,$5,$2,$4); }
+  | DEFSIGN cond ops { $$ = new (ARENA) Product(ARENA,$3,1.0,$2); }
 ;
 faces : /* empty */ { $$ = new StringVector(); }
   | faces NONTERM  { String name = String($2); $$->push_back(name); }
@@ -74,56 +83,64 @@ ops : /* empty */ { $$ = new OperationVector(); }
 splitparams : /* empty */  { $$ = new ExpressionVector(); }
   | splitparams expr { $$->push_back($2); }
 ;
-op : EXTRUDE '(' expr ')' faceparam { $$ = new OperationExtrude(ruleset,$3,$5); }
-  | EXTRUDET '(' expr ')' faceparam { $$ = new OperationExtrudeT(ruleset,$3,$5); }
-  | EXPAND '(' expr ')' { $$ = new OperationExpand(ruleset,$3); }
-  | TAPER '(' expr ')' { $$ = new OperationTaper(ruleset,$3); }
-  | CHAMFER '(' expr ')' { $$ = new OperationChamfer(ruleset,$3); }
-  | ASSERTION '(' expr ')' { $$ = new OperationAssert(ruleset,$3); }
-  | UNCHAMFER '(' ')' { $$ = new OperationUnchamfer(ruleset); }
-  | DRIVETHROUGH '(' ')' { $$ = new OperationDriveThrough(ruleset); }
-  | TEXTURE '(' ')' { $$ = new OperationTexture(ruleset); }
-  | TEXTUREFULL '(' ')' { $$ = new OperationTextureFull(ruleset); }
-  | TEXTURECLEAR '(' ')' { $$ = new OperationTextureClear(ruleset); }
-  | TEXTUREQUAD '(' expr ',' expr ',' expr ',' expr ')' { $$ = new OperationTextureQuad(ruleset,$3,$5,$7,$9); }
-  | SPLITH '(' splitparams ')' faceparam { $$ = new OperationSplitFace(ruleset,true,$5,$3); }
-  | SPLITV '(' splitparams ')' faceparam { $$ = new OperationSplitFace(ruleset,false,$5,$3); }
-  | SPLITH '(' splitparams ',' expr ')' faceparam { $$ = new OperationSplitFace(ruleset,true,$7,$3,$5); }
-  | SPLITV '(' splitparams ',' expr ')' faceparam { $$ = new OperationSplitFace(ruleset,false,$7,$3,$5); }
-  | REPEATH '(' expr ')' faceparam { $$ = new OperationRepeat(ruleset,$3,true,$5); }
-  | REPEATV '(' expr ')' faceparam { $$ = new OperationRepeat(ruleset,$3,false,$5); }
-  | SCALE '(' expr ',' expr ')' { $$ = new OperationScale(ruleset,$3,$5); }
-  | TRANSLATE '(' expr ',' expr ',' expr ')' { $$ = new OperationTranslate(ruleset,$3,$5,$7); }
-  | TRANSLATER '(' expr ',' expr ',' expr ')' { $$ = new OperationTranslateR(ruleset,$3,$5,$7); }
-  | MATERIAL '(' expr ')' { $$ = new OperationMaterial(ruleset,$3); }
-  | LOADMATERIALNR '(' NONTERM ',' NONTERM ')' { $$ = new OperationLoadMaterial(ruleset,$3,$5,true); }
-  | LOADMATERIAL '(' NONTERM ',' NONTERM ')' { $$ = new OperationLoadMaterial(ruleset,$3,$5,false); }
-  | MULTIFACE '(' ')' { $$ = new OperationMultiFace(ruleset); }
-  | FREE '(' ')' { $$ = new OperationFree(ruleset); }
-  | REMOVE '(' ')' { $$ = new OperationRemove(ruleset); }
-  | NGON '(' expr ',' expr ')' { $$ = new OperationNGon(ruleset,$3,$5); }
-  | NGON '(' expr ')' { $$ = new OperationNGon(ruleset,$3); }
-  | ASSIGN '(' NONTERM '=' expr ')' { $$ = new OperationAssign(ruleset,$5,$3); }
-  | SPAWN '(' NONTERM ')' { $$ = new OperationSpawn(ruleset,$3); }
-  | ADDFACE '(' NONTERM ')' { $$ = new OperationAddFace(ruleset,$3); }
-  | DETACHFACE '(' expr ')' faceparam { $$ = new OperationDetachFace(ruleset,$3,$5); }
-  | NONTERM { $$ = new OperationNonterminal(ruleset,$1); }
+op : EXTRUDE '(' expr ')' faceparam { $$ = new (ARENA) OperationExtrude(parser->getRuleSet(),ARENA,$3,$5); }
+  | EXTRUDET '(' expr ')' faceparam { $$ = new (ARENA) OperationExtrudeT(parser->getRuleSet(),ARENA,$3,$5); }
+  | EXPAND '(' expr ')' { $$ = new (ARENA) OperationExpand(parser->getRuleSet(),$3); }
+  | TAPER '(' expr ')' { $$ = new (ARENA) OperationTaper(parser->getRuleSet(),$3); }
+  | CHAMFER '(' expr ')' { $$ = new (ARENA) OperationChamfer(parser->getRuleSet(),$3); }
+  | ASSERTION '(' expr ')' { $$ = new (ARENA) OperationAssert(parser->getRuleSet(),$3); }
+  | UNCHAMFER '(' ')' { $$ = new (ARENA) OperationUnchamfer(parser->getRuleSet()); }
+  | DRIVETHROUGH '(' ')' { $$ = new (ARENA) OperationDriveThrough(parser->getRuleSet()); }
+  | TEXTURE '(' ')' { $$ = new (ARENA) OperationTexture(parser->getRuleSet()); }
+  | TEXTUREFULL '(' ')' { $$ = new (ARENA) OperationTextureFull(parser->getRuleSet()); }
+  | TEXTURECLEAR '(' ')' { $$ = new (ARENA) OperationTextureClear(parser->getRuleSet()); }
+  | TEXTUREQUAD '(' expr ',' expr ',' expr ',' expr ')' { $$ = new (ARENA) OperationTextureQuad(parser->getRuleSet(),$3,$5,$7,$9); }
+  | SPLITH '(' splitparams ')' faceparam { $$ = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,true,$5,$3); }
+  | SPLITV '(' splitparams ')' faceparam { $$ = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,false,$5,$3); }
+  | SPLITH '(' splitparams ',' expr ')' faceparam { $$ = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,true,$7,$3,$5); }
+  | SPLITV '(' splitparams ',' expr ')' faceparam { $$ = new (ARENA) OperationSplitFace(parser->getRuleSet(),ARENA,false,$7,$3,$5); }
+  | REPEATH '(' expr ')' faceparam { $$ = new (ARENA) OperationRepeat(parser->getRuleSet(),ARENA,$3,true,$5); }
+  | REPEATV '(' expr ')' faceparam { $$ = new (ARENA) OperationRepeat(parser->getRuleSet(),ARENA,$3,false,$5); }
+  | SCALE '(' expr ',' expr ')' { $$ = new (ARENA) OperationScale(parser->getRuleSet(),$3,$5); }
+  | TRANSLATE '(' expr ',' expr ',' expr ')' { $$ = new (ARENA) OperationTranslate(parser->getRuleSet(),$3,$5,$7); }
+  | TRANSLATER '(' expr ',' expr ',' expr ')' { $$ = new (ARENA) OperationTranslateR(parser->getRuleSet(),$3,$5,$7); }
+  | MATERIAL '(' expr ')' { $$ = new (ARENA) OperationMaterial(parser->getRuleSet(),$3); }
+  | LOADMATERIALNR '(' NONTERM ',' NONTERM ')' { $$ = new (ARENA) OperationLoadMaterial(parser->getRuleSet(),ARENA,$3,$5,true); }
+  | LOADMATERIAL '(' NONTERM ',' NONTERM ')' { $$ = new (ARENA) OperationLoadMaterial(parser->getRuleSet(),ARENA,$3,$5,false); }
+  | MULTIFACE '(' ')' { $$ = new (ARENA) OperationMultiFace(parser->getRuleSet()); }
+  | FREE '(' ')' { $$ = new (ARENA) OperationFree(parser->getRuleSet()); }
+  | REMOVE '(' ')' { $$ = new (ARENA) OperationRemove(parser->getRuleSet()); }
+  | NGON '(' expr ',' expr ')' { $$ = new (ARENA) OperationNGon(parser->getRuleSet(),$3,$5); }
+  | NGON '(' expr ')' { $$ = new (ARENA) OperationNGon(parser->getRuleSet(),$3); }
+  | ASSIGN '(' NONTERM '=' expr ')' { $$ = new (ARENA) OperationAssign(parser->getRuleSet(),$5,$3); }
+  | SPAWN '(' NONTERM ')' { $$ = new (ARENA) OperationSpawn(parser->getRuleSet(),ARENA,$3); }
+  | ADDFACE '(' NONTERM ')' { $$ = new (ARENA) OperationAddFace(parser->getRuleSet(),ARENA,$3); }
+  | DETACHFACE '(' expr ')' faceparam { $$ = new (ARENA) OperationDetachFace(parser->getRuleSet(),ARENA,$3,$5); }
+  | NONTERM { $$ = new (ARENA) OperationNonterminal(parser->getRuleSet(),ARENA,$1); }
 ;
-expr : RANDOM '(' expr ',' expr ',' expr ')' { $$ = new ExpressionRandom($3,$5,$7); }
+expr : RANDOM '(' expr ',' expr ',' expr ')' { $$ = new (ARENA) ExpressionRandom($3,$5,$7); }
   | '(' expr ')'   { $$ = $2; }
-  | NEG '(' expr ')' { $$ = new ExpressionNeg($3); }
-  | ROUND '(' expr ')' { $$ = new ExpressionRound($3); }
-  | expr '-' expr { $$ = new ExpressionSub($1,$3); }
-  | expr '+' expr { $$ = new ExpressionAdd($1,$3); }
-  | expr '*' expr { $$ = new ExpressionMult($1,$3); }
-  | expr '/' expr { $$ = new ExpressionDiv($1,$3); }
-  | expr '>' expr { $$ = new ExpressionGreater($1,$3); }
-  | expr '<' expr { $$ = new ExpressionGreater($3,$1); }
-  | expr '&' expr { $$ = new ExpressionAnd($1,$3); }
-  | expr '=' expr { $$ = new ExpressionEqual($1,$3); }
-  | expr '|' expr { $$ = new ExpressionOr($1,$3); }
-  | FACE '(' NONTERM ')' { $$ = new ExpressionFaceAttribute($3); }
-  | NUMBER { $$ = new ExpressionConst($1); }
-  | ATTRIBUTE { $$ = new ExpressionAttribute(ruleset,$1); }
+  | NEG '(' expr ')' { $$ = new (ARENA) ExpressionNeg($3); }
+  | ROUND '(' expr ')' { $$ = new (ARENA) ExpressionRound($3); }
+  | expr '-' expr { $$ = new (ARENA) ExpressionSub($1,$3); }
+  | expr '+' expr { $$ = new (ARENA) ExpressionAdd($1,$3); }
+  | expr '*' expr { $$ = new (ARENA) ExpressionMult($1,$3); }
+  | expr '/' expr { $$ = new (ARENA) ExpressionDiv($1,$3); }
+  | expr '>' expr { $$ = new (ARENA) ExpressionGreater($1,$3); }
+  | expr '<' expr { $$ = new (ARENA) ExpressionGreater($3,$1); }
+  | expr '&' expr { $$ = new (ARENA) ExpressionAnd($1,$3); }
+  | expr '=' expr { $$ = new (ARENA) ExpressionEqual($1,$3); }
+  | expr '|' expr { $$ = new (ARENA) ExpressionOr($1,$3); }
+  | FACE '(' NONTERM ')' {
+      int attr = ExpressionFaceAttribute::attributeId($3);
+      if (attr < 0) {
+        String error = String("unknown face() attribute '") + $3 + "'";
+        yyerror(parser, error.c_str());
+        YYERROR;
+      }
+      $$ = new (ARENA) ExpressionFaceAttribute(ExpressionFaceAttribute::Attribute(attr));
+    }
+  | NUMBER { $$ = new (ARENA) ExpressionConst($1); }
+  | ATTRIBUTE { $$ = new (ARENA) ExpressionAttribute(parser->getRuleSet(),$1); }
   ;
 %%
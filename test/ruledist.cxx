@@ -0,0 +1,144 @@
+/* bzflag
+ * Copyright (c) 1993 - 2008 Tim Riker
+ *
+ * This package is free software;  you can redistribute it and/or
+ * modify it under the terms of the license found in the file
+ * named COPYING that should have accompanied this file.
+ *
+ * THIS PACKAGE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * ruledist.cxx -- checks the product selection of Rule::getProduct.
+ *
+ * Draws products of a rule with unconditional, conditional and excess
+ * rarities, and checks that every pick is the one the plain walk --
+ * subtracting the rarities of the met products one by one -- makes for
+ * the same roll, and that the frequencies match the rarities (chi-square
+ * at p = 0.001). Run by "make check", exits with 1 on failure.
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include "RuleSet.h"
+#include "RuleParser.h"
+#include "Rule.h"
+#include "Mesh.h"
+#include "ExecutionContext.h"
+
+/** Rarities of the products of the rule below. */
+static const double rarity[] = { 0.1, 0.2, 0.15, 0.15, 0.1, 0.1, 0.1, 0.05, 0.05, 0.1, 0.05, 0.05, 0.05, 0.05 };
+/** Whether the condition of the product holds for the test face. */
+static const bool met[] =      { true, true, true, true, false, true, true, true, true, true, true, true, true, true };
+enum { PRODUCTS = sizeof( rarity ) / sizeof( rarity[0] ) };
+/** Number of picks drawn. */
+enum { DRAWS = 2000000 };
+
+static const char* grammar =
+  "initialize\n"
+  "  ->\n"
+  ";\n"
+  "pick\n"
+  "  -> 0.1 :\n"
+  "  -> 0.2 : (face(h) > 5)\n"
+  "  -> 0.15 :\n"
+  "  -> 0.15 :\n"
+  "  -> 0.1 : ($A > 0)\n"
+  "  -> 0.1 :\n"
+  "  -> 0.1 :\n"
+  "  -> 0.05 :\n"
+  "  -> 0.05 :\n"
+  "  -> 0.1 :\n"
+  "  -> 0.05 :\n"
+  "  -> 0.05 :\n"
+  "  -> 0.05 :\n"
+  "  -> 0.05 :\n"
+  ";\n";
+
+/** Returns the index the plain walk picks for the roll, or -1. */
+static int walk( double roll ) {
+  for ( int i = 0; i < PRODUCTS; i++ ) {
+    if ( !met[i] ) continue;
+    if ( rarity[i] >= roll ) return i;
+    roll -= rarity[i];
+  }
+  return -1;
+}
+
+int main( ) {
+  RuleSet ruleset;
+  ruleset.internAttr( "A", true );
+  RuleParser parser( "ruledist", &ruleset );
+  if ( !parser.parse( String( grammar ) ) ) {
+    printf( "ruledist : the test grammar doesn't parse\n" );
+    return 1;
+  }
+  parser.commit();
+  ruleset.link();
+  ruleset.initialize();
+  ruleset.addAttr( "A", -1.0 );
+  const Rule* rule = ruleset.findRule( "pick", "ruledist" );
+
+  // a 10 x 10 wall, face(h) is 10
+  Arena arena;
+  Mesh* mesh = new ( arena ) Mesh( arena );
+  int face = mesh->addFace();
+  mesh->getFace( face ).addVertex( mesh->addVertex( Vertex( 0, 0, 0 ) ) );
+  mesh->getFace( face ).addVertex( mesh->addVertex( Vertex( 10, 0, 0 ) ) );
+  mesh->getFace( face ).addVertex( mesh->addVertex( Vertex( 10, 0, 10 ) ) );
+  mesh->getFace( face ).addVertex( mesh->addVertex( Vertex( 0, 0, 10 ) ) );
+
+  // the reference context draws the same rolls as the one of the rule
+  ExecutionContext context( ruleset.getAttributes(), 42, 1 );
+  ExecutionContext reference( ruleset.getAttributes(), 42, 1 );
+  long count[PRODUCTS + 1] = { 0 };
+  long mismatches = 0;
+  for ( int n = 0; n < DRAWS; n++ ) {
+    Product* product = rule->getProduct( context, mesh, face );
+    int index = product == NULL ? -1 : rule->productIndex( product );
+    if ( index != walk( reference.getRandom().double01() ) ) mismatches++;
+    count[ index < 0 ? PRODUCTS : index ]++;
+  }
+
+  // rolls past the sum of the met rarities pick nothing
+  double expected[PRODUCTS + 1];
+  double sum = 0.0;
+  for ( int i = 0; i < PRODUCTS; i++ ) {
+    double share = met[i] ? std::max( 0.0, std::min( rarity[i], 1.0 - sum ) ) : 0.0;
+    expected[i] = share;
+    sum += share;
+  }
+  expected[PRODUCTS] = 1.0 - sum;
+
+  double chi = 0.0;
+  int categories = 0;
+  for ( int i = 0; i <= PRODUCTS; i++ ) {
+    double frequency = double( count[i] ) / DRAWS;
+    printf( "%-8s %2d  rarity %.4f  picked %.4f\n", i < PRODUCTS ? "product" : "none", i, expected[i], frequency );
+    if ( expected[i] <= 0.0 ) {
+      if ( count[i] > 0 ) mismatches++;
+      continue;
+    }
+    double e = expected[i] * DRAWS;
+    chi += ( count[i] - e ) * ( count[i] - e ) / e;
+    categories++;
+  }
+  // Wilson-Hilferty approximation of the chi-square quantile at 0.999
+  double dof = categories - 1;
+  double limit = dof * pow( 1.0 - 2.0 / ( 9.0 * dof ) + 3.09 * sqrt( 2.0 / ( 9.0 * dof ) ), 3.0 );
+  printf( "chi-square %.2f, limit %.2f at %d degrees of freedom\n", chi, limit, int( dof ) );
+  printf( "%ld picks differ from the plain walk\n", mismatches );
+
+  bool passed = mismatches == 0 && chi < limit;
+  printf( "ruledist : %s\n", passed ? "passed" : "FAILED" );
+  return passed ? 0 : 1;
+}
+
+// Local Variables: ***
+// mode:C++ ***
+// tab-width: 8 ***
+// c-basic-offset: 2 ***
+// indent-tabs-mode: t ***
+// End: ***
+// ex: shiftwidth=2 tabstop=8